@@ -0,0 +1,168 @@
+#include "CustomFieldTable.h"
+#include "Logging.h"
+#include "StringPool.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QReadLocker>
+#include <QWriteLocker>
+
+#include <algorithm>
+
+using namespace qtredmine;
+
+void
+CustomFieldTable::insert( const CustomField& field )
+{
+    ENTER()(field.id);
+
+    QWriteLocker locker( &lock_ );
+    fields_.insert( field.id, field );
+
+    RETURN();
+}
+
+void
+CustomFieldTable::insertIfMissing( int id, const QString& name, const QString& type, bool multiple )
+{
+    {
+        QReadLocker locker( &lock_ );
+
+        if( fields_.contains(id) )
+            return;
+    }
+
+    QWriteLocker locker( &lock_ );
+
+    if( fields_.contains(id) )
+        return;
+
+    CustomField field;
+    field.id       = id;
+    field.name     = StringPool::itemNames().intern( name );
+    field.type     = type;
+    field.multiple = multiple;
+
+    fields_.insert( id, field );
+}
+
+bool
+CustomFieldTable::contains( int id ) const
+{
+    QReadLocker locker( &lock_ );
+    return fields_.contains( id );
+}
+
+CustomField
+CustomFieldTable::value( int id ) const
+{
+    QReadLocker locker( &lock_ );
+    return fields_.value( id );
+}
+
+QString
+CustomFieldTable::name( int id ) const
+{
+    QReadLocker locker( &lock_ );
+
+    auto it = fields_.constFind( id );
+    return it != fields_.constEnd() ? it->name : QString();
+}
+
+CustomFields
+CustomFieldTable::values() const
+{
+    ENTER();
+
+    CustomFields fields;
+
+    {
+        QReadLocker locker( &lock_ );
+
+        fields.reserve( fields_.size() );
+
+        for( const auto& field : fields_ )
+            fields.push_back( field );
+    }
+
+    std::sort( fields.begin(), fields.end(), []( const CustomField& a, const CustomField& b ){ return a.id < b.id; } );
+
+    RETURN( fields, fields.size() );
+}
+
+CustomFieldTable&
+CustomFieldTable::instance()
+{
+    static CustomFieldTable table;
+    return table;
+}
+
+CustomFieldTable&
+CustomFieldTable::forServer( const QString& url )
+{
+    static QMutex mutex;
+    static QHash<QString, CustomFieldTable*> tables;
+
+    // Trailing slashes do not change the server
+    QString key = url;
+    while( key.endsWith(QLatin1Char('/')) )
+        key.chop( 1 );
+
+    QMutexLocker locker( &mutex );
+
+    CustomFieldTable*& table = tables[key];
+
+    // Never deleted, since custom field values refer to it
+    if( !table )
+        table = new CustomFieldTable;
+
+    return *table;
+}
+
+QStringList
+CustomFieldValue::values() const
+{
+    QStringList values;
+
+    if( value.isNull() && moreValues.isEmpty() )
+        return values;
+
+    values.reserve( moreValues.size() + 1 );
+    values.append( value );
+    values.append( moreValues );
+
+    return values;
+}
+
+CustomField
+CustomFieldValue::definition() const
+{
+    return ( table ? *table : CustomFieldTable::instance() ).value( id );
+}
+
+QString
+CustomFieldValue::name() const
+{
+    return ( table ? *table : CustomFieldTable::instance() ).name( id );
+}
+
+namespace qtredmine {
+
+CustomFields
+toCustomFields( const CustomFieldValues& values )
+{
+    CustomFields customFields;
+    customFields.reserve( values.size() );
+
+    for( const auto& value : values )
+    {
+        CustomField customField = value.definition();
+        customField.id     = value.id;
+        customField.values = value.values().toVector();
+        customFields.push_back( customField );
+    }
+
+    return customFields;
+}
+
+} // qtredmine
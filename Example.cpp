@@ -10,6 +10,7 @@ Example::Example( QObject *parent )
     : QObject( parent )
 {
     redmine_ = new SimpleRedmineClient( "https://redmine.site", "34z58c7346btv847brcw478c6br434f234", this );
+    redmine_->setIssueStore( &issues_ );
 
     printProjects();
 
@@ -18,24 +19,30 @@ Example::Example( QObject *parent )
 void
 Example::cacheIssues()
 {
+    // The retrieved issues are inserted into issues_ by the client
     redmine_->retrieveIssues( [&]( Issues issues, RedmineError redmineError, QStringList errors )
     {
-        if( redmineError != RedmineError::NO_ERR )
-        {
-            DEBUG()(errors);
-            return;
-        }
+        Q_UNUSED( issues );
 
-        issues_ = issues;
+        // Without Redmine, issues retrieved before are returned with RedmineError::NO_ERR_CACHED
+        if( !isSuccess(redmineError) )
+            DEBUG()(errors);
     } );
 }
 
+void
+Example::printAssignedIssues( int userId )
+{
+    for( const auto& issue : issues_.byAssignee(userId) )
+        DEBUG() << issue.subject;
+}
+
 void
 Example::printProjects()
 {
     redmine_->retrieveProjects( []( Projects projects, RedmineError redmineError, QStringList errors )
     {
-        if( redmineError != RedmineError::NO_ERR )
+        if( !isSuccess(redmineError) )
         {
             DEBUG()(errors);
             return;
@@ -1,6 +1,7 @@
 #ifndef EXAMPLE_H
 #define EXAMPLE_H
 
+#include "IssueStore.h"
 #include "SimpleRedmineClient.h"
 
 #include <QObject>
@@ -17,7 +18,7 @@ private:
     qtredmine::SimpleRedmineClient* redmine_;
 
     /// Issues cache
-    qtredmine::Issues issues_;
+    qtredmine::IssueStore issues_;
 
 public:
     /**
@@ -32,6 +33,13 @@ public:
      */
     void cacheIssues();
 
+    /**
+     * @brief Print the subjects of the issues assigned to a user using DEBUG()
+     *
+     * @param userId User ID
+     */
+    void printAssignedIssues( int userId );
+
     /**
      * @brief Print projects using DEBUG()
      */
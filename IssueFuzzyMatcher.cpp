@@ -0,0 +1,335 @@
+#include "IssueFuzzyMatcher.h"
+#include "IssueStore.h"
+#include "IssueTextIndex.h"
+#include "Logging.h"
+
+#include <algorithm>
+
+using namespace qtredmine;
+
+constexpr double IssueFuzzyMatcher::MIN_COVERAGE;
+
+namespace {
+
+/// Three characters packed into one value
+using Trigram = quint64;
+
+/// Weights of the field scores
+const double FIELD_WEIGHTS[IssueFuzzyMatcher::FIELD_COUNT] = { 1.0, 1.0, 0.9 };
+
+// Get the distinct trigrams of the words of a text
+QVector<Trigram>
+trigrams( const QString& text )
+{
+    QVector<Trigram> result;
+
+    for( const auto& word : IssueTextIndex::tokenize(text, 1) )
+    {
+        // Padding produces trigrams for word starts and words shorter than three characters
+        QString padded = QLatin1String("  ") + word + QLatin1Char(' ');
+
+        for( int i = 0; i + 3 <= padded.size(); ++i )
+        {
+            result.push_back( (static_cast<Trigram>(padded.at(i).unicode()) << 32)
+                              | (static_cast<Trigram>(padded.at(i + 1).unicode()) << 16)
+                              | padded.at(i + 2).unicode() );
+        }
+    }
+
+    std::sort( result.begin(), result.end() );
+    result.erase( std::unique(result.begin(), result.end()), result.end() );
+
+    return result;
+}
+
+// Get the text of a matched field
+QString
+fieldText( const Issue& issue, int field )
+{
+    switch( field )
+    {
+    case IssueFuzzyMatcher::SUBJECT: return issue.subject;
+    case IssueFuzzyMatcher::ID:      return QString::number( issue.id );
+    case IssueFuzzyMatcher::PROJECT: return issue.project.name;
+    }
+
+    return QString();
+}
+
+} // namespace
+
+IssueFuzzyMatcher::IssueFuzzyMatcher( IssueStore* store, QObject* parent )
+    : QObject( parent ),
+      store_( store )
+{
+    ENTER();
+
+    if( store )
+    {
+        insert( store->issues() );
+
+        connect( store, &IssueStore::issuesChanged, this, &IssueFuzzyMatcher::insertFromStore );
+        connect( store, &IssueStore::issuesRemoved, this, [=]( QVector<int> ids )
+        {
+            for( int id : ids )
+                remove( id );
+        } );
+        connect( store, &IssueStore::cleared, this, &IssueFuzzyMatcher::clear );
+    }
+
+    RETURN();
+}
+
+void
+IssueFuzzyMatcher::setText( int field, int slot, const QString& text )
+{
+    QString& stored = texts_[field][slot];
+
+    if( stored == text )
+        return;
+
+    auto& postings = postings_[field];
+
+    for( Trigram trigram : trigrams(stored) )
+    {
+        auto it = postings.find( trigram );
+        if( it == postings.end() )
+            continue;
+
+        QVector<int>& list = it.value();
+        auto pos = std::lower_bound( list.begin(), list.end(), slot );
+
+        if( pos != list.end() && *pos == slot )
+            list.erase( pos );
+
+        if( list.isEmpty() )
+            postings.erase( it );
+    }
+
+    QVector<Trigram> added = trigrams( text );
+
+    // New slots are the highest, so indexing a new issue appends to the sorted postings
+    for( Trigram trigram : added )
+    {
+        QVector<int>& list = postings[trigram];
+        list.insert( std::lower_bound(list.begin(), list.end(), slot), slot );
+    }
+
+    stored = text;
+    trigramCounts_[field][slot] = added.size();
+}
+
+void
+IssueFuzzyMatcher::insert( const Issue& issue )
+{
+    if( issue.id == NULL_ID )
+        return;
+
+    auto it = slots_.constFind( issue.id );
+    int slot;
+
+    if( it != slots_.constEnd() )
+    {
+        slot = it.value();
+    }
+    else if( !freeSlots_.isEmpty() )
+    {
+        slot = freeSlots_.takeLast();
+        ids_[slot] = issue.id;
+        slots_.insert( issue.id, slot );
+    }
+    else
+    {
+        slot = ids_.size();
+        ids_.push_back( issue.id );
+        slots_.insert( issue.id, slot );
+
+        for( int field = 0; field < FIELD_COUNT; ++field )
+        {
+            texts_[field].push_back( QString() );
+            trigramCounts_[field].push_back( 0 );
+        }
+    }
+
+    for( int field = 0; field < FIELD_COUNT; ++field )
+        setText( field, slot, fieldText(issue, field) );
+}
+
+void
+IssueFuzzyMatcher::insert( const Issues& issues )
+{
+    ENTER()(issues.size());
+
+    for( const auto& issue : issues )
+        insert( issue );
+
+    DEBUG()(size());
+
+    RETURN();
+}
+
+void
+IssueFuzzyMatcher::insertFromStore( QVector<int> ids )
+{
+    ENTER()(ids.size());
+
+    if( !store_ )
+        RETURN();
+
+    for( int id : ids )
+    {
+        if( const Issue* issue = store_->find(id) )
+            insert( *issue );
+    }
+
+    RETURN();
+}
+
+void
+IssueFuzzyMatcher::remove( int id )
+{
+    ENTER()(id);
+
+    auto it = slots_.find( id );
+    if( it == slots_.end() )
+        RETURN();
+
+    int slot = it.value();
+    slots_.erase( it );
+
+    for( int field = 0; field < FIELD_COUNT; ++field )
+        setText( field, slot, QString() );
+
+    ids_[slot] = NULL_ID;
+    freeSlots_.push_back( slot );
+
+    RETURN();
+}
+
+void
+IssueFuzzyMatcher::clear()
+{
+    ENTER();
+
+    slots_.clear();
+    ids_.clear();
+    freeSlots_.clear();
+
+    for( int field = 0; field < FIELD_COUNT; ++field )
+    {
+        texts_[field].clear();
+        trigramCounts_[field].clear();
+        postings_[field].clear();
+    }
+
+    RETURN();
+}
+
+int
+IssueFuzzyMatcher::size() const
+{
+    return slots_.size();
+}
+
+IssueFuzzyMatcher::Matches
+IssueFuzzyMatcher::search( const QString& query, int limit ) const
+{
+    ENTER()(query)(limit);
+
+    Matches matches;
+
+    QString text = query.trimmed();
+    if( text.isEmpty() || limit <= 0 )
+        RETURN( matches, 0 );
+
+    // An issue ID always ranks first
+    bool isId = false;
+    int exactId = ( text.startsWith(QLatin1Char('#')) ? text.mid(1) : text ).toInt( &isId );
+
+    if( isId && slots_.contains(exactId) )
+    {
+        Match match;
+        match.id    = exactId;
+        match.score = 1;
+        match.field = ID;
+        matches.push_back( match );
+    }
+
+    QVector<Trigram> queryTrigrams = trigrams( text );
+    const int queryCount = queryTrigrams.size();
+
+    if( !queryCount )
+        RETURN( matches, matches.size() );
+
+    // Count the shared trigrams of every field of every slot that shares any
+    QVector<int> common( ids_.size() * FIELD_COUNT, 0 );
+    QVector<int> touched;
+
+    for( int field = 0; field < FIELD_COUNT; ++field )
+    {
+        for( Trigram trigram : queryTrigrams )
+        {
+            auto it = postings_[field].constFind( trigram );
+            if( it == postings_[field].constEnd() )
+                continue;
+
+            for( int slot : it.value() )
+            {
+                int* counts = common.data() + slot * FIELD_COUNT;
+
+                // A slot is new to the search if none of its fields has shared a trigram yet
+                if( std::all_of(counts, counts + FIELD_COUNT, []( int count ) { return count == 0; }) )
+                    touched.push_back( slot );
+
+                ++counts[field];
+            }
+        }
+    }
+
+    Matches candidates;
+
+    for( int slot : touched )
+    {
+        if( isId && ids_.at(slot) == exactId )
+            continue;
+
+        Match best;
+        best.id = ids_.at( slot );
+
+        for( int field = 0; field < FIELD_COUNT; ++field )
+        {
+            int shared = common.at( slot * FIELD_COUNT + field );
+
+            if( shared < queryCount * MIN_COVERAGE )
+                continue;
+
+            // Coverage of the query, with a smaller share for the similarity of the whole field
+            double coverage   = static_cast<double>( shared ) / queryCount;
+            double similarity = static_cast<double>( shared ) / ( queryCount + trigramCounts_[field].at(slot) - shared );
+            double score      = FIELD_WEIGHTS[field] * ( 0.8 * coverage + 0.2 * similarity );
+
+            if( score > best.score )
+            {
+                best.score = score;
+                best.field = static_cast<Field>( field );
+            }
+        }
+
+        if( best.score > 0 )
+            candidates.push_back( best );
+    }
+
+    auto better = []( const Match& a, const Match& b )
+    {
+        return a.score != b.score ? a.score > b.score : a.id > b.id;
+    };
+
+    // Only the top results need to be sorted
+    int count = qMin( candidates.size(), limit - matches.size() );
+    std::partial_sort( candidates.begin(), candidates.begin() + count, candidates.end(), better );
+
+    for( int i = 0; i < count; ++i )
+        matches.push_back( candidates.at(i) );
+
+    RETURN( matches, matches.size() );
+}
@@ -0,0 +1,345 @@
+#include "IssueHierarchy.h"
+#include "IssueStore.h"
+#include "Logging.h"
+
+using namespace qtredmine;
+
+namespace {
+
+/// Estimated hours below this are rounding residue of adding and removing estimates
+const double HOURS_EPSILON = 1e-9;
+
+// Get the contribution of a single issue to a rollup
+IssueHierarchy::Rollup
+ownRollup( bool indexed, double estimatedHours, double doneRatio )
+{
+    IssueHierarchy::Rollup rollup;
+
+    if( indexed )
+    {
+        rollup.issueCount     = 1;
+        rollup.estimatedHours = estimatedHours;
+        rollup.doneHours      = estimatedHours * doneRatio / 100;
+        rollup.doneRatioSum   = doneRatio;
+    }
+
+    return rollup;
+}
+
+// Add a rollup to another one, or subtract it for a negative sign
+void
+accumulate( IssueHierarchy::Rollup& target, const IssueHierarchy::Rollup& rollup, int sign )
+{
+    target.issueCount     += sign * rollup.issueCount;
+    target.estimatedHours += sign * rollup.estimatedHours;
+    target.doneHours      += sign * rollup.doneHours;
+    target.doneRatioSum   += sign * rollup.doneRatioSum;
+}
+
+} // namespace
+
+double
+IssueHierarchy::Rollup::doneRatio() const
+{
+    // The sums are updated incrementally, so removing all estimates may not give exactly zero
+    if( estimatedHours > HOURS_EPSILON )
+        return qBound( 0.0, 100 * doneHours / estimatedHours, 100.0 );
+
+    return issueCount ? doneRatioSum / issueCount : 0;
+}
+
+IssueHierarchy::IssueHierarchy( IssueStore* store, QObject* parent )
+    : QObject( parent ),
+      store_( store )
+{
+    ENTER();
+
+    if( store )
+    {
+        insert( store->issues() );
+
+        connect( store, &IssueStore::issuesChanged, this, &IssueHierarchy::insertFromStore );
+        connect( store, &IssueStore::issuesRemoved, this, [=]( QVector<int> ids )
+        {
+            for( int id : ids )
+                remove( id );
+        } );
+        connect( store, &IssueStore::cleared, this, &IssueHierarchy::clear );
+    }
+
+    RETURN();
+}
+
+bool
+IssueHierarchy::isAncestor( int ancestor, int id ) const
+{
+    for( int current = id;; )
+    {
+        if( current == ancestor )
+            return true;
+
+        auto it = nodes_.constFind( current );
+        if( it == nodes_.constEnd() || !it->linked )
+            return false;
+
+        current = it->parentId;
+    }
+}
+
+void
+IssueHierarchy::link( int id )
+{
+    const Node& node = nodes_[id];
+    int parentId = node.parentId;
+
+    if( parentId == NULL_ID || node.linked )
+        return;
+
+    if( isAncestor(id, parentId) )
+    {
+        DEBUG( "Parent would close a cycle" )(id)(parentId);
+        unlinked_.insert( id );
+        return;
+    }
+
+    unlinked_.remove( id );
+    nodes_[id].linked = true;
+
+    Rollup rollup = nodes_[id].rollup;
+    nodes_[parentId].children.push_back( id );
+
+    for( int current = parentId;; )
+    {
+        Node& ancestor = nodes_[current];
+        accumulate( ancestor.rollup, rollup, 1 );
+
+        if( !ancestor.linked )
+            break;
+
+        current = ancestor.parentId;
+    }
+}
+
+void
+IssueHierarchy::unlink( int id )
+{
+    unlinked_.remove( id );
+
+    Node& node = nodes_[id];
+    if( !node.linked )
+        return;
+
+    node.linked = false;
+
+    int parentId  = node.parentId;
+    Rollup rollup = node.rollup;
+
+    nodes_[parentId].children.removeOne( id );
+
+    for( int current = parentId;; )
+    {
+        Node& ancestor = nodes_[current];
+        accumulate( ancestor.rollup, rollup, -1 );
+
+        if( !ancestor.linked )
+            break;
+
+        current = ancestor.parentId;
+    }
+
+    prune( parentId );
+}
+
+void
+IssueHierarchy::prune( int id )
+{
+    auto it = nodes_.find( id );
+
+    if( it != nodes_.end() && !it->indexed && !it->linked && it->children.isEmpty() )
+    {
+        nodes_.erase( it );
+        unlinked_.remove( id );
+    }
+}
+
+void
+IssueHierarchy::update( int id, int parentId, double estimatedHours, double doneRatio, bool indexed )
+{
+    Node& node = nodes_[id];
+
+    if( node.indexed == indexed && node.parentId == parentId && node.estimatedHours == estimatedHours
+        && node.doneRatio == doneRatio )
+    {
+        return;
+    }
+
+    Rollup delta = ownRollup( indexed, estimatedHours, doneRatio );
+    accumulate( delta, ownRollup(node.indexed, node.estimatedHours, node.doneRatio), -1 );
+
+    size_ += indexed - node.indexed;
+
+    if( node.parentId != parentId )
+    {
+        // Move the whole subtree: detach it with its old rollup and attach it with the new one
+        unlink( id );
+
+        Node& moved = nodes_[id];
+        moved.parentId       = parentId;
+        moved.indexed        = indexed;
+        moved.estimatedHours = estimatedHours;
+        moved.doneRatio      = doneRatio;
+        accumulate( moved.rollup, delta, 1 );
+
+        link( id );
+
+        // The move may have resolved a cycle
+        for( int pending : unlinked_.values() )
+            link( pending );
+
+        return;
+    }
+
+    node.indexed        = indexed;
+    node.estimatedHours = estimatedHours;
+    node.doneRatio      = doneRatio;
+
+    for( int current = id;; )
+    {
+        Node& ancestor = nodes_[current];
+        accumulate( ancestor.rollup, delta, 1 );
+
+        if( !ancestor.linked )
+            break;
+
+        current = ancestor.parentId;
+    }
+}
+
+void
+IssueHierarchy::insert( const Issue& issue )
+{
+    if( issue.id == NULL_ID )
+        return;
+
+    update( issue.id, issue.parentId, issue.estimatedHours, issue.doneRatio, true );
+}
+
+void
+IssueHierarchy::insert( const Issues& issues )
+{
+    ENTER()(issues.size());
+
+    for( const auto& issue : issues )
+        insert( issue );
+
+    DEBUG()(size())(nodes_.size());
+
+    RETURN();
+}
+
+void
+IssueHierarchy::insertFromStore( QVector<int> ids )
+{
+    ENTER()(ids.size());
+
+    if( !store_ )
+        RETURN();
+
+    for( int id : ids )
+    {
+        if( const Issue* issue = store_->find(id) )
+            insert( *issue );
+    }
+
+    RETURN();
+}
+
+void
+IssueHierarchy::remove( int id )
+{
+    ENTER()(id);
+
+    if( !contains(id) )
+        RETURN();
+
+    // The issue stays a placeholder while it has children
+    update( id, NULL_ID, 0, 0, false );
+    prune( id );
+
+    RETURN();
+}
+
+void
+IssueHierarchy::clear()
+{
+    ENTER();
+
+    nodes_.clear();
+    unlinked_.clear();
+    size_ = 0;
+
+    RETURN();
+}
+
+int
+IssueHierarchy::size() const
+{
+    return size_;
+}
+
+bool
+IssueHierarchy::contains( int id ) const
+{
+    auto it = nodes_.constFind( id );
+    return it != nodes_.constEnd() && it->indexed;
+}
+
+int
+IssueHierarchy::parent( int id ) const
+{
+    auto it = nodes_.constFind( id );
+    return it != nodes_.constEnd() ? it->parentId : NULL_ID;
+}
+
+QVector<int>
+IssueHierarchy::children( int id ) const
+{
+    auto it = nodes_.constFind( id );
+    return it != nodes_.constEnd() ? it->children : QVector<int>();
+}
+
+QVector<int>
+IssueHierarchy::descendants( int id ) const
+{
+    ENTER()(id);
+
+    QVector<int> ids;
+    QVector<int> pending = children( id );
+
+    while( !pending.isEmpty() )
+    {
+        int current = pending.takeLast();
+        ids.push_back( current );
+        pending += nodes_.constFind( current )->children;
+    }
+
+    RETURN( ids, ids.size() );
+}
+
+QVector<int>
+IssueHierarchy::ancestors( int id ) const
+{
+    QVector<int> ids;
+
+    for( auto it = nodes_.constFind(id); it != nodes_.constEnd() && it->linked; it = nodes_.constFind(it->parentId) )
+        ids.push_back( it->parentId );
+
+    return ids;
+}
+
+IssueHierarchy::Rollup
+IssueHierarchy::rollup( int id ) const
+{
+    auto it = nodes_.constFind( id );
+    return it != nodes_.constEnd() ? it->rollup : Rollup();
+}
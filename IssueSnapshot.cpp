@@ -0,0 +1,782 @@
+#include "IssueSnapshot.h"
+#include "Logging.h"
+#include "StringPool.h"
+
+#include <QHash>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+using namespace qtredmine;
+
+const quint32 IssueSnapshot::VERSION;
+
+namespace {
+
+/// File signature
+const char MAGIC[8] = { 'Q', 'T', 'R', 'M', 'S', 'N', 'A', 'P' };
+
+/// Written in host byte order to detect snapshots from hosts with a different one
+const quint32 BYTE_ORDER_MARK = 0x01020304;
+
+/// Value of time and date fields for invalid times and dates
+const qint64 NULL_TIME = std::numeric_limits<qint64>::min();
+
+/// Sections of a snapshot file
+enum Section
+{
+    SECTION_ISSUES,
+    SECTION_CUSTOM_FIELDS,
+    SECTION_MORE_VALUES,
+    SECTION_ISSUE_STATUSES,
+    SECTION_TRACKERS,
+    SECTION_ISSUE_PRIORITIES,
+    SECTION_TIME_ENTRY_ACTIVITIES,
+    SECTION_CUSTOM_FIELD_DEFINITIONS,
+    SECTION_DEFINITION_ITEMS,
+    SECTION_STRINGS,
+    SECTION_COUNT,
+};
+
+/// Items of an issue, in the order of the item slots of a record
+Item Issue::* const ISSUE_ITEMS[] = {
+    &Issue::assignedTo,
+    &Issue::author,
+    &Issue::category,
+    &Issue::priority,
+    &Issue::project,
+    &Issue::status,
+    &Issue::tracker,
+    &Issue::version,
+    &Issue::user,
+};
+
+/// Number of item slots of a record
+const int ITEM_COUNT = sizeof( ISSUE_ITEMS ) / sizeof( ISSUE_ITEMS[0] );
+
+/// Flags of metadata records
+enum MetadataFlag
+{
+    FLAG_DEFAULT = 0x01,
+    FLAG_CLOSED  = 0x02,
+};
+
+/// Flags of custom field definition records
+enum DefinitionFlag
+{
+    FLAG_ALL_PROJECTS = 0x01,
+    FLAG_REQUIRED     = 0x02,
+    FLAG_FILTER       = 0x04,
+    FLAG_SEARCHABLE   = 0x08,
+    FLAG_MULTIPLE     = 0x10,
+    FLAG_VISIBLE      = 0x20,
+};
+
+/// Largest string heap; references address 4 GiB, but a QByteArray holds less than 2 GiB
+const qint64 MAX_HEAP_SIZE = std::numeric_limits<int>::max() - 64;
+
+/// Position of a section in the file
+struct SectionEntry
+{
+    quint32 offset; ///< Offset from the start of the file
+    quint32 count;  ///< Number of elements; number of bytes for the string heap
+};
+
+} // namespace
+
+struct IssueSnapshot::Header
+{
+    char         magic[8];               ///< File signature
+    quint32      version;                ///< Format version
+    quint32      byteOrder;              ///< Byte order marker
+    quint32      recordSize;             ///< Size of an issue record
+    quint32      reserved;               ///< Padding
+    qint64       syncCursor;             ///< Synchronisation cursor in milliseconds since epoch
+    SectionEntry sections[SECTION_COUNT]; ///< Sections
+};
+
+struct IssueSnapshot::Record
+{
+    qint64  createdOn;             ///< Creation time in milliseconds since epoch
+    qint64  updatedOn;             ///< Update time in milliseconds since epoch
+    qint64  startDate;             ///< Start date as Julian day
+    qint64  dueDate;               ///< Due date as Julian day
+    double  doneRatio;             ///< Done ratio
+    double  estimatedHours;        ///< Estimated hours
+    qint32  id;                    ///< ID
+    qint32  parentId;              ///< Parent issue ID
+    qint32  itemIds[ITEM_COUNT];   ///< Item IDs
+    quint32 itemNames[ITEM_COUNT]; ///< Item name references
+    quint32 subject;               ///< Subject reference
+    quint32 description;           ///< Description reference
+    quint32 customFields;          ///< Index of the first custom field value
+    quint32 customFieldCount;      ///< Number of custom field values
+};
+
+struct IssueSnapshot::CustomFieldRecord
+{
+    qint32  id;             ///< Custom field ID
+    quint32 value;          ///< First value reference
+    quint32 moreValues;     ///< Index of the first further value reference
+    quint32 moreValueCount; ///< Number of further values
+};
+
+struct IssueSnapshot::MetadataRecord
+{
+    qint32  id;    ///< ID
+    quint32 name;  ///< Name reference
+    quint32 flags; ///< Metadata flags
+};
+
+struct IssueSnapshot::DefinitionRecord
+{
+    qint32  id;                 ///< Custom field ID
+    quint32 name;               ///< Name reference
+    quint32 type;               ///< Customised type reference
+    quint32 format;             ///< Field format reference
+    quint32 regex;              ///< Regular expression reference
+    quint32 defaultValue;       ///< Default value reference
+    qint32  minLength;          ///< Minimum length
+    qint32  maxLength;          ///< Maximum length
+    quint32 flags;              ///< Definition flags
+    quint32 possibleValues;     ///< Index of the first possible value reference
+    quint32 possibleValueCount; ///< Number of possible values
+    quint32 projects;           ///< Index of the first project item
+    quint32 projectCount;       ///< Number of projects
+    quint32 trackers;           ///< Index of the first tracker item
+    quint32 trackerCount;       ///< Number of trackers
+};
+
+namespace {
+
+/**
+ * Heap of interned strings
+ *
+ * Each string is stored as its length in UTF-16 code units, followed by the code units, padded to
+ * four bytes. Offset 0 holds the empty string. Strings that would grow the heap beyond
+ * MAX_HEAP_SIZE are not added and mark the heap as overflowed.
+ */
+class StringHeap
+{
+private:
+    QByteArray data_ = QByteArray( sizeof(quint32), '\0' );
+    QHash<QString, quint32> refs_;
+    bool overflowed_ = false;
+
+public:
+    quint32 add( const QString& string )
+    {
+        if( string.isEmpty() )
+            return 0;
+
+        auto it = refs_.constFind( string );
+        if( it != refs_.constEnd() )
+            return it.value();
+
+        qint64 size = data_.size() + static_cast<qint64>( sizeof(quint32) ) + ( string.size() + 1 ) * static_cast<qint64>( sizeof(QChar) );
+
+        if( size > MAX_HEAP_SIZE )
+        {
+            overflowed_ = true;
+            return 0;
+        }
+
+        quint32 ref = data_.size();
+        quint32 length = string.size();
+
+        data_.append( reinterpret_cast<const char*>(&length), sizeof(length) );
+        data_.append( reinterpret_cast<const char*>(string.constData()), length * sizeof(QChar) );
+
+        while( data_.size() % sizeof(quint32) )
+            data_.append( '\0' );
+
+        refs_.insert( string, ref );
+        return ref;
+    }
+
+    const QByteArray& data() const { return data_; }
+    bool overflowed() const { return overflowed_; }
+};
+
+// Append a fixed-size record to a section
+template<typename T>
+void
+appendRecord( QByteArray& section, const T& record )
+{
+    section.append( reinterpret_cast<const char*>(&record), sizeof(T) );
+}
+
+// Metadata flags of an item
+quint32 metadataFlags( const IssueStatus& item ) { return (item.isDefault ? FLAG_DEFAULT : 0) | (item.isClosed ? FLAG_CLOSED : 0); }
+quint32 metadataFlags( const Enumeration& item ) { return item.isDefault ? FLAG_DEFAULT : 0; }
+quint32 metadataFlags( const Tracker& )          { return 0; }
+
+// Apply metadata flags to an item
+void applyMetadataFlags( IssueStatus& item, quint32 flags ) { item.isDefault = flags & FLAG_DEFAULT; item.isClosed = flags & FLAG_CLOSED; }
+void applyMetadataFlags( Enumeration& item, quint32 flags ) { item.isDefault = flags & FLAG_DEFAULT; }
+void applyMetadataFlags( Tracker&, quint32 )                {}
+
+// Append the metadata records of items to a section
+template<typename Record, typename T>
+void
+appendMetadata( QByteArray& section, quint32& count, const QVector<T>& items, StringHeap& strings )
+{
+    for( const auto& item : items )
+    {
+        Record record = { item.id, strings.add(item.name), metadataFlags(item) };
+        appendRecord( section, record );
+    }
+
+    count = items.size();
+}
+
+// Append the records of items to a section
+template<typename Record>
+void
+appendItems( QByteArray& section, quint32& count, const Items& items, StringHeap& strings )
+{
+    for( const auto& item : items )
+    {
+        Record record = { item.id, strings.add(item.name), 0 };
+        appendRecord( section, record );
+    }
+
+    count += items.size();
+}
+
+// Pad a file offset to eight bytes
+quint64
+aligned( quint64 offset )
+{
+    return ( offset + 7 ) & ~quint64( 7 );
+}
+
+} // namespace
+
+IssueSnapshot::~IssueSnapshot()
+{
+    close();
+}
+
+bool
+IssueSnapshot::write( const QString& path, const Issues& issues, const SnapshotMetadata& metadata )
+{
+    ENTER()(path)(issues.size());
+
+    // Records are sorted by ID so that lookups can use binary search
+    QVector<const Issue*> sorted;
+    sorted.reserve( issues.size() );
+
+    for( const auto& issue : issues )
+    {
+        if( issue.id != NULL_ID )
+            sorted.push_back( &issue );
+    }
+
+    std::sort( sorted.begin(), sorted.end(), []( const Issue* a, const Issue* b ){ return a->id < b->id; } );
+
+    StringHeap strings;
+    QByteArray sections[SECTION_COUNT];
+    quint32 counts[SECTION_COUNT] = {};
+
+    sections[SECTION_ISSUES].reserve( sorted.size() * sizeof(Record) );
+
+    for( const Issue* issue : sorted )
+    {
+        Record record = Record();
+        record.createdOn      = issue->createdOn.isValid() ? issue->createdOn.toMSecsSinceEpoch() : NULL_TIME;
+        record.updatedOn      = issue->updatedOn.isValid() ? issue->updatedOn.toMSecsSinceEpoch() : NULL_TIME;
+        record.startDate      = issue->startDate.isValid() ? issue->startDate.toJulianDay() : NULL_TIME;
+        record.dueDate        = issue->dueDate.isValid() ? issue->dueDate.toJulianDay() : NULL_TIME;
+        record.doneRatio      = issue->doneRatio;
+        record.estimatedHours = issue->estimatedHours;
+        record.id             = issue->id;
+        record.parentId       = issue->parentId;
+        record.subject        = strings.add( issue->subject );
+        record.description    = strings.add( issue->description );
+
+        for( int i = 0; i < ITEM_COUNT; ++i )
+        {
+            const Item& item = issue->*ISSUE_ITEMS[i];
+            record.itemIds[i]   = item.id;
+            record.itemNames[i] = strings.add( item.name );
+        }
+
+        record.customFields     = counts[SECTION_CUSTOM_FIELDS];
+        record.customFieldCount = issue->customFields.size();
+
+        for( const auto& customField : issue->customFields )
+        {
+            CustomFieldRecord cfRecord = CustomFieldRecord();
+            cfRecord.id             = customField.id;
+            cfRecord.value          = strings.add( customField.value );
+            cfRecord.moreValues     = counts[SECTION_MORE_VALUES];
+            cfRecord.moreValueCount = customField.moreValues.size();
+
+            for( const auto& value : customField.moreValues )
+                appendRecord( sections[SECTION_MORE_VALUES], strings.add(value) );
+
+            counts[SECTION_MORE_VALUES] += cfRecord.moreValueCount;
+
+            appendRecord( sections[SECTION_CUSTOM_FIELDS], cfRecord );
+            ++counts[SECTION_CUSTOM_FIELDS];
+        }
+
+        appendRecord( sections[SECTION_ISSUES], record );
+    }
+
+    counts[SECTION_ISSUES] = sorted.size();
+
+    appendMetadata<MetadataRecord>( sections[SECTION_ISSUE_STATUSES], counts[SECTION_ISSUE_STATUSES],
+                                    metadata.issueStatuses, strings );
+    appendMetadata<MetadataRecord>( sections[SECTION_TRACKERS], counts[SECTION_TRACKERS],
+                                    metadata.trackers, strings );
+    appendMetadata<MetadataRecord>( sections[SECTION_ISSUE_PRIORITIES], counts[SECTION_ISSUE_PRIORITIES],
+                                    metadata.issuePriorities, strings );
+    appendMetadata<MetadataRecord>( sections[SECTION_TIME_ENTRY_ACTIVITIES], counts[SECTION_TIME_ENTRY_ACTIVITIES],
+                                    metadata.timeEntryActivities, strings );
+
+    for( const auto& field : metadata.customFields )
+    {
+        DefinitionRecord record = DefinitionRecord();
+        record.id           = field.id;
+        record.name         = strings.add( field.name );
+        record.type         = strings.add( field.type );
+        record.format       = strings.add( field.format );
+        record.regex        = strings.add( field.regex );
+        record.defaultValue = strings.add( field.defaultValue );
+        record.minLength    = field.minLength;
+        record.maxLength    = field.maxLength;
+        record.flags        = ( field.allProjects ? FLAG_ALL_PROJECTS : 0 ) | ( field.isRequired ? FLAG_REQUIRED : 0 )
+                              | ( field.isFilter ? FLAG_FILTER : 0 ) | ( field.searchable ? FLAG_SEARCHABLE : 0 )
+                              | ( field.multiple ? FLAG_MULTIPLE : 0 ) | ( field.visible ? FLAG_VISIBLE : 0 );
+
+        // Possible values share the section of further custom field values
+        record.possibleValues     = counts[SECTION_MORE_VALUES];
+        record.possibleValueCount = field.possibleValues.size();
+
+        for( const auto& value : field.possibleValues )
+            appendRecord( sections[SECTION_MORE_VALUES], strings.add(value) );
+
+        counts[SECTION_MORE_VALUES] += record.possibleValueCount;
+
+        record.projects     = counts[SECTION_DEFINITION_ITEMS];
+        record.projectCount = field.projects.size();
+        appendItems<MetadataRecord>( sections[SECTION_DEFINITION_ITEMS], counts[SECTION_DEFINITION_ITEMS], field.projects, strings );
+
+        record.trackers     = counts[SECTION_DEFINITION_ITEMS];
+        record.trackerCount = field.trackers.size();
+        appendItems<MetadataRecord>( sections[SECTION_DEFINITION_ITEMS], counts[SECTION_DEFINITION_ITEMS], field.trackers, strings );
+
+        appendRecord( sections[SECTION_CUSTOM_FIELD_DEFINITIONS], record );
+    }
+
+    counts[SECTION_CUSTOM_FIELD_DEFINITIONS] = metadata.customFields.size();
+
+    // References are 32-bit offsets, so the strings must fit into the heap
+    if( strings.overflowed() )
+    {
+        DEBUG() << "Snapshot string heap too large";
+        RETURN( false );
+    }
+
+    // The string heap is complete once all records have been written
+    sections[SECTION_STRINGS] = strings.data();
+    counts[SECTION_STRINGS]   = strings.data().size();
+
+    Header header = Header();
+    std::memcpy( header.magic, MAGIC, sizeof(MAGIC) );
+    header.version    = VERSION;
+    header.byteOrder  = BYTE_ORDER_MARK;
+    header.recordSize = sizeof( Record );
+    header.syncCursor = metadata.syncCursor.isValid() ? metadata.syncCursor.toMSecsSinceEpoch() : NULL_TIME;
+
+    // Every section starts at an eight byte boundary so that the mapped records are aligned
+    quint64 offset = aligned( sizeof(Header) );
+    for( int i = 0; i < SECTION_COUNT; ++i )
+    {
+        // Section offsets are 32-bit as well
+        if( offset > std::numeric_limits<quint32>::max() )
+        {
+            DEBUG() << "Snapshot too large" << offset;
+            RETURN( false );
+        }
+
+        header.sections[i].offset = static_cast<quint32>( offset );
+        header.sections[i].count  = counts[i];
+        offset = aligned( offset + sections[i].size() );
+    }
+
+    QSaveFile file( path );
+
+    if( !file.open(QIODevice::WriteOnly) )
+    {
+        DEBUG() << "Could not open snapshot file:" << file.errorString();
+        RETURN( false );
+    }
+
+    file.write( reinterpret_cast<const char*>(&header), sizeof(header) );
+
+    for( int i = 0; i < SECTION_COUNT; ++i )
+    {
+        file.write( QByteArray(header.sections[i].offset - file.pos(), '\0') );
+        file.write( sections[i] );
+    }
+
+    if( !file.commit() )
+    {
+        DEBUG() << "Could not write snapshot file:" << file.errorString();
+        RETURN( false );
+    }
+
+    RETURN( true );
+}
+
+bool
+IssueSnapshot::open( const QString& path )
+{
+    ENTER()(path);
+
+    close();
+
+    file_.setFileName( path );
+
+    if( !file_.open(QIODevice::ReadOnly) )
+    {
+        DEBUG() << "Could not open snapshot file:" << file_.errorString();
+        RETURN( false );
+    }
+
+    size_ = file_.size();
+
+    if( size_ < static_cast<qint64>(sizeof(Header)) )
+    {
+        DEBUG() << "Snapshot file too small";
+        close();
+        RETURN( false );
+    }
+
+    data_ = file_.map( 0, size_ );
+
+    if( !data_ )
+    {
+        DEBUG() << "Could not map snapshot file:" << file_.errorString();
+        close();
+        RETURN( false );
+    }
+
+    const Header* header = reinterpret_cast<const Header*>( data_ );
+
+    if( std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 || header->version != VERSION
+        || header->byteOrder != BYTE_ORDER_MARK || header->recordSize != sizeof(Record) )
+    {
+        DEBUG() << "Unsupported snapshot format" << header->version;
+        close();
+        RETURN( false );
+    }
+
+    const quint32 elementSizes[SECTION_COUNT] = {
+        sizeof( Record ),
+        sizeof( CustomFieldRecord ),
+        sizeof( quint32 ),
+        sizeof( MetadataRecord ),
+        sizeof( MetadataRecord ),
+        sizeof( MetadataRecord ),
+        sizeof( MetadataRecord ),
+        sizeof( DefinitionRecord ),
+        sizeof( MetadataRecord ),
+        1,
+    };
+
+    // Check that all sections lie within the file; references are checked when they are decoded
+    for( int i = 0; i < SECTION_COUNT; ++i )
+    {
+        const SectionEntry& section = header->sections[i];
+
+        if( section.offset % 8 != 0
+            || static_cast<quint64>(section.offset) + static_cast<quint64>(section.count) * elementSizes[i] > static_cast<quint64>(size_) )
+        {
+            DEBUG() << "Invalid snapshot section" << i;
+            close();
+            RETURN( false );
+        }
+    }
+
+    if( header->sections[SECTION_STRINGS].count < sizeof(quint32) )
+    {
+        DEBUG() << "Invalid snapshot string heap";
+        close();
+        RETURN( false );
+    }
+
+    header_  = header;
+    records_ = reinterpret_cast<const Record*>( data_ + header->sections[SECTION_ISSUES].offset );
+
+    DEBUG()(size());
+
+    RETURN( true );
+}
+
+void
+IssueSnapshot::close()
+{
+    if( data_ )
+        file_.unmap( const_cast<uchar*>(data_) );
+
+    file_.close();
+
+    data_    = nullptr;
+    size_    = 0;
+    header_  = nullptr;
+    records_ = nullptr;
+}
+
+bool
+IssueSnapshot::isOpen() const
+{
+    return header_ != nullptr;
+}
+
+int
+IssueSnapshot::size() const
+{
+    return header_ ? header_->sections[SECTION_ISSUES].count : 0;
+}
+
+int
+IssueSnapshot::id( int row ) const
+{
+    return records_[row].id;
+}
+
+Timestamp
+IssueSnapshot::updatedOn( int row ) const
+{
+    return Timestamp::fromMSecsSinceEpoch( records_[row].updatedOn );
+}
+
+int
+IssueSnapshot::indexOf( int id ) const
+{
+    const Record* end = records_ + size();
+    const Record* it = std::lower_bound( records_, end, id, []( const Record& record, int id ){ return record.id < id; } );
+
+    return it != end && it->id == id ? static_cast<int>( it - records_ ) : -1;
+}
+
+QString
+IssueSnapshot::string( quint32 ref ) const
+{
+    const SectionEntry& heap = header_->sections[SECTION_STRINGS];
+
+    if( ref > heap.count - sizeof(quint32) )
+        return QString();
+
+    const uchar* pos = data_ + heap.offset + ref;
+
+    quint32 length;
+    std::memcpy( &length, pos, sizeof(length) );
+
+    if( length > (heap.count - ref - sizeof(quint32)) / sizeof(QChar) )
+        return QString();
+
+    return QString( reinterpret_cast<const QChar*>(pos + sizeof(quint32)), length );
+}
+
+QString
+IssueSnapshot::itemName( quint32 ref ) const
+{
+    return StringPool::itemNames().intern( string(ref) );
+}
+
+Issue
+IssueSnapshot::issue( int row, const CustomFieldTable* table ) const
+{
+    const Record& record = records_[row];
+
+    Issue issue;
+    issue.id             = record.id;
+    issue.parentId       = record.parentId;
+    issue.subject        = string( record.subject );
+    issue.description    = string( record.description );
+    issue.doneRatio      = record.doneRatio;
+    issue.estimatedHours = record.estimatedHours;
+    issue.createdOn      = Timestamp::fromMSecsSinceEpoch( record.createdOn );
+    issue.updatedOn      = Timestamp::fromMSecsSinceEpoch( record.updatedOn );
+
+    if( record.startDate != NULL_TIME )
+        issue.startDate = QDate::fromJulianDay( record.startDate );
+
+    if( record.dueDate != NULL_TIME )
+        issue.dueDate = QDate::fromJulianDay( record.dueDate );
+
+    for( int i = 0; i < ITEM_COUNT; ++i )
+    {
+        if( record.itemIds[i] == NULL_ID )
+            continue;
+
+        Item& item = issue.*ISSUE_ITEMS[i];
+        item.id   = record.itemIds[i];
+        item.name = itemName( record.itemNames[i] );
+    }
+
+    const SectionEntry& customFields = header_->sections[SECTION_CUSTOM_FIELDS];
+    const SectionEntry& moreValues   = header_->sections[SECTION_MORE_VALUES];
+
+    if( static_cast<quint64>(record.customFields) + record.customFieldCount <= customFields.count )
+    {
+        const CustomFieldRecord* cfRecords = reinterpret_cast<const CustomFieldRecord*>( data_ + customFields.offset );
+        const quint32* valueRefs = reinterpret_cast<const quint32*>( data_ + moreValues.offset );
+
+        issue.customFields.reserve( record.customFieldCount );
+
+        for( quint32 i = record.customFields; i < record.customFields + record.customFieldCount; ++i )
+        {
+            const CustomFieldRecord& cfRecord = cfRecords[i];
+
+            CustomFieldValue customField;
+            customField.id    = cfRecord.id;
+            customField.value = string( cfRecord.value );
+            customField.table = table;
+
+            if( static_cast<quint64>(cfRecord.moreValues) + cfRecord.moreValueCount <= moreValues.count )
+            {
+                for( quint32 j = cfRecord.moreValues; j < cfRecord.moreValues + cfRecord.moreValueCount; ++j )
+                    customField.moreValues.append( string(valueRefs[j]) );
+            }
+
+            issue.customFields.push_back( customField );
+        }
+    }
+
+    return issue;
+}
+
+Issues
+IssueSnapshot::issues( const CustomFieldTable* table ) const
+{
+    ENTER()(size());
+
+    Issues issues;
+    issues.reserve( size() );
+
+    for( int row = 0; row < size(); ++row )
+        issues.push_back( issue(row, table) );
+
+    RETURN( issues, issues.size() );
+}
+
+template<typename T>
+QVector<T>
+IssueSnapshot::metadataRecords( int section ) const
+{
+    const SectionEntry& entry = header_->sections[section];
+    const MetadataRecord* records = reinterpret_cast<const MetadataRecord*>( data_ + entry.offset );
+
+    QVector<T> items;
+    items.reserve( entry.count );
+
+    for( quint32 i = 0; i < entry.count; ++i )
+    {
+        T item;
+        item.id   = records[i].id;
+        item.name = itemName( records[i].name );
+        applyMetadataFlags( item, records[i].flags );
+        items.push_back( item );
+    }
+
+    return items;
+}
+
+CustomFields
+IssueSnapshot::definitions() const
+{
+    const SectionEntry& entry      = header_->sections[SECTION_CUSTOM_FIELD_DEFINITIONS];
+    const SectionEntry& moreValues = header_->sections[SECTION_MORE_VALUES];
+    const SectionEntry& items      = header_->sections[SECTION_DEFINITION_ITEMS];
+
+    const DefinitionRecord* records = reinterpret_cast<const DefinitionRecord*>( data_ + entry.offset );
+    const quint32* valueRefs = reinterpret_cast<const quint32*>( data_ + moreValues.offset );
+    const MetadataRecord* itemRecords = reinterpret_cast<const MetadataRecord*>( data_ + items.offset );
+
+    auto decodeItems = [&]( quint32 first, quint32 count )
+    {
+        Items result;
+
+        if( static_cast<quint64>(first) + count > items.count )
+            return result;
+
+        result.reserve( count );
+
+        for( quint32 i = first; i < first + count; ++i )
+        {
+            Item item;
+            item.id   = itemRecords[i].id;
+            item.name = itemName( itemRecords[i].name );
+            result.push_back( item );
+        }
+
+        return result;
+    };
+
+    CustomFields fields;
+    fields.reserve( entry.count );
+
+    for( quint32 i = 0; i < entry.count; ++i )
+    {
+        const DefinitionRecord& record = records[i];
+
+        CustomField field;
+        field.id           = record.id;
+        field.name         = itemName( record.name );
+        field.type         = string( record.type );
+        field.format       = string( record.format );
+        field.regex        = string( record.regex );
+        field.defaultValue = string( record.defaultValue );
+        field.minLength    = record.minLength;
+        field.maxLength    = record.maxLength;
+        field.allProjects  = record.flags & FLAG_ALL_PROJECTS;
+        field.isRequired   = record.flags & FLAG_REQUIRED;
+        field.isFilter     = record.flags & FLAG_FILTER;
+        field.searchable   = record.flags & FLAG_SEARCHABLE;
+        field.multiple     = record.flags & FLAG_MULTIPLE;
+        field.visible      = record.flags & FLAG_VISIBLE;
+
+        if( static_cast<quint64>(record.possibleValues) + record.possibleValueCount <= moreValues.count )
+        {
+            field.possibleValues.reserve( record.possibleValueCount );
+
+            for( quint32 j = record.possibleValues; j < record.possibleValues + record.possibleValueCount; ++j )
+                field.possibleValues.push_back( string(valueRefs[j]) );
+        }
+
+        field.projects = decodeItems( record.projects, record.projectCount );
+        field.trackers = decodeItems( record.trackers, record.trackerCount );
+
+        fields.push_back( field );
+    }
+
+    return fields;
+}
+
+SnapshotMetadata
+IssueSnapshot::metadata() const
+{
+    ENTER();
+
+    SnapshotMetadata metadata;
+
+    if( header_ )
+    {
+        metadata.issueStatuses       = metadataRecords<IssueStatus>( SECTION_ISSUE_STATUSES );
+        metadata.trackers            = metadataRecords<Tracker>( SECTION_TRACKERS );
+        metadata.issuePriorities     = metadataRecords<Enumeration>( SECTION_ISSUE_PRIORITIES );
+        metadata.timeEntryActivities = metadataRecords<Enumeration>( SECTION_TIME_ENTRY_ACTIVITIES );
+        metadata.customFields        = definitions();
+        metadata.syncCursor          = Timestamp::fromMSecsSinceEpoch( header_->syncCursor );
+    }
+
+    RETURN( metadata, metadata.syncCursor );
+}
@@ -0,0 +1,245 @@
+#include "IssueStore.h"
+#include "Logging.h"
+#include "StringPool.h"
+
+using namespace qtredmine;
+
+Issues
+IssueStore::View::toIssues() const
+{
+    Issues issues;
+    issues.reserve( size() );
+
+    for( const auto& issue : *this )
+        issues.push_back( issue );
+
+    return issues;
+}
+
+IssueStore::IssueStore( QObject* parent )
+    : QObject( parent )
+{
+    ENTER();
+    RETURN();
+}
+
+int
+IssueStore::key( const Issue& issue, Index index )
+{
+    switch( index )
+    {
+    case PROJECT:  return issue.project.id;
+    case STATUS:   return issue.status.id;
+    case TRACKER:  return issue.tracker.id;
+    case ASSIGNEE: return issue.assignedTo.id;
+    case VERSION:  return issue.version.id;
+    case INDEX_COUNT: break;
+    }
+
+    return NULL_ID;
+}
+
+void
+IssueStore::addToIndex( Index index, int key, int id )
+{
+    indexes_[index][key].push_back( id );
+}
+
+void
+IssueStore::removeFromIndex( Index index, int key, int id )
+{
+    auto it = indexes_[index].find( key );
+    if( it == indexes_[index].end() )
+        return;
+
+    // The order within an index entry is not significant, so swap with the last ID
+    QVector<int>& ids = it.value();
+    int pos = ids.indexOf( id );
+    if( pos == -1 )
+        return;
+
+    ids[pos] = ids.last();
+    ids.removeLast();
+
+    if( ids.isEmpty() )
+        indexes_[index].erase( it );
+}
+
+bool
+IssueStore::insertIssue( const Issue& issue )
+{
+    if( issue.id == NULL_ID )
+        return false;
+
+    auto it = positions_.constFind( issue.id );
+
+    // New issue
+    if( it == positions_.constEnd() )
+    {
+        positions_.insert( issue.id, issues_.size() );
+        issues_.push_back( issue );
+
+        for( int i = 0; i < INDEX_COUNT; ++i )
+            addToIndex( static_cast<Index>(i), key(issue, static_cast<Index>(i)), issue.id );
+
+        return true;
+    }
+
+    Issue& stored = issues_[it.value()];
+
+    if( stored == issue )
+        return false;
+
+    // Only move the index entries whose key changed
+    for( int i = 0; i < INDEX_COUNT; ++i )
+    {
+        Index index = static_cast<Index>( i );
+        int oldKey = key( stored, index );
+        int newKey = key( issue, index );
+
+        if( oldKey != newKey )
+        {
+            removeFromIndex( index, oldKey, issue.id );
+            addToIndex( index, newKey, issue.id );
+        }
+    }
+
+    stored = issue;
+    return true;
+}
+
+bool
+IssueStore::insert( const Issue& issue )
+{
+    ENTER()(issue.id);
+
+    if( !insertIssue(issue) )
+        RETURN( false );
+
+    DEBUG( "Emitting signal issuesChanged()" )(issue.id);
+    emit issuesChanged( QVector<int>{issue.id} );
+
+    RETURN( true );
+}
+
+int
+IssueStore::insert( const Issues& issues )
+{
+    ENTER()(issues.size());
+
+    if( issues_.isEmpty() )
+    {
+        issues_.reserve( issues.size() );
+        positions_.reserve( issues.size() );
+    }
+
+    QVector<int> changed;
+
+    for( const auto& issue : issues )
+    {
+        if( insertIssue(issue) )
+            changed.push_back( issue.id );
+    }
+
+    if( !changed.isEmpty() )
+    {
+        DEBUG( "Emitting signal issuesChanged()" )(changed.size());
+        emit issuesChanged( changed );
+    }
+
+    RETURN( changed.size() );
+}
+
+bool
+IssueStore::remove( int id )
+{
+    ENTER()(id);
+
+    auto it = positions_.find( id );
+    if( it == positions_.end() )
+        RETURN( false );
+
+    int pos = it.value();
+    positions_.erase( it );
+
+    for( int i = 0; i < INDEX_COUNT; ++i )
+        removeFromIndex( static_cast<Index>(i), key(issues_[pos], static_cast<Index>(i)), id );
+
+    // Keep the vector contiguous by moving the last issue into the gap
+    int last = issues_.size() - 1;
+    if( pos != last )
+    {
+        issues_[pos] = issues_[last];
+        positions_[issues_[pos].id] = pos;
+    }
+    issues_.removeLast();
+
+    DEBUG( "Emitting signal issuesRemoved()" )(id);
+    emit issuesRemoved( QVector<int>{id} );
+
+    RETURN( true );
+}
+
+void
+IssueStore::clear()
+{
+    ENTER();
+
+    issues_.clear();
+    positions_.clear();
+
+    for( auto& index : indexes_ )
+        index.clear();
+
+    DEBUG( "Emitting signal cleared()" );
+    emit cleared();
+
+    // Release the item names no longer used, once the receivers have dropped their copies as well
+    StringPool::itemNames().trim();
+
+    RETURN();
+}
+
+const Issue*
+IssueStore::find( int id ) const
+{
+    auto it = positions_.constFind( id );
+    return it == positions_.constEnd() ? nullptr : &issues_.at( it.value() );
+}
+
+bool
+IssueStore::contains( int id ) const
+{
+    return positions_.contains( id );
+}
+
+int
+IssueStore::size() const
+{
+    return issues_.size();
+}
+
+bool
+IssueStore::isEmpty() const
+{
+    return issues_.isEmpty();
+}
+
+const Issues&
+IssueStore::issues() const
+{
+    return issues_;
+}
+
+IssueStore::View
+IssueStore::query( Index index, int key ) const
+{
+    auto it = indexes_[index].constFind( key );
+    return it == indexes_[index].constEnd() ? View() : View( this, &it.value() );
+}
+
+QList<int>
+IssueStore::keys( Index index ) const
+{
+    return indexes_[index].keys();
+}
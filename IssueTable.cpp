@@ -0,0 +1,252 @@
+#include "IssueTable.h"
+#include "Logging.h"
+#include "StringPool.h"
+
+using namespace qtredmine;
+
+const qint64 IssueTable::NULL_TIME;
+
+namespace {
+
+// Convert a timestamp into a time column value
+qint64
+fromTimestamp( const Timestamp& time )
+{
+    return time.isValid() ? time.toMSecsSinceEpoch() : IssueTable::NULL_TIME;
+}
+
+// Convert a time column value into a timestamp
+Timestamp
+toTimestamp( qint64 time )
+{
+    return time == IssueTable::NULL_TIME ? Timestamp() : Timestamp::fromMSecsSinceEpoch( time );
+}
+
+// Convert a date into a date column value
+qint64
+fromDate( const QDate& date )
+{
+    return date.isValid() ? date.toJulianDay() : IssueTable::NULL_TIME;
+}
+
+// Convert a date column value into a date
+QDate
+toDate( qint64 date )
+{
+    return date == IssueTable::NULL_TIME ? QDate() : QDate::fromJulianDay( date );
+}
+
+// Get the ID of an item and remember its name
+int
+itemId( const Item& item, QHash<int, QString>& names )
+{
+    if( item.id != NULL_ID && !names.contains(item.id) )
+        names.insert( item.id, item.name );
+
+    return item.id;
+}
+
+// Get the ID of an item from a JSON object and remember its name
+int
+itemId( const QJsonObject& obj, const char* key, QHash<int, QString>& names )
+{
+    QJsonObject itemObj = obj.value( QLatin1String(key) ).toObject();
+
+    if( itemObj.isEmpty() )
+        return NULL_ID;
+
+    int id = itemObj.value(QLatin1String("id")).toInt();
+
+    if( !names.contains(id) )
+        names.insert( id, StringPool::itemNames().intern(itemObj.value(QLatin1String("name")).toString()) );
+
+    return id;
+}
+
+// Assemble an item from an ID and the name dictionary
+Item
+toItem( int id, const QHash<int, QString>& names )
+{
+    Item item;
+
+    if( id != NULL_ID )
+    {
+        item.id   = id;
+        item.name = names.value( id );
+    }
+
+    return item;
+}
+
+} // namespace
+
+void
+StringColumn::append( const QString& string )
+{
+    arena_.append( string );
+    offsets_.append( arena_.size() );
+}
+
+QStringRef
+StringColumn::at( int row ) const
+{
+    return QStringRef( &arena_, offsets_.at(row), offsets_.at(row + 1) - offsets_.at(row) );
+}
+
+QString
+StringColumn::value( int row ) const
+{
+    return arena_.mid( offsets_.at(row), offsets_.at(row + 1) - offsets_.at(row) );
+}
+
+void
+StringColumn::reserve( int rows, int characters )
+{
+    offsets_.reserve( rows + 1 );
+
+    if( characters > 0 )
+        arena_.reserve( characters );
+}
+
+void
+StringColumn::clear()
+{
+    arena_.clear();
+    offsets_ = QVector<int>( 1, 0 );
+}
+
+int
+StringColumn::size() const
+{
+    return offsets_.size() - 1;
+}
+
+void
+IssueTable::append( const Issue& issue )
+{
+    ids.append( issue.id );
+    parentIds.append( issue.parentId );
+
+    assignedToIds.append( itemId(issue.assignedTo, userNames) );
+    authorIds.append( itemId(issue.author, userNames) );
+    categoryIds.append( itemId(issue.category, categoryNames) );
+    priorityIds.append( itemId(issue.priority, priorityNames) );
+    projectIds.append( itemId(issue.project, projectNames) );
+    statusIds.append( itemId(issue.status, statusNames) );
+    trackerIds.append( itemId(issue.tracker, trackerNames) );
+    versionIds.append( itemId(issue.version, versionNames) );
+
+    createdOn.append( fromTimestamp(issue.createdOn) );
+    updatedOn.append( fromTimestamp(issue.updatedOn) );
+    startDates.append( fromDate(issue.startDate) );
+    dueDates.append( fromDate(issue.dueDate) );
+    doneRatios.append( issue.doneRatio );
+    estimatedHours.append( issue.estimatedHours );
+
+    subjects.append( issue.subject );
+    descriptions.append( issue.description );
+}
+
+void
+IssueTable::append( const QJsonObject& obj )
+{
+    ids.append( obj.value(QLatin1String("id")).toInt() );
+
+    QJsonObject parent = obj.value(QLatin1String("parent")).toObject();
+    parentIds.append( parent.isEmpty() ? NULL_ID : parent.value(QLatin1String("id")).toInt() );
+
+    assignedToIds.append( itemId(obj, "assigned_to", userNames) );
+    authorIds.append( itemId(obj, "author", userNames) );
+    categoryIds.append( itemId(obj, "category", categoryNames) );
+    priorityIds.append( itemId(obj, "priority", priorityNames) );
+    projectIds.append( itemId(obj, "project", projectNames) );
+    statusIds.append( itemId(obj, "status", statusNames) );
+    trackerIds.append( itemId(obj, "tracker", trackerNames) );
+    versionIds.append( itemId(obj, "fixed_version", versionNames) );
+
+    createdOn.append( fromTimestamp(Timestamp::fromString(obj.value(QLatin1String("created_on")).toString())) );
+    updatedOn.append( fromTimestamp(Timestamp::fromString(obj.value(QLatin1String("updated_on")).toString())) );
+    startDates.append( fromDate(obj.value(QLatin1String("start_date")).toVariant().toDate()) );
+    dueDates.append( fromDate(obj.value(QLatin1String("due_date")).toVariant().toDate()) );
+    doneRatios.append( obj.value(QLatin1String("done_ratio")).toInt() );
+    estimatedHours.append( obj.value(QLatin1String("estimated_hours")).toDouble() );
+
+    subjects.append( obj.value(QLatin1String("subject")).toString() );
+    descriptions.append( obj.value(QLatin1String("description")).toString() );
+}
+
+Issue
+IssueTable::issue( int row ) const
+{
+    Issue issue;
+
+    issue.id       = ids.at( row );
+    issue.parentId = parentIds.at( row );
+
+    issue.assignedTo = toItem( assignedToIds.at(row), userNames );
+    issue.author     = toItem( authorIds.at(row), userNames );
+    issue.category   = toItem( categoryIds.at(row), categoryNames );
+    issue.priority   = toItem( priorityIds.at(row), priorityNames );
+    issue.project    = toItem( projectIds.at(row), projectNames );
+    issue.status     = toItem( statusIds.at(row), statusNames );
+    issue.tracker    = toItem( trackerIds.at(row), trackerNames );
+    issue.version    = toItem( versionIds.at(row), versionNames );
+
+    issue.createdOn      = toTimestamp( createdOn.at(row) );
+    issue.updatedOn      = toTimestamp( updatedOn.at(row) );
+    issue.startDate      = toDate( startDates.at(row) );
+    issue.dueDate        = toDate( dueDates.at(row) );
+    issue.doneRatio      = doneRatios.at( row );
+    issue.estimatedHours = estimatedHours.at( row );
+
+    issue.subject     = subjects.value( row );
+    issue.description = descriptions.value( row );
+
+    return issue;
+}
+
+void
+IssueTable::reserve( int rows )
+{
+    ENTER()(rows);
+
+    ids.reserve( rows );
+    parentIds.reserve( rows );
+
+    assignedToIds.reserve( rows );
+    authorIds.reserve( rows );
+    categoryIds.reserve( rows );
+    priorityIds.reserve( rows );
+    projectIds.reserve( rows );
+    statusIds.reserve( rows );
+    trackerIds.reserve( rows );
+    versionIds.reserve( rows );
+
+    createdOn.reserve( rows );
+    updatedOn.reserve( rows );
+    startDates.reserve( rows );
+    dueDates.reserve( rows );
+    doneRatios.reserve( rows );
+    estimatedHours.reserve( rows );
+
+    subjects.reserve( rows );
+    descriptions.reserve( rows );
+
+    RETURN();
+}
+
+void
+IssueTable::clear()
+{
+    ENTER();
+
+    *this = IssueTable();
+
+    RETURN();
+}
+
+int
+IssueTable::size() const
+{
+    return ids.size();
+}
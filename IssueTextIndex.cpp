@@ -0,0 +1,334 @@
+#include "IssueStore.h"
+#include "IssueTextIndex.h"
+#include "Logging.h"
+
+#include <QSet>
+
+#include <algorithm>
+#include <iterator>
+
+using namespace qtredmine;
+
+const int IssueTextIndex::MIN_TOKEN_LENGTH;
+const int IssueTextIndex::FIELD_COUNT;
+
+namespace {
+
+// Get the text of an indexed field
+const QString&
+fieldText( const Issue& issue, int field )
+{
+    return field == 0 ? issue.subject : issue.description;
+}
+
+// Get the distinct tokens of a text
+QStringList
+distinctTokens( const QString& text )
+{
+    QStringList tokens = IssueTextIndex::tokenize( text );
+    std::sort( tokens.begin(), tokens.end() );
+    tokens.erase( std::unique(tokens.begin(), tokens.end()), tokens.end() );
+    return tokens;
+}
+
+// Sort and deduplicate IDs
+void
+normalise( QVector<int>& ids )
+{
+    std::sort( ids.begin(), ids.end() );
+    ids.erase( std::unique(ids.begin(), ids.end()), ids.end() );
+}
+
+} // namespace
+
+IssueTextIndex::IssueTextIndex( IssueStore* store, QObject* parent )
+    : QObject( parent ),
+      store_( store )
+{
+    ENTER();
+
+    if( store )
+    {
+        insert( store->issues() );
+
+        connect( store, &IssueStore::issuesChanged, this, &IssueTextIndex::insertFromStore );
+        connect( store, &IssueStore::issuesRemoved, this, [=]( QVector<int> ids )
+        {
+            for( int id : ids )
+                remove( id );
+        } );
+        connect( store, &IssueStore::cleared, this, &IssueTextIndex::clear );
+    }
+
+    RETURN();
+}
+
+QStringList
+IssueTextIndex::tokenize( const QString& text, int minLength )
+{
+    QStringList tokens;
+
+    const QChar* begin = text.constData();
+    const QChar* end   = begin + text.size();
+
+    for( const QChar* it = begin; it != end; )
+    {
+        while( it != end && !it->isLetterOrNumber() )
+            ++it;
+
+        const QChar* start = it;
+
+        while( it != end && it->isLetterOrNumber() )
+            ++it;
+
+        if( it - start >= minLength )
+            tokens.push_back( QString(start, static_cast<int>(it - start)).toCaseFolded() );
+    }
+
+    return tokens;
+}
+
+void
+IssueTextIndex::removePostings( int field, int id, const QStringList& tokens )
+{
+    auto& postings = postings_[field];
+
+    for( const auto& token : tokens )
+    {
+        auto it = postings.find( token );
+        if( it == postings.end() )
+            continue;
+
+        QVector<int>& ids = it.value();
+        auto pos = std::lower_bound( ids.begin(), ids.end(), id );
+
+        if( pos != ids.end() && *pos == id )
+            ids.erase( pos );
+
+        if( ids.isEmpty() )
+            postings.erase( it );
+    }
+}
+
+void
+IssueTextIndex::insert( const Issue& issue )
+{
+    ENTER()(issue.id);
+
+    if( issue.id == NULL_ID )
+        RETURN();
+
+    for( int field = 0; field < FIELD_COUNT; ++field )
+    {
+        QStringList tokens = distinctTokens( fieldText(issue, field) );
+        auto it = tokens_[field].constFind( issue.id );
+
+        if( it != tokens_[field].constEnd() && it.value() == tokens )
+            continue;
+
+        QStringList old = it != tokens_[field].constEnd() ? it.value() : QStringList();
+
+        removePostings( field, issue.id, old );
+
+        // Keep the postings sorted, so that queries can intersect them directly
+        for( const auto& token : tokens )
+        {
+            QVector<int>& ids = postings_[field][token];
+            ids.insert( std::lower_bound(ids.begin(), ids.end(), issue.id), issue.id );
+        }
+
+        tokens_[field].insert( issue.id, tokens );
+    }
+
+    RETURN();
+}
+
+void
+IssueTextIndex::insert( const Issues& issues )
+{
+    ENTER()(issues.size());
+
+    for( int field = 0; field < FIELD_COUNT; ++field )
+    {
+        auto& postings = postings_[field];
+
+        // Tokens of the new and modified issues; the last one wins if an issue occurs twice
+        QHash<int, QStringList> changed;
+
+        for( const auto& issue : issues )
+        {
+            if( issue.id == NULL_ID )
+                continue;
+
+            QStringList tokens = distinctTokens( fieldText(issue, field) );
+
+            auto it = tokens_[field].constFind( issue.id );
+            if( it != tokens_[field].constEnd() && it.value() == tokens )
+                changed.remove( issue.id );
+            else
+                changed.insert( issue.id, tokens );
+        }
+
+        // Remove the old postings first, while all postings are still sorted
+        for( auto it = changed.constBegin(); it != changed.constEnd(); ++it )
+            removePostings( field, it.key(), tokens_[field].value(it.key()) );
+
+        // Append unsorted; every touched posting is sorted once at the end of the batch
+        QSet<QString> touched;
+
+        for( auto it = changed.constBegin(); it != changed.constEnd(); ++it )
+        {
+            for( const auto& token : it.value() )
+            {
+                postings[token].push_back( it.key() );
+                touched.insert( token );
+            }
+
+            tokens_[field].insert( it.key(), it.value() );
+        }
+
+        for( const auto& token : touched )
+            normalise( postings[token] );
+    }
+
+    DEBUG()(size())(tokenCount(SUBJECT))(tokenCount(DESCRIPTION));
+
+    RETURN();
+}
+
+void
+IssueTextIndex::insertFromStore( QVector<int> ids )
+{
+    ENTER()(ids.size());
+
+    if( !store_ )
+        RETURN();
+
+    Issues issues;
+    issues.reserve( ids.size() );
+
+    for( int id : ids )
+    {
+        if( const Issue* issue = store_->find(id) )
+            issues.push_back( *issue );
+    }
+
+    if( issues.size() == 1 )
+        insert( issues.first() );
+    else
+        insert( issues );
+
+    RETURN();
+}
+
+void
+IssueTextIndex::remove( int id )
+{
+    ENTER()(id);
+
+    for( int field = 0; field < FIELD_COUNT; ++field )
+        removePostings( field, id, tokens_[field].take(id) );
+
+    RETURN();
+}
+
+void
+IssueTextIndex::clear()
+{
+    ENTER();
+
+    for( int field = 0; field < FIELD_COUNT; ++field )
+    {
+        postings_[field].clear();
+        tokens_[field].clear();
+    }
+
+    RETURN();
+}
+
+int
+IssueTextIndex::size() const
+{
+    return tokens_[0].size();
+}
+
+int
+IssueTextIndex::tokenCount( Field field ) const
+{
+    return postings_[field == SUBJECT ? 0 : 1].size();
+}
+
+QVector<int>
+IssueTextIndex::match( const QString& prefix, int fields ) const
+{
+    QVector<const QVector<int>*> lists;
+
+    for( int field = 0; field < FIELD_COUNT; ++field )
+    {
+        if( !(fields & (1 << field)) )
+            continue;
+
+        const auto& postings = postings_[field];
+
+        // Tokens with the prefix are adjacent in the sorted dictionary
+        for( auto it = postings.lowerBound(prefix); it != postings.constEnd() && it.key().startsWith(prefix); ++it )
+            lists.push_back( &it.value() );
+    }
+
+    if( lists.size() == 1 )
+        return *lists.first();
+
+    QVector<int> ids;
+    for( const auto* list : lists )
+        ids += *list;
+
+    normalise( ids );
+    return ids;
+}
+
+QVector<int>
+IssueTextIndex::search( const QString& query, int limit, int fields ) const
+{
+    ENTER()(query)(limit)(fields);
+
+    QStringList terms = tokenize( query, 1 );
+    std::sort( terms.begin(), terms.end() );
+    terms.erase( std::unique(terms.begin(), terms.end()), terms.end() );
+
+    if( terms.isEmpty() )
+        RETURN( QVector<int>() );
+
+    QVector<QVector<int>> matches;
+    matches.reserve( terms.size() );
+
+    for( const auto& term : terms )
+    {
+        matches.push_back( match(term, fields) );
+
+        if( matches.last().isEmpty() )
+            RETURN( QVector<int>() );
+    }
+
+    // Intersect starting with the most selective term
+    std::sort( matches.begin(), matches.end(), []( const QVector<int>& a, const QVector<int>& b )
+    {
+        return a.size() < b.size();
+    } );
+
+    QVector<int> ids = matches.first();
+
+    for( int i = 1; i < matches.size() && !ids.isEmpty(); ++i )
+    {
+        QVector<int> intersection;
+        std::set_intersection( ids.constBegin(), ids.constEnd(), matches[i].constBegin(), matches[i].constEnd(),
+                               std::back_inserter(intersection) );
+        ids.swap( intersection );
+    }
+
+    std::reverse( ids.begin(), ids.end() );
+
+    if( limit > 0 && ids.size() > limit )
+        ids.resize( limit );
+
+    RETURN( ids, ids.size() );
+}
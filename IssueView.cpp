@@ -0,0 +1,361 @@
+#include "IssueView.h"
+#include "Logging.h"
+#include "StringPool.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <cstring>
+
+using namespace qtredmine;
+
+namespace {
+
+// Skip whitespace
+const char*
+skipSpace( const char* p, const char* end )
+{
+    while( p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') )
+        ++p;
+
+    return p;
+}
+
+// Skip a string starting at its opening quote, return the position after the closing quote
+const char*
+skipString( const char* p, const char* end )
+{
+    for( ++p; p < end; ++p )
+    {
+        if( *p == '\\' )
+            ++p;
+        else if( *p == '"' )
+            return p + 1;
+    }
+
+    return end;
+}
+
+// Skip an arbitrary JSON value, return the position after the value
+const char*
+skipValue( const char* p, const char* end )
+{
+    if( p >= end )
+        return end;
+
+    if( *p == '"' )
+        return skipString( p, end );
+
+    if( *p == '{' || *p == '[' )
+    {
+        int depth = 0;
+
+        while( p < end )
+        {
+            if( *p == '"' )
+            {
+                p = skipString( p, end );
+                continue;
+            }
+
+            if( *p == '{' || *p == '[' )
+                ++depth;
+            else if( (*p == '}' || *p == ']') && --depth == 0 )
+                return p + 1;
+
+            ++p;
+        }
+
+        return end;
+    }
+
+    // Numbers, true, false and null
+    while( p < end && *p != ',' && *p != '}' && *p != ']'
+           && *p != ' ' && *p != '\t' && *p != '\n' && *p != '\r' )
+        ++p;
+
+    return p;
+}
+
+// Find the value of a top-level key in the JSON object starting at p
+bool
+findKey( const char* p, const char* end, const char* key, const char** valueBegin, const char** valueEnd )
+{
+    const size_t keyLength = strlen( key );
+
+    p = skipSpace( p, end );
+    if( p >= end || *p != '{' )
+        return false;
+
+    ++p;
+
+    while( true )
+    {
+        // Key
+        p = skipSpace( p, end );
+        if( p >= end || *p != '"' )
+            return false;
+
+        const char* keyBegin = p + 1;
+        p = skipString( p, end );
+        const char* keyEnd = p - 1;
+
+        p = skipSpace( p, end );
+        if( p >= end || *p != ':' )
+            return false;
+
+        // Value
+        p = skipSpace( p + 1, end );
+        const char* next = skipValue( p, end );
+
+        if( static_cast<size_t>(keyEnd - keyBegin) == keyLength && !memcmp(keyBegin, key, keyLength) )
+        {
+            *valueBegin = p;
+            *valueEnd   = next;
+            return true;
+        }
+
+        p = skipSpace( next, end );
+        if( p >= end || *p != ',' )
+            return false;
+
+        ++p;
+    }
+}
+
+// Decode an integer value
+int
+decodeInt( const char* begin, const char* end, int defaultValue )
+{
+    bool ok;
+    int value = QByteArray::fromRawData( begin, static_cast<int>(end - begin) ).toInt( &ok );
+
+    return ok ? value : defaultValue;
+}
+
+// Decode a string value
+QString
+decodeString( const char* begin, const char* end )
+{
+    if( end - begin < 2 || *begin != '"' )
+        return QString();
+
+    const char* s = begin + 1;
+    const int length = static_cast<int>(end - begin) - 2;
+
+    // Fast path for strings without escape sequences
+    if( !memchr(s, '\\', length) )
+        return QString::fromUtf8( s, length );
+
+    QByteArray wrapped;
+    wrapped.reserve( length + 4 );
+    wrapped.append( '[' ).append( begin, static_cast<int>(end - begin) ).append( ']' );
+
+    return QJsonDocument::fromJson( wrapped ).array().at( 0 ).toString();
+}
+
+// Decode an item value
+Item
+decodeItem( const char* begin, const char* end )
+{
+    Item item;
+
+    const char* b;
+    const char* e;
+
+    if( findKey(begin, end, "id", &b, &e) )
+        item.id = decodeInt( b, e, NULL_ID );
+
+    if( findKey(begin, end, "name", &b, &e) )
+        item.name = StringPool::itemNames().intern( decodeString(b, e) );
+
+    return item;
+}
+
+} // namespace
+
+IssueView::IssueView( const QByteArray& data, int begin, int end )
+    : data_( data ),
+      begin_( begin ),
+      end_( end )
+{
+}
+
+bool
+IssueView::isValid() const
+{
+    return end_ > begin_;
+}
+
+bool
+IssueView::findField( const char* key, const char** begin, const char** end ) const
+{
+    if( !isValid() )
+        return false;
+
+    const char* base = data_.constData();
+
+    return findKey( base + begin_, base + end_, key, begin, end );
+}
+
+QByteArray
+IssueView::rawField( const char* key ) const
+{
+    const char* b;
+    const char* e;
+
+    if( !findField(key, &b, &e) )
+        return QByteArray();
+
+    return QByteArray( b, static_cast<int>(e - b) );
+}
+
+QByteArray
+IssueView::json() const
+{
+    return data_.mid( begin_, end_ - begin_ );
+}
+
+int
+IssueView::id() const
+{
+    if( !(decoded_ & DECODED_ID) )
+    {
+        const char* b;
+        const char* e;
+        id_ = findField( "id", &b, &e ) ? decodeInt( b, e, NULL_ID ) : NULL_ID;
+        decoded_ |= DECODED_ID;
+    }
+
+    return id_;
+}
+
+QString
+IssueView::subject() const
+{
+    if( !(decoded_ & DECODED_SUBJECT) )
+    {
+        const char* b;
+        const char* e;
+        subject_ = findField( "subject", &b, &e ) ? decodeString( b, e ) : QString();
+        decoded_ |= DECODED_SUBJECT;
+    }
+
+    return subject_;
+}
+
+Item
+IssueView::status() const
+{
+    if( !(decoded_ & DECODED_STATUS) )
+    {
+        const char* b;
+        const char* e;
+        status_ = findField( "status", &b, &e ) ? decodeItem( b, e ) : Item();
+        decoded_ |= DECODED_STATUS;
+    }
+
+    return status_;
+}
+
+Timestamp
+IssueView::updatedOn() const
+{
+    if( !(decoded_ & DECODED_UPDATEDON) )
+    {
+        const char* b;
+        const char* e;
+        updatedOn_ = findField( "updated_on", &b, &e ) ? Timestamp::fromString( decodeString(b, e) ) : Timestamp();
+        decoded_ |= DECODED_UPDATEDON;
+    }
+
+    return updatedOn_;
+}
+
+QString
+IssueView::description() const
+{
+    const char* b;
+    const char* e;
+    return findField( "description", &b, &e ) ? decodeString( b, e ) : QString();
+}
+
+Item
+IssueView::project() const
+{
+    const char* b;
+    const char* e;
+    return findField( "project", &b, &e ) ? decodeItem( b, e ) : Item();
+}
+
+Item
+IssueView::tracker() const
+{
+    const char* b;
+    const char* e;
+    return findField( "tracker", &b, &e ) ? decodeItem( b, e ) : Item();
+}
+
+Item
+IssueView::assignedTo() const
+{
+    const char* b;
+    const char* e;
+    return findField( "assigned_to", &b, &e ) ? decodeItem( b, e ) : Item();
+}
+
+Issue
+IssueView::toIssue( CustomFieldTable* table ) const
+{
+    ENTER();
+
+    Issue issue;
+
+    if( !isValid() )
+        RETURN( issue );
+
+    readFields( issue, QJsonDocument::fromJson(json()).object(), 0, table );
+
+    RETURN( issue );
+}
+
+IssueViews
+IssueView::fromPage( const QByteArray& data, int* totalCount )
+{
+    ENTER();
+
+    IssueViews views;
+
+    const char* base = data.constData();
+    const char* end  = base + data.size();
+    const char* b;
+    const char* e;
+
+    if( totalCount )
+        *totalCount = findKey( base, end, "total_count", &b, &e ) ? decodeInt( b, e, -1 ) : -1;
+
+    if( !findKey(base, end, "issues", &b, &e) || *b != '[' )
+        RETURN( views );
+
+    // Iterate over all issue records
+    const char* p = b + 1;
+
+    while( true )
+    {
+        p = skipSpace( p, e );
+        if( p >= e || *p != '{' )
+            break;
+
+        const char* recordEnd = skipValue( p, e );
+        views.push_back( IssueView(data, static_cast<int>(p - base), static_cast<int>(recordEnd - base)) );
+
+        p = skipSpace( recordEnd, e );
+        if( p >= e || *p != ',' )
+            break;
+
+        ++p;
+    }
+
+    RETURN( views );
+}
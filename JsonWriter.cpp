@@ -0,0 +1,197 @@
+#include "JsonWriter.h"
+
+#include <QLocale>
+
+#include <cmath>
+
+using namespace qtredmine;
+
+namespace {
+
+// Hexadecimal digits for \u escapes
+const char HEX[] = "0123456789abcdef";
+
+} // namespace
+
+JsonWriter::JsonWriter( int reserve )
+{
+    data_.reserve( reserve );
+    empty_.reserve( 4 );
+}
+
+void
+JsonWriter::separate()
+{
+    if( afterKey_ )
+    {
+        afterKey_ = false;
+        return;
+    }
+
+    if( !empty_.isEmpty() )
+    {
+        if( !empty_.last() )
+            data_.append( ',' );
+
+        empty_.last() = false;
+    }
+}
+
+void
+JsonWriter::appendString( const QString& string )
+{
+    const QChar* p   = string.constData();
+    const QChar* end = p + string.size();
+
+    data_.append( '"' );
+
+    for( ; p < end; ++p )
+    {
+        uint c = p->unicode();
+
+        // ASCII
+        if( c < 0x80 )
+        {
+            switch( c )
+            {
+            case '"':  data_.append( "\\\"" ); break;
+            case '\\': data_.append( "\\\\" ); break;
+            case '\b': data_.append( "\\b" );  break;
+            case '\f': data_.append( "\\f" );  break;
+            case '\n': data_.append( "\\n" );  break;
+            case '\r': data_.append( "\\r" );  break;
+            case '\t': data_.append( "\\t" );  break;
+            default:
+                if( c < 0x20 )
+                {
+                    const char escape[] = { '\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xf] };
+                    data_.append( escape, sizeof(escape) );
+                }
+                else
+                    data_.append( static_cast<char>(c) );
+            }
+
+            continue;
+        }
+
+        // Surrogate pairs
+        if( p->isHighSurrogate() && p + 1 < end && p[1].isLowSurrogate() )
+        {
+            c = QChar::surrogateToUcs4( p[0], p[1] );
+            ++p;
+        }
+
+        // UTF-8 encoding
+        if( c < 0x800 )
+        {
+            data_.append( static_cast<char>(0xc0 | (c >> 6)) );
+        }
+        else if( c < 0x10000 )
+        {
+            data_.append( static_cast<char>(0xe0 | (c >> 12)) );
+            data_.append( static_cast<char>(0x80 | ((c >> 6) & 0x3f)) );
+        }
+        else
+        {
+            data_.append( static_cast<char>(0xf0 | (c >> 18)) );
+            data_.append( static_cast<char>(0x80 | ((c >> 12) & 0x3f)) );
+            data_.append( static_cast<char>(0x80 | ((c >> 6) & 0x3f)) );
+        }
+
+        data_.append( static_cast<char>(0x80 | (c & 0x3f)) );
+    }
+
+    data_.append( '"' );
+}
+
+JsonWriter&
+JsonWriter::beginObject()
+{
+    separate();
+    data_.append( '{' );
+    empty_.append( true );
+    return *this;
+}
+
+JsonWriter&
+JsonWriter::endObject()
+{
+    data_.append( '}' );
+    empty_.removeLast();
+    return *this;
+}
+
+JsonWriter&
+JsonWriter::beginArray()
+{
+    separate();
+    data_.append( '[' );
+    empty_.append( true );
+    return *this;
+}
+
+JsonWriter&
+JsonWriter::endArray()
+{
+    data_.append( ']' );
+    empty_.removeLast();
+    return *this;
+}
+
+JsonWriter&
+JsonWriter::key( const char* key )
+{
+    separate();
+    data_.append( '"' ).append( key ).append( "\":" );
+    afterKey_ = true;
+    return *this;
+}
+
+JsonWriter&
+JsonWriter::value( bool value )
+{
+    separate();
+    data_.append( value ? "true" : "false" );
+    return *this;
+}
+
+JsonWriter&
+JsonWriter::value( int value )
+{
+    separate();
+    data_.append( QByteArray::number(value) );
+    return *this;
+}
+
+JsonWriter&
+JsonWriter::value( double value )
+{
+    if( !std::isfinite(value) )
+        return null();
+
+    separate();
+
+    // Same precision as QJsonDocument: the shortest exact form is only available from Qt 5.7
+#if QT_VERSION >= QT_VERSION_CHECK( 5, 7, 0 )
+    data_.append( QByteArray::number(value, 'g', QLocale::FloatingPointShortest) );
+#else
+    data_.append( QByteArray::number(value, 'g', 17) );
+#endif
+    return *this;
+}
+
+JsonWriter&
+JsonWriter::value( const QString& value )
+{
+    separate();
+    appendString( value );
+    return *this;
+}
+
+JsonWriter&
+JsonWriter::null()
+{
+    separate();
+    data_.append( "null" );
+    return *this;
+}
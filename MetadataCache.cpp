@@ -0,0 +1,259 @@
+#include "IssueSnapshot.h"
+#include "Logging.h"
+#include "MetadataCache.h"
+#include "SimpleRedmineClient.h"
+
+#include <QPointer>
+
+using namespace qtredmine;
+
+MetadataCache::MetadataCache( SimpleRedmineClient* redmine, int ttl, QObject* parent )
+    : QObject( parent ),
+      redmine_( redmine ),
+      ttl_( ttl )
+{
+    ENTER()(ttl);
+
+    issueStatuses_.loader = [=]( Entry<IssueStatus>::Cb cb ){ redmine_->retrieveIssueStatuses( cb ); };
+    trackers_.loader      = [=]( Entry<Tracker>::Cb cb ){ redmine_->retrieveTrackers( cb ); };
+
+    issuePriorities_.loader     = [=]( Entry<Enumeration>::Cb cb ){ redmine_->retrieveIssuePriorities( cb ); };
+    timeEntryActivities_.loader = [=]( Entry<Enumeration>::Cb cb ){ redmine_->retrieveTimeEntryActivities( cb ); };
+
+    customFields_.loader = [=]( Entry<CustomField>::Cb cb ){ redmine_->retrieveCustomFields( cb, CustomFieldFilter() ); };
+
+    // Periodic background refresh
+    refreshTimer_.setInterval( ttl_ );
+    connect( &refreshTimer_, &QTimer::timeout, this, &MetadataCache::refreshAll );
+    refreshTimer_.start();
+
+    RETURN();
+}
+
+template<typename T>
+void
+MetadataCache::get( Entry<T>& entry, Kind kind, typename Entry<T>::Cb callback )
+{
+    ENTER()(kind);
+
+    if( !entry.loadedAt.isValid() )
+    {
+        // Not loaded yet; wait for the first load
+        if( callback )
+            entry.waiting.push_back( callback );
+
+        load( entry, kind );
+        RETURN();
+    }
+
+    if( callback )
+        callback( entry.items, RedmineError::NO_ERR, QStringList() );
+
+    // Stale entries are refreshed in the background
+    if( entry.stale || entry.loadedAt.hasExpired(ttl_) )
+        load( entry, kind );
+
+    RETURN();
+}
+
+template<typename T>
+void
+MetadataCache::load( Entry<T>& entry, Kind kind )
+{
+    ENTER()(kind)(entry.loading);
+
+    // Single flight: never more than one request per entry
+    if( entry.loading )
+        RETURN();
+
+    entry.loading = true;
+
+    QPointer<MetadataCache> self( this );
+
+    entry.loader( [self, &entry, kind]( QVector<T> items, RedmineError redmineError, QStringList errors )
+    {
+        ENTER()(kind)(redmineError);
+
+        // The cache has been destroyed in the meantime
+        if( !self )
+            RETURN();
+
+        entry.loading = false;
+
+        bool changed = false;
+
+        if( redmineError == RedmineError::NO_ERR )
+        {
+            changed = entry.loadedAt.isValid() && entry.items != items;
+
+            entry.items = items;
+            entry.loadedAt.start();
+            entry.stale = false;
+        }
+
+        // Answer the waiting requests; on errors they receive the error
+        QVector<typename Entry<T>::Cb> waiting;
+        waiting.swap( entry.waiting );
+
+        for( const auto& callback : waiting )
+            callback( items, redmineError, errors );
+
+        if( changed )
+        {
+            DEBUG( "Emitting signal changed()" )(kind);
+            emit self->changed( kind );
+        }
+
+        RETURN();
+    } );
+
+    RETURN();
+}
+
+template<typename T>
+void
+MetadataCache::restore( Entry<T>& entry, const QVector<T>& items )
+{
+    if( items.isEmpty() || entry.loadedAt.isValid() || entry.loading )
+        return;
+
+    entry.items = items;
+    entry.loadedAt.start();
+    entry.stale = true;
+}
+
+void
+MetadataCache::setTtl( int ttl )
+{
+    ENTER()(ttl);
+
+    ttl_ = ttl;
+    refreshTimer_.setInterval( ttl );
+
+    RETURN();
+}
+
+int
+MetadataCache::ttl() const
+{
+    return ttl_;
+}
+
+void
+MetadataCache::issueStatuses( IssueStatusesCb callback )
+{
+    get( issueStatuses_, ISSUE_STATUSES, callback );
+}
+
+void
+MetadataCache::trackers( TrackersCb callback )
+{
+    get( trackers_, TRACKERS, callback );
+}
+
+void
+MetadataCache::issuePriorities( EnumerationsCb callback )
+{
+    get( issuePriorities_, ISSUE_PRIORITIES, callback );
+}
+
+void
+MetadataCache::timeEntryActivities( EnumerationsCb callback )
+{
+    get( timeEntryActivities_, TIME_ENTRY_ACTIVITIES, callback );
+}
+
+void
+MetadataCache::customFields( CustomFieldsCb callback )
+{
+    get( customFields_, CUSTOM_FIELDS, callback );
+}
+
+bool
+MetadataCache::isLoaded( Kind kind ) const
+{
+    switch( kind )
+    {
+    case ISSUE_STATUSES:        return issueStatuses_.loadedAt.isValid();
+    case TRACKERS:              return trackers_.loadedAt.isValid();
+    case ISSUE_PRIORITIES:      return issuePriorities_.loadedAt.isValid();
+    case TIME_ENTRY_ACTIVITIES: return timeEntryActivities_.loadedAt.isValid();
+    case CUSTOM_FIELDS:         return customFields_.loadedAt.isValid();
+    }
+
+    return false;
+}
+
+void
+MetadataCache::refresh( Kind kind )
+{
+    ENTER()(kind);
+
+    switch( kind )
+    {
+    case ISSUE_STATUSES:        load( issueStatuses_, kind );       break;
+    case TRACKERS:              load( trackers_, kind );            break;
+    case ISSUE_PRIORITIES:      load( issuePriorities_, kind );     break;
+    case TIME_ENTRY_ACTIVITIES: load( timeEntryActivities_, kind ); break;
+    case CUSTOM_FIELDS:         load( customFields_, kind );        break;
+    }
+
+    RETURN();
+}
+
+void
+MetadataCache::refreshAll()
+{
+    ENTER();
+
+    // Only refresh what has been requested before
+    for( Kind kind : { ISSUE_STATUSES, TRACKERS, ISSUE_PRIORITIES, TIME_ENTRY_ACTIVITIES, CUSTOM_FIELDS } )
+    {
+        if( isLoaded(kind) )
+            refresh( kind );
+    }
+
+    RETURN();
+}
+
+void
+MetadataCache::invalidate()
+{
+    ENTER();
+
+    // Keep the items, but refresh them on the next request
+    issueStatuses_.stale       = true;
+    trackers_.stale            = true;
+    issuePriorities_.stale     = true;
+    timeEntryActivities_.stale = true;
+    customFields_.stale        = true;
+
+    RETURN();
+}
+
+SnapshotMetadata
+MetadataCache::snapshot() const
+{
+    SnapshotMetadata metadata;
+    metadata.issueStatuses       = issueStatuses_.items;
+    metadata.trackers            = trackers_.items;
+    metadata.issuePriorities     = issuePriorities_.items;
+    metadata.timeEntryActivities = timeEntryActivities_.items;
+    metadata.customFields        = customFields_.items;
+
+    return metadata;
+}
+
+void
+MetadataCache::restore( const SnapshotMetadata& metadata )
+{
+    ENTER();
+
+    restore( issueStatuses_, metadata.issueStatuses );
+    restore( trackers_, metadata.trackers );
+    restore( issuePriorities_, metadata.issuePriorities );
+    restore( timeEntryActivities_, metadata.timeEntryActivities );
+    restore( customFields_, metadata.customFields );
+
+    RETURN();
+}
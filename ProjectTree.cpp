@@ -0,0 +1,250 @@
+#include "Logging.h"
+#include "ProjectTree.h"
+
+#include <QStringList>
+
+#include <algorithm>
+
+using namespace qtredmine;
+
+ProjectTree::ProjectTree( QObject* parent )
+    : QObject( parent )
+{
+    ENTER();
+    RETURN();
+}
+
+void
+ProjectTree::rebuild()
+{
+    ENTER();
+
+    // Candidate children by parent ID; projects without a cached parent start a subtree
+    QHash<int, QVector<int>> candidates;
+    QVector<int> starts;
+
+    for( auto it = nodes_.begin(); it != nodes_.end(); ++it )
+    {
+        it->children.clear();
+        it->begin = -1;
+
+        int parentId = it->project.parent.id;
+
+        if( parentId != NULL_ID && parentId != it.key() && nodes_.contains(parentId) )
+            candidates[parentId].push_back( it.key() );
+        else
+            starts.push_back( it.key() );
+    }
+
+    auto byName = [this]( int a, int b )
+    {
+        const QString& nameA = nodes_.constFind( a )->project.name;
+        const QString& nameB = nodes_.constFind( b )->project.name;
+
+        return nameA != nameB ? nameA < nameB : a < b;
+    };
+
+    std::sort( starts.begin(), starts.end(), byName );
+
+    for( auto it = candidates.begin(); it != candidates.end(); ++it )
+        std::sort( it->begin(), it->end(), byName );
+
+    order_.clear();
+    order_.reserve( nodes_.size() );
+    roots_.clear();
+
+    // Lay out a subtree depth-first, skipping projects that have been laid out already
+    auto layout = [&]( int root )
+    {
+        struct Frame
+        {
+            int id;
+            int next;
+        };
+
+        QVector<Frame> stack;
+
+        nodes_[root].begin = order_.size();
+        order_.push_back( root );
+        roots_.push_back( root );
+        stack.push_back( Frame{root, 0} );
+
+        while( !stack.isEmpty() )
+        {
+            Frame& frame = stack.last();
+            auto children = candidates.constFind( frame.id );
+
+            if( children == candidates.constEnd() || frame.next == children->size() )
+            {
+                nodes_[frame.id].end = order_.size();
+                stack.pop_back();
+                continue;
+            }
+
+            int child = children->at( frame.next++ );
+            Node& node = nodes_[child];
+
+            if( node.begin != -1 )
+                continue;
+
+            nodes_[frame.id].children.push_back( child );
+            node.begin = order_.size();
+            order_.push_back( child );
+            stack.push_back( Frame{child, 0} );
+        }
+    };
+
+    for( int id : starts )
+        layout( id );
+
+    // Projects in a parent cycle are reached from no root; each cycle starts at its lowest ID
+    if( order_.size() < nodes_.size() )
+    {
+        QList<int> ids = nodes_.keys();
+        std::sort( ids.begin(), ids.end() );
+
+        for( int id : ids )
+        {
+            if( nodes_[id].begin == -1 )
+                layout( id );
+        }
+
+        std::sort( roots_.begin(), roots_.end(), byName );
+    }
+
+    for( auto it = nodes_.begin(); it != nodes_.end(); ++it )
+    {
+        QStringList subprojects;
+
+        for( int i = it->begin + 1; i < it->end; ++i )
+            subprojects << QString::number( order_.at(i) );
+
+        it->filter = QString( "project_id=%1&subproject_id=%2" )
+                     .arg( it.key() )
+                     .arg( subprojects.isEmpty() ? QString("!*") : subprojects.join("|") );
+    }
+
+    DEBUG()(nodes_.size())(roots_.size());
+
+    RETURN();
+}
+
+void
+ProjectTree::insert( const Project& project )
+{
+    ENTER()(project.id);
+
+    if( project.id == NULL_ID )
+        RETURN();
+
+    nodes_[project.id].project = project;
+    rebuild();
+
+    RETURN();
+}
+
+void
+ProjectTree::insert( const Projects& projects )
+{
+    ENTER()(projects.size());
+
+    for( const auto& project : projects )
+    {
+        if( project.id != NULL_ID )
+            nodes_[project.id].project = project;
+    }
+
+    rebuild();
+
+    RETURN();
+}
+
+void
+ProjectTree::remove( int id )
+{
+    ENTER()(id);
+
+    if( nodes_.remove(id) )
+        rebuild();
+
+    RETURN();
+}
+
+void
+ProjectTree::clear()
+{
+    ENTER();
+
+    nodes_.clear();
+    order_.clear();
+    roots_.clear();
+
+    RETURN();
+}
+
+int
+ProjectTree::size() const
+{
+    return nodes_.size();
+}
+
+const Project*
+ProjectTree::find( int id ) const
+{
+    auto it = nodes_.constFind( id );
+    return it != nodes_.constEnd() ? &it->project : nullptr;
+}
+
+int
+ProjectTree::parent( int id ) const
+{
+    auto it = nodes_.constFind( id );
+    if( it == nodes_.constEnd() )
+        return NULL_ID;
+
+    // The parent is only the parent in the hierarchy if its range contains the project
+    auto parent = nodes_.constFind( it->project.parent.id );
+
+    if( parent != nodes_.constEnd() && parent->begin < it->begin && it->begin < parent->end )
+        return parent.key();
+
+    return NULL_ID;
+}
+
+QVector<int>
+ProjectTree::roots() const
+{
+    return roots_;
+}
+
+QVector<int>
+ProjectTree::children( int id ) const
+{
+    auto it = nodes_.constFind( id );
+    return it != nodes_.constEnd() ? it->children : QVector<int>();
+}
+
+QVector<int>
+ProjectTree::descendants( int id ) const
+{
+    auto it = nodes_.constFind( id );
+    return it != nodes_.constEnd() ? order_.mid( it->begin + 1, it->end - it->begin - 1 ) : QVector<int>();
+}
+
+QVector<int>
+ProjectTree::ancestors( int id ) const
+{
+    QVector<int> ids;
+
+    for( int current = parent(id); current != NULL_ID; current = parent(current) )
+        ids.push_back( current );
+
+    return ids;
+}
+
+QString
+ProjectTree::filter( int id ) const
+{
+    auto it = nodes_.constFind( id );
+    return it != nodes_.constEnd() ? it->filter : QString();
+}
@@ -2,6 +2,7 @@
 #include "Logging.h"
 #include "PasswordAuthenticator.h"
 #include "RedmineClient.h"
+#include "StringPool.h"
 
 #include <QJsonArray>
 #include <QJsonObject>
@@ -172,6 +173,10 @@ RedmineClient::setUrl( const QString& url )
     if( url == url_ )
         RETURN();
 
+    // Item names of the previous server that are no longer used are not needed anymore
+    if( !url_.isEmpty() )
+        StringPool::itemNames().trim();
+
     url_ = url;
 
     if( auth_ )
@@ -197,6 +202,47 @@ RedmineClient::sendRequest( const QString& resource, JsonCb callback,
 {
     ENTER()(resource)(mode)(queryParams)(postData);
 
+    if( mode == QNetworkAccessManager::GetOperation && !callback )
+    {
+        DEBUG( "No callback specified for HTTP GET mode" );
+        RETURN( nullptr );
+    }
+
+    QNetworkReply* reply = startRequest( resource, mode, queryParams, postData );
+
+    if( reply && callback )
+        callbacks_[reply] = callback;
+
+    RETURN( reply );
+}
+
+QNetworkReply*
+RedmineClient::sendRawRequest( const QString& resource, RawCb callback,
+                               const QNetworkAccessManager::Operation mode,
+                               const QString& queryParams, const QByteArray& postData )
+{
+    ENTER()(resource)(mode)(queryParams)(postData);
+
+    if( mode == QNetworkAccessManager::GetOperation && !callback )
+    {
+        DEBUG( "No callback specified for HTTP GET mode" );
+        RETURN( nullptr );
+    }
+
+    QNetworkReply* reply = startRequest( resource, mode, queryParams, postData );
+
+    if( reply && callback )
+        rawCallbacks_[reply] = callback;
+
+    RETURN( reply );
+}
+
+QNetworkReply*
+RedmineClient::startRequest( const QString& resource, const QNetworkAccessManager::Operation mode,
+                             const QString& queryParams, const QByteArray& postData )
+{
+    ENTER()(resource)(mode)(queryParams)(postData);
+
     //
     // Initial checks
     //
@@ -213,12 +259,6 @@ RedmineClient::sendRequest( const QString& resource, JsonCb callback,
         RETURN( nullptr );
     }
 
-    if( mode == QNetworkAccessManager::GetOperation && !callback )
-    {
-        DEBUG( "No callback specified for HTTP GET mode" );
-        RETURN( nullptr );
-    }
-
     //
     // Build the Redmine REST URL
     //
@@ -272,9 +312,6 @@ RedmineClient::sendRequest( const QString& resource, JsonCb callback,
         RETURN( nullptr );
     }
 
-    if( reply && callback )
-        callbacks_[reply] = callback;
-
     RETURN( reply );
 }
 
@@ -283,8 +320,16 @@ RedmineClient::replyFinished( QNetworkReply* reply )
 {
     ENTER()(reply);
 
+    // Search for raw callback function; raw callbacks get the unparsed reply data
+    if( reply && rawCallbacks_.contains(reply) )
+    {
+        QByteArray data_raw = reply->readAll();
+
+        RawCb callback = rawCallbacks_.take( reply );
+        callback( reply, &data_raw );
+    }
     // Search for callback function
-    if( reply && callbacks_.contains(reply) )
+    else if( reply && callbacks_.contains(reply) )
     {
         QByteArray data_raw = reply->readAll();
         QJsonDocument data_json = QJsonDocument::fromJson( data_raw );
@@ -327,7 +372,7 @@ RedmineClient::sendCustomField( const QJsonDocument& data, JsonCb callback, cons
 
     getResMode( id, resource, mode );
 
-    sendRequest( resource, callback, mode, parameters, data.toJson() );
+    sendRequest( resource, callback, mode, parameters, data.toJson(QJsonDocument::Compact) );
 
     RETURN();
 }
@@ -343,7 +388,7 @@ RedmineClient::sendEnumeration( const QString& enumeration, const QJsonDocument&
 
     getResMode( id, resource, mode );
 
-    sendRequest( resource, callback, mode, parameters, data.toJson() );
+    sendRequest( resource, callback, mode, parameters, data.toJson(QJsonDocument::Compact) );
 
     RETURN();
 }
@@ -354,12 +399,23 @@ RedmineClient::sendIssue( const QJsonDocument& data, JsonCb callback, const int
 {
     ENTER()(id)(parameters);
 
+    sendIssue( data.toJson(QJsonDocument::Compact), callback, id, parameters );
+
+    RETURN();
+}
+
+void
+RedmineClient::sendIssue( const QByteArray& data, JsonCb callback, const int id,
+                          const QString& parameters )
+{
+    ENTER()(id)(parameters);
+
     QString resource = "issues";
     QNetworkAccessManager::Operation mode;
 
     getResMode( id, resource, mode );
 
-    sendRequest( resource, callback, mode, parameters, data.toJson() );
+    sendRequest( resource, callback, mode, parameters, data );
 
     RETURN();
 }
@@ -375,7 +431,7 @@ RedmineClient::sendIssueCategory( const QJsonDocument& data, JsonCb callback, co
 
     getResMode( id, resource, mode );
 
-    sendRequest( resource, callback, mode, parameters, data.toJson() );
+    sendRequest( resource, callback, mode, parameters, data.toJson(QJsonDocument::Compact) );
 
     RETURN();
 }
@@ -407,7 +463,7 @@ RedmineClient::sendIssueStatus( const QJsonDocument& data, JsonCb callback, cons
 
     getResMode( id, resource, mode );
 
-    sendRequest( resource, callback, mode, parameters, data.toJson() );
+    sendRequest( resource, callback, mode, parameters, data.toJson(QJsonDocument::Compact) );
 
     RETURN();
 }
@@ -423,7 +479,7 @@ RedmineClient::sendProject( const QJsonDocument& data, JsonCb callback, const in
 
     getResMode( id, resource, mode );
 
-    sendRequest( resource, callback, mode, parameters, data.toJson() );
+    sendRequest( resource, callback, mode, parameters, data.toJson(QJsonDocument::Compact) );
 
     RETURN();
 }
@@ -434,12 +490,23 @@ RedmineClient::sendTimeEntry( const QJsonDocument& data, JsonCb callback, const
 {
     ENTER()(parameters);
 
+    sendTimeEntry( data.toJson(QJsonDocument::Compact), callback, id, parameters );
+
+    RETURN();
+}
+
+void
+RedmineClient::sendTimeEntry( const QByteArray& data, JsonCb callback, const int id,
+                              const QString& parameters )
+{
+    ENTER()(parameters);
+
     QString resource = "time_entries";
     QNetworkAccessManager::Operation mode;
 
     getResMode( id, resource, mode );
 
-    sendRequest( resource, callback, mode, parameters, data.toJson() );
+    sendRequest( resource, callback, mode, parameters, data );
 
     RETURN();
 }
@@ -471,7 +538,7 @@ RedmineClient::sendTracker( const QJsonDocument& data, JsonCb callback, const in
 
     getResMode( id, resource, mode );
 
-    sendRequest( resource, callback, mode, parameters, data.toJson() );
+    sendRequest( resource, callback, mode, parameters, data.toJson(QJsonDocument::Compact) );
 
     RETURN();
 }
@@ -486,7 +553,7 @@ RedmineClient::sendUser( const QJsonDocument& data, JsonCb callback, const int i
 
     getResMode( id, resource, mode );
 
-    sendRequest( resource, callback, mode, parameters, data.toJson() );
+    sendRequest( resource, callback, mode, parameters, data.toJson(QJsonDocument::Compact) );
 
     RETURN();
 }
@@ -521,6 +588,16 @@ RedmineClient::retrieveIssues( JsonCb callback, const QString& parameters )
     RETURN();
 }
 
+void
+RedmineClient::retrieveRawIssues( RawCb callback, const QString& parameters )
+{
+    ENTER()(parameters);
+
+    sendRawRequest( "issues", callback, QNetworkAccessManager::GetOperation, parameters );
+
+    RETURN();
+}
+
 void
 RedmineClient::retrieveIssueCategories( JsonCb callback, const int projectId, const QString& parameters )
 {
@@ -1,50 +1,299 @@
+#include "CustomFieldTable.h"
+#include "IssueSnapshot.h"
+#include "IssueStore.h"
 #include "Logging.h"
+#include "MetadataCache.h"
+#include "ProjectTree.h"
 #include "SimpleRedmineClient.h"
 
+#ifdef QTREDMINE_SQLITE
+#include "SqliteMirror.h"
+#endif
+
+#include <QElapsedTimer>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QPointer>
+#include <QSet>
 #include <QTimer>
+#include <QUrlQuery>
 
 using namespace qtredmine;
 
-// Fill items
+QStringList
+getErrorList( QNetworkReply* reply, QJsonDocument* json )
+{
+    ENTER()(reply->error())(json->toJson());
+
+    QJsonArray jsonErrors = json->object().find("errors").value().toArray();
+    QStringList errors;
+    errors.push_back( reply->errorString() );
+
+    for( const auto& error : jsonErrors )
+        errors.push_back( error.toString() );
+
+    RETURN( errors );
+}
+
+QStringList
+getErrorList( QNetworkReply* reply, QByteArray* raw )
+{
+    QJsonDocument json = QJsonDocument::fromJson( *raw );
+    return getErrorList( reply, &json );
+}
+
+namespace {
+
+// Get the error of a failed write; without an HTTP reply, the write can be retried
+RedmineError
+writeError( QNetworkReply* reply )
+{
+    switch( reply->error() )
+    {
+    case QNetworkReply::ConnectionRefusedError:
+    case QNetworkReply::RemoteHostClosedError:
+    case QNetworkReply::HostNotFoundError:
+    case QNetworkReply::TimeoutError:
+    case QNetworkReply::OperationCanceledError:
+    case QNetworkReply::TemporaryNetworkFailureError:
+    case QNetworkReply::NetworkSessionFailedError:
+    case QNetworkReply::BackgroundRequestNotAllowedError:
+    case QNetworkReply::UnknownNetworkError:
+    case QNetworkReply::ProxyConnectionRefusedError:
+    case QNetworkReply::ProxyConnectionClosedError:
+    case QNetworkReply::ProxyNotFoundError:
+    case QNetworkReply::ProxyTimeoutError:
+    case QNetworkReply::UnknownProxyError:
+        return RedmineError::ERR_UNREACHABLE;
+
+    default:
+        return RedmineError::ERR_NETWORK;
+    }
+}
+
+} // namespace
+
+template<typename Reply>
 void
-fillItem( Item& item, QJsonObject* obj, QString value)
+SimpleRedmineClient::retrievePages( std::function<void(std::function<void(QNetworkReply*, Reply*)>, QString)> fetch,
+                                    std::function<int(int, Reply*, int*)> decode,
+                                    std::function<void(RedmineError, QStringList)> done,
+                                    RedmineOptions options, int window )
 {
-    QJsonObject itemObj = obj->value(value).toObject();
+    ENTER()(options)(window);
 
-    if( !itemObj.isEmpty() )
+    // Do not wait for a timeout while Redmine is not accessible
+    if( isOffline() )
     {
-        item.id   = itemObj.value("id").toInt();
-        item.name = itemObj.value("name").toString();
+        done( RedmineError::ERR_NETWORK, QStringList() << "Redmine is not accessible" );
+        RETURN();
     }
+
+    using PageCb = std::function<void(QNetworkReply*, Reply*)>;
+
+    struct Data
+    {
+        int pageCount = 1;
+        int next = 1;
+        int pending = 1;
+        int window = 1;
+        bool failed = false;
+        RedmineOptions options;
+        std::function<void(PageCb, QString)> fetch;
+        std::function<int(int, Reply*, int*)> decode;
+        std::function<void(RedmineError, QStringList)> done;
+        std::function<PageCb(int)> pageCb;
+    };
+
+    Data* data = new Data();
+    data->options = options;
+    data->window  = qMax( window, 1 );
+    data->fetch   = fetch;
+    data->decode  = decode;
+    data->done    = done;
+
+    // Request one page
+    auto fetchPage = [this, data]( int page )
+    {
+        data->fetch( data->pageCb(page),
+                     QString("%1&offset=%2&limit=%3")
+                         .arg(data->options.parameters)
+                         .arg(page * limit_)
+                         .arg(limit_) );
+    };
+
+    // Create the callback for one page
+    data->pageCb = [this, data, fetchPage]( int page ) -> PageCb
+    {
+        return [this, data, fetchPage, page]( QNetworkReply* reply, Reply* body )
+        {
+            ENTER()(page);
+
+            if( reply->error() != QNetworkReply::NoError && !data->failed )
+            {
+                // Report the first error only
+                DEBUG() << "Network error:" << reply->errorString();
+                data->failed = true;
+                data->done( RedmineError::ERR_NETWORK, getErrorList(reply, body) );
+            }
+            else if( !data->failed )
+            {
+                int total = -1;
+                const int count = data->decode( page, body, &total );
+
+                if( data->options.getAllItems && count == limit_ )
+                {
+                    // The first page tells the number of pages; without a total, continue page by page
+                    if( page == 0 && total >= 0 )
+                        data->pageCount = qMax( (total + limit_ - 1) / limit_, 1 );
+                    else if( total < 0 && page + 1 == data->pageCount )
+                        ++data->pageCount;
+                }
+
+                // Keep the window of requests in flight filled; this reply still counts as pending
+                while( data->next < data->pageCount && data->pending <= data->window )
+                {
+                    ++data->pending;
+                    fetchPage( data->next++ );
+                }
+            }
+
+            if( --data->pending )
+                RETURN();
+
+            // All pages received
+            if( !data->failed )
+                data->done( RedmineError::NO_ERR, QStringList() );
+
+            delete data;
+
+            RETURN();
+        };
+    };
+
+    fetchPage( 0 );
+
+    RETURN();
 }
 
-// Fill default fields
 template<typename T>
 void
-fillDefaultFields( T& item, QJsonObject* obj)
+SimpleRedmineClient::retrieveCollection( const char* key,
+                                         std::function<void(JsonCb, QString)> fetch,
+                                         std::function<void(QVector<T>, RedmineError, QStringList)> callback,
+                                         RedmineOptions options )
 {
-    item.createdOn = obj->value("created_on").toVariant().toDateTime();
-    item.updatedOn = obj->value("updated_on").toVariant().toDateTime();
+    ENTER()(key)(options);
+
+    struct Data
+    {
+        QVector<QVector<T>> pages;
+        quint64 skip = 0;
+        CustomFieldTable* table = nullptr;
+        QLatin1String key;
+
+        explicit Data( const char* key ) : key( key ) {}
+    };
+
+    Data* data = new Data( key );
+    data->skip  = skippedFields<T>( options );
+    data->table = customFieldTable();
+
+    auto decode = [data]( int page, QJsonDocument* json, int* total ) -> int
+    {
+        QJsonObject obj   = json->object();
+        QJsonArray  array = obj.value( data->key ).toArray();
+        const int   count = array.size();
+
+        *total = obj.value( QLatin1String("total_count") ).toInt( -1 );
+
+        if( page >= data->pages.size() )
+            data->pages.resize( page + 1 );
+
+        // Decode the items in place
+        readItems( data->pages[page], array, data->skip, data->table );
+
+        return count;
+    };
+
+    auto done = [data, callback]( RedmineError redmineError, QStringList errors )
+    {
+        if( redmineError == RedmineError::NO_ERR )
+        {
+            int size = 0;
+            for( const auto& items : data->pages )
+                size += items.size();
+
+            QVector<T> result;
+            result.reserve( size );
+
+            for( const auto& items : data->pages )
+                result += items;
 
-    fillItem( item.user, obj, "user" );
+            callback( result, redmineError, errors );
+        }
+        else
+        {
+            callback( QVector<T>(), redmineError, errors );
+        }
+
+        delete data;
+    };
+
+    retrievePages<QJsonDocument>( fetch, decode, done, options, pageWindow_ );
+
+    RETURN();
 }
 
-QStringList
-getErrorList( QNetworkReply* reply, QJsonDocument* json )
+template<typename T>
+std::function<void(QVector<T>, RedmineError, QStringList)>
+SimpleRedmineClient::mirrored( std::function<void(QVector<T>, RedmineError, QStringList)> callback,
+                               const RedmineOptions& options )
 {
-    ENTER()(reply->error())(json->toJson());
+#ifdef QTREDMINE_SQLITE
+    // Partially decoded resources would overwrite complete rows with empty fields
+    if( !sqliteMirror_ || options.profile != ParseProfile::FULL )
+        return callback;
 
-    QJsonArray jsonErrors = json->object().find("errors").value().toArray();
-    QStringList errors;
-    errors.push_back( reply->errorString() );
+    QPointer<SqliteMirror> mirror( sqliteMirror_ );
 
-    for( const auto& error : jsonErrors )
-        errors.push_back( error.toString() );
+    return [mirror, callback]( QVector<T> items, RedmineError redmineError, QStringList errors )
+    {
+        // The rows are written in chunks from the event loop, so the callback is not delayed
+        if( mirror && redmineError == RedmineError::NO_ERR )
+            mirror->enqueue( items );
 
-    RETURN( errors );
+        callback( items, redmineError, errors );
+    };
+#else
+    Q_UNUSED( options );
+    return callback;
+#endif
+}
+
+template<typename T>
+bool
+SimpleRedmineClient::failOffline( const std::function<void(T, RedmineError, QStringList)>& callback )
+{
+    if( !isOffline() )
+        return false;
+
+    // Without a cache for the resource, do not wait for a timeout either
+    callback( T(), RedmineError::ERR_NETWORK, QStringList() << "Redmine is not accessible" );
+    return true;
+}
+
+template<typename T>
+void
+SimpleRedmineClient::writeThrough( const QVector<T>& items )
+{
+#ifdef QTREDMINE_SQLITE
+    if( sqliteMirror_ )
+        sqliteMirror_->enqueue( items );
+#else
+    Q_UNUSED( items );
+#endif
 }
 
 SimpleRedmineClient::SimpleRedmineClient( QObject* parent )
@@ -80,6 +329,16 @@ SimpleRedmineClient::SimpleRedmineClient( QString url, QString login, QString pa
     RETURN();
 }
 
+SimpleRedmineClient::~SimpleRedmineClient()
+{
+    ENTER();
+
+    // The issue store may be gone already, so the snapshot is not decoded
+    delete snapshot_;
+
+    RETURN();
+}
+
 void
 SimpleRedmineClient::init()
 {
@@ -196,6 +455,12 @@ SimpleRedmineClient::getTime( const QString& stime )
     RETURN( time );
 }
 
+QNetworkAccessManager::NetworkAccessibility
+SimpleRedmineClient::connectionStatus() const
+{
+    return connected_;
+}
+
 void
 SimpleRedmineClient::reconnect()
 {
@@ -207,281 +472,716 @@ SimpleRedmineClient::reconnect()
     RETURN();
 }
 
-void
-SimpleRedmineClient::sendIssue( Issue item, SuccessCb callback, int id, QString parameters )
+CustomFieldTable*
+SimpleRedmineClient::customFieldTable() const
 {
-    ENTER()(item)(id)(parameters);
-
-    QJsonObject attr;
+    return &CustomFieldTable::forServer( getUrl() );
+}
 
-    if( item.project.id != NULL_ID )
-        attr["project_id"] = item.project.id;
+MetadataCache*
+SimpleRedmineClient::metadataCache()
+{
+    ENTER();
 
-    if( item.tracker.id != NULL_ID )
-        attr["tracker_id"] = item.tracker.id;
+    if( !metadataCache_ )
+        metadataCache_ = new MetadataCache( this, 3600 * 1000, this );
 
-    if( item.status.id != NULL_ID )
-        attr["status_id"] = item.status.id;
+    RETURN( metadataCache_ );
+}
 
-    if( item.priority.id != NULL_ID )
-        attr["priority_id"] = item.priority.id;
+void
+SimpleRedmineClient::setIssueStore( IssueStore* store )
+{
+    ENTER()(store);
 
-    if( !item.subject.isEmpty() )
-        attr["subject"] = item.subject;
+    if( store != issueStore_ )
+        closeSnapshot( true );
 
-    if( !item.description.isEmpty() )
-        attr["description"] = item.description;
+    issueStore_ = store;
 
-    if( item.category.id != NULL_ID )
-        attr["category_id"] = item.category.id;
+    RETURN();
+}
 
-    if( item.version.id != NULL_ID )
-        attr["fixed_version_id"] = item.version.id;
+IssueStore*
+SimpleRedmineClient::issueStore() const
+{
+    return issueStore_;
+}
 
-    if( item.assignedTo.id != NULL_ID )
-        attr["assigned_to_id"] = item.assignedTo.id;
+#ifdef QTREDMINE_SQLITE
+void
+SimpleRedmineClient::setSqliteMirror( SqliteMirror* mirror )
+{
+    ENTER()(mirror);
 
-    if( item.parentId != NULL_ID )
-        attr["parent_issue_id"] = item.parentId;
+    sqliteMirror_ = mirror;
 
-    if( item.startDate.isValid() )
-        attr["start_date"] = item.startDate.toString( "yyyy-MM-dd" );
+    RETURN();
+}
 
-    if( item.dueDate.isValid() )
-        attr["due_date"] = item.dueDate.toString( "yyyy-MM-dd" );
+SqliteMirror*
+SimpleRedmineClient::sqliteMirror() const
+{
+    return sqliteMirror_;
+}
+#endif
 
-    if( item.customFields.size() )
-    {
-        QJsonArray customFields;
+void
+SimpleRedmineClient::setProjectTree( ProjectTree* tree )
+{
+    ENTER()(tree);
 
-        for( const auto& customField : item.customFields )
-        {
-            QJsonObject cf;
-            cf["id"] = customField.id;
-            cf["value"] = customField.values.at( 0 );
-            customFields.append( cf );
-        }
+    projectTree_ = tree;
 
-        attr["custom_fields"] = customFields;
-    }
+    RETURN();
+}
 
-//    if( item.watcher_user_ids != NULL_ID )
-//        attr["watcher_user_ids"] = item.watcher_user_ids;
+ProjectTree*
+SimpleRedmineClient::projectTree() const
+{
+    return projectTree_;
+}
 
-//    if( item.is_private != NULL_ID )
-//        attr["is_private"] = item.is_private;
+Timestamp
+SimpleRedmineClient::syncCursor( QString parameters ) const
+{
+    return syncCursors_.value( parameters );
+}
 
-    if( item.estimatedHours )
-        attr["estimated_hours"] = item.estimatedHours;
+void
+SimpleRedmineClient::setSyncCursor( Timestamp cursor, QString parameters )
+{
+    ENTER()(cursor)(parameters);
 
-    QJsonObject data;
-    data["issue"] = attr;
+    if( cursor.isValid() )
+        syncCursors_.insert( parameters, cursor );
+    else
+        syncCursors_.remove( parameters );
 
-    QJsonDocument json;
-    json.setObject( data );
+    RETURN();
+}
 
-    DEBUG()(json.toJson());
+bool
+SimpleRedmineClient::saveSnapshot( const QString& path, QString parameters )
+{
+    ENTER()(path)(parameters);
 
-    auto cb = [=]( QNetworkReply* reply, QJsonDocument* json )
+    if( !issueStore_ )
     {
-        ENTER();
-
-        DEBUG()(json->toJson());
-
-        // Quit on network error
-        if( reply->error() != QNetworkReply::NoError )
-        {
-            DEBUG() << "Network error:" << reply->errorString();
-            callback( false, NULL_ID, RedmineError::ERR_NETWORK, getErrorList(reply, json) );
-            RETURN();
-        }
+        DEBUG( "No issue store set" );
+        RETURN( false );
+    }
 
-        // Iterate over the document
-        QJsonObject jsonIssue = json->object().find("issue").value().toObject();
-        int issueId = jsonIssue.find("id").value().toInt();
+    // The file of a loaded snapshot may be the one to replace
+    closeSnapshot( true );
 
-        callback( true, issueId, RedmineError::NO_ERR, QStringList() );
-    };
+    SnapshotMetadata metadata = metadataCache_ ? metadataCache_->snapshot() : SnapshotMetadata();
+    metadata.customFields = customFieldTable()->values();
+    metadata.syncCursor   = syncCursor( parameters );
 
-    RedmineClient::sendIssue( json, cb, id, parameters );
+    bool written = IssueSnapshot::write( path, issueStore_->issues(), metadata );
 
-    RETURN();
+    RETURN( written );
 }
 
-void
-SimpleRedmineClient::sendTimeEntry( TimeEntry item, SuccessCb callback, int id, QString parameters )
+bool
+SimpleRedmineClient::loadSnapshot( const QString& path, QString parameters )
 {
-    ENTER()(id)(parameters);
+    ENTER()(path)(parameters);
 
-    if( item.hours < 0.01 )
+    if( !issueStore_ )
     {
-        DEBUG() << "Time entry has to be at least 0.1 hours (36 seconds)";
-        callback( false, NULL_ID, RedmineError::ERR_TIME_ENTRY_TOO_SHORT, QStringList() );
-        RETURN();
+        DEBUG( "No issue store set" );
+        RETURN( false );
     }
 
-    if( id == NULL_ID && item.issue.id == NULL_ID && item.project.id == NULL_ID )
+    IssueSnapshot* snapshot = new IssueSnapshot();
+
+    if( !snapshot->open(path) )
     {
-        DEBUG() << "No issue and no project specified";
-        callback( false, NULL_ID, RedmineError::ERR_INCOMPLETE_DATA, QStringList() );
-        RETURN();
+        delete snapshot;
+        RETURN( false );
     }
 
-    QJsonObject attr;
+    closeSnapshot( true );
 
-    attr["hours"] = item.hours;
+    SnapshotMetadata metadata = snapshot->metadata();
+    CustomFieldTable* table = customFieldTable();
 
-    if( item.activity.id != NULL_ID )
-        attr["activity_id"] = item.activity.id;
+    // Definitions known already have been parsed or retrieved since the snapshot was written
+    for( const auto& field : metadata.customFields )
+    {
+        if( !table->contains(field.id) )
+            table->insert( field );
+    }
 
-    if( !item.comment.isEmpty() )
-        attr["comments"] = item.comment;
+    // Stored issues that are older than in the snapshot are replaced now, all others are only decoded
+    // on first access
+    Issues issues;
 
-    if( item.issue.id != NULL_ID )
-        attr["issue_id"] = item.issue.id;
+    for( const auto& stored : issueStore_->issues() )
+    {
+        int row = snapshot->indexOf( stored.id );
 
-    if( item.project.id != NULL_ID )
-        attr["project_id"] = item.project.id;
+        if( row >= 0 && stored.updatedOn < snapshot->updatedOn(row) )
+            issues.push_back( snapshot->issue(row, table) );
+    }
 
-    if( item.spentOn.isValid() )
-        attr["spent_on"] = item.spentOn.toString( Qt::ISODate );
+    issueStore_->insert( issues );
 
-    if( item.customFields.size() )
-    {
-        QJsonArray customFields;
+    snapshot_ = snapshot;
+    snapshotRemoved_ = QBitArray( snapshot->size() );
 
-        for( const auto& customField : item.customFields )
+    // Issues removed from the store must not come back from the snapshot
+    connect( issueStore_, &IssueStore::issuesRemoved, this, [this]( QVector<int> ids )
+    {
+        for( int id : ids )
         {
-            QJsonObject cf;
-            cf["id"] = customField.id;
-            cf["value"] = customField.values.at( 0 );
-            customFields.append( cf );
+            int row = snapshot_->indexOf( id );
+
+            if( row >= 0 )
+                snapshotRemoved_.setBit( row );
         }
+    } );
 
-        attr["custom_fields"] = customFields;
-    }
+    connect( issueStore_, &IssueStore::cleared, this, [this]()
+    {
+        closeSnapshot( false );
+    } );
 
-    QJsonObject data;
-    data["time_entry"] = attr;
+    metadata.customFields = table->values();
+    metadataCache()->restore( metadata );
 
-    QJsonDocument json;
-    json.setObject( data );
+    if( !syncCursor(parameters).isValid() )
+        setSyncCursor( metadata.syncCursor, parameters );
 
-    auto cb = [=]( QNetworkReply* reply, QJsonDocument* json )
-    {
-        ENTER();
+    DEBUG()(snapshot->size())(issues.size());
 
-        // Quit on network error
-        if( reply->error() != QNetworkReply::NoError )
-        {
-            DEBUG() << "Network error:" << reply->errorString();
-            callback( false, NULL_ID, RedmineError::ERR_NETWORK, getErrorList(reply, json) );
-            RETURN();
-        }
+    RETURN( true );
+}
 
-        callback( true, NULL_ID, RedmineError::NO_ERR, QStringList() );
-    };
+int
+SimpleRedmineClient::decodeSnapshot()
+{
+    ENTER();
 
-    RedmineClient::sendTimeEntry( json, cb, id, parameters );
+    int inserted = closeSnapshot( true );
 
-    RETURN();
+    RETURN( inserted );
 }
 
-void
-SimpleRedmineClient::retrieveCustomFields( CustomFieldsCb callback, CustomFieldFilter filter )
+int
+SimpleRedmineClient::closeSnapshot( bool decode )
 {
-    ENTER();
+    ENTER()(decode);
 
-    auto cb = [=]( QNetworkReply* reply, QJsonDocument* json )
+    if( !snapshot_ )
+        RETURN( 0 );
+
+    int inserted = 0;
+
+    if( decode && issueStore_ )
     {
-        ENTER();
+        CustomFieldTable* table = customFieldTable();
+        Issues issues;
 
-        // Quit on network error
-        if( reply->error() != QNetworkReply::NoError )
+        for( int row = 0; row < snapshot_->size(); ++row )
         {
-            DEBUG() << "Network error:" << reply->errorString();
-            callback( CustomFields(), RedmineError::ERR_NETWORK, getErrorList(reply, json) );
-            RETURN();
+            if( !snapshotRemoved_.testBit(row) && !issueStore_->contains(snapshot_->id(row)) )
+                issues.push_back( snapshot_->issue(row, table) );
         }
 
-        CustomFields customFields;
+        inserted = issueStore_->insert( issues );
+    }
 
-        // Iterate over the document
-        for( const auto& j1 : json->object() )
-        {
-            // Iterate over all customFields
-            for( const auto& j2 : j1.toArray() )
-            {
-                QJsonObject obj = j2.toObject();
+    if( issueStore_ )
+        disconnect( issueStore_, nullptr, this, nullptr );
 
-                CustomField customField;
+    delete snapshot_;
+    snapshot_ = nullptr;
+    snapshotRemoved_.clear();
 
-                // Simple fields
-                customField.id   = obj.value("id").toInt();
-                customField.name = obj.value("name").toString();
+    RETURN( inserted );
+}
 
-                customField.defaultValue = obj.value("default_value").toString();
+const Issue*
+SimpleRedmineClient::storedIssue( int id )
+{
+    ENTER()(id);
 
-                customField.type = obj.value("customized_type").toString();
-                if( !filter.type.isEmpty() && filter.type != customField.type )
-                {
-                    DEBUG("Skipping custom field without type")(filter.type);
-                    continue;
-                }
+    if( !issueStore_ )
+        RETURN( nullptr );
 
-                customField.format = obj.value("field_format").toString();
-                if( !filter.format.isEmpty() && filter.format != customField.format )
-                {
-                    DEBUG("Skipping custom field without format")(filter.format);
-                    continue;
-                }
+    const Issue* issue = issueStore_->find( id );
 
-                customField.regex     = obj.value("regex").toString();
-                customField.minLength = obj.value("min_length").toInt();
-                customField.maxLength = obj.value("max_length").toInt();
+    if( issue || !snapshot_ )
+        RETURN( issue );
 
-                customField.allProjects = obj.value("is_for_all").toBool();
-                customField.isRequired  = obj.value("is_required").toBool();
-                customField.isFilter    = obj.value("is_filter").toBool();
-                customField.searchable  = obj.value("searchable").toBool();
-                customField.multiple    = obj.value("multiple").toBool();
-                customField.visible     = obj.value("visible").toBool();
+    int row = snapshot_->indexOf( id );
 
-                // Iterate over all possible values
-                for( const auto& j3 : obj.value("possible_values").toArray() )
-                    customField.possibleValues.push_back( j3.toObject().value("value").toString() );
+    if( row < 0 || snapshotRemoved_.testBit(row) )
+        RETURN( nullptr );
 
-                // Iterate over all projects
-                bool foundProject = false;
-                for( const auto& j3 : obj.value("projects").toArray() )
-                {
-                    Item project;
-                    project.id = j3.toObject().value("id").toInt();
-                    project.name = j3.toObject().value("name").toString();
-                    customField.projects.push_back( project );
+    DEBUG( "Decoding issue from the snapshot" )(id)(row);
 
-                    if( project.id == filter.projectId )
-                        foundProject = true;
-                }
+    issueStore_->insert( snapshot_->issue(row, customFieldTable()) );
+    issue = issueStore_->find( id );
 
-                if( !customField.allProjects && filter.projectId != NULL_ID && !foundProject )
-                {
-                    DEBUG("Skipping custom field without project")(filter.projectId);
-                    continue;
-                }
+    RETURN( issue );
+}
 
-                // Iterate over all trackers
-                bool foundTracker = false;
-                for( const auto& j3 : obj.value("trackers").toArray() )
+void
+SimpleRedmineClient::setOfflineReads( bool enabled )
+{
+    ENTER()(enabled);
+
+    offlineReads_ = enabled;
+
+    RETURN();
+}
+
+bool
+SimpleRedmineClient::offlineReads() const
+{
+    return offlineReads_;
+}
+
+bool
+SimpleRedmineClient::isOffline() const
+{
+    return offlineReads_ && connected_ == QNetworkAccessManager::NotAccessible;
+}
+
+QString
+SimpleRedmineClient::queryKey( const RedmineOptions& options )
+{
+    return QString( "%1|%2" ).arg( options.parameters ).arg( options.getAllItems );
+}
+
+void
+SimpleRedmineClient::setQueryCacheCapacity( int capacity )
+{
+    ENTER()(capacity);
+
+    queryCacheCapacity_ = qMax( capacity, 0 );
+
+    evictQueries( queryCacheCapacity_ );
+
+    RETURN();
+}
+
+int
+SimpleRedmineClient::queryCacheCapacity() const
+{
+    return queryCacheCapacity_;
+}
+
+void
+SimpleRedmineClient::setQueryCacheTtl( int ttl )
+{
+    ENTER()(ttl);
+
+    queryCacheTtl_ = ttl;
+
+    RETURN();
+}
+
+int
+SimpleRedmineClient::queryCacheTtl() const
+{
+    return queryCacheTtl_;
+}
+
+bool
+SimpleRedmineClient::cachedIssues( const QString& key, Issues* issues, bool fresh )
+{
+    ENTER()(key)(fresh);
+
+    auto it = queryCache_.find( key );
+    if( !issueStore_ || it == queryCache_.end() )
+        RETURN( false );
+
+    if( fresh && it->loadedAt.hasExpired(queryCacheTtl_) )
+    {
+        DEBUG( "Query has expired" )(key);
+        RETURN( false );
+    }
+
+    it->lastUsed = ++queryClock_;
+    issues->reserve( it->ids.size() );
+
+    for( int id : it->ids )
+    {
+        const Issue* issue = storedIssue( id );
+        if( !issue )
+            RETURN( false );
+
+        issues->push_back( *issue );
+    }
+
+    RETURN( true );
+}
+
+void
+SimpleRedmineClient::evictQueries( int size )
+{
+    // The cache is small, so the least recently used query is simply searched
+    while( queryCache_.size() > size )
+    {
+        auto oldest = queryCache_.begin();
+
+        for( auto it = queryCache_.begin(); it != queryCache_.end(); ++it )
+        {
+            if( it->lastUsed < oldest->lastUsed )
+                oldest = it;
+        }
+
+        DEBUG( "Evicting query" )(oldest.key());
+        queryCache_.erase( oldest );
+    }
+}
+
+void
+SimpleRedmineClient::cacheQuery( const QString& key, const QVector<int>& ids )
+{
+    ENTER()(key)(ids.size());
+
+    if( queryCacheCapacity_ == 0 )
+        RETURN();
+
+    if( !queryCache_.contains(key) )
+        evictQueries( queryCacheCapacity_ - 1 );
+
+    CachedQuery& query = queryCache_[key];
+    query.ids      = ids;
+    query.lastUsed = ++queryClock_;
+    query.loadedAt.start();
+
+    RETURN();
+}
+
+void
+SimpleRedmineClient::sendIssue( Issue item, SuccessCb callback, int id, QString parameters )
+{
+    ENTER()(item)(id)(parameters);
+
+    auto apply = [item]( Issue& issue ){ mergeFields( issue, item ); };
+
+    sendIssueData( requestBody(item), callback, id, parameters, apply );
+
+    RETURN();
+}
+
+void
+SimpleRedmineClient::updateIssue( Issue item, Issue original, SuccessCb callback, QString parameters )
+{
+    ENTER()(item.id)(parameters);
+
+    if( item.id == NULL_ID )
+    {
+        DEBUG() << "No issue ID specified";
+        callback( false, NULL_ID, RedmineError::ERR_INCOMPLETE_DATA, QStringList() );
+        RETURN();
+    }
+
+    int changes = 0;
+    QByteArray data = patchBody( item, original, &changes );
+
+    // Nothing to update
+    if( !changes )
+    {
+        DEBUG() << "Issue unchanged";
+        callback( true, item.id, RedmineError::NO_ERR, QStringList() );
+        RETURN();
+    }
+
+    auto apply = [item, original]( Issue& issue ){ mergeFields( issue, item, original ); };
+
+    sendIssueData( data, callback, item.id, parameters, apply );
+
+    RETURN();
+}
+
+void
+SimpleRedmineClient::sendIssueData( QByteArray data, SuccessCb callback, int id, QString parameters,
+                                    std::function<void(Issue&)> apply )
+{
+    ENTER()(data)(id)(parameters);
+
+    QPointer<IssueStore> store( issueStore_ );
+    CustomFieldTable* table = customFieldTable();
+
+    auto cb = [=]( QNetworkReply* reply, QJsonDocument* json )
+    {
+        ENTER();
+
+        DEBUG()(json->toJson());
+
+        // Quit on network error
+        if( reply->error() != QNetworkReply::NoError )
+        {
+            DEBUG() << "Network error:" << reply->errorString();
+            callback( false, NULL_ID, writeError(reply), getErrorList(reply, json) );
+            RETURN();
+        }
+
+        // Updates do not return the issue
+        QJsonObject jsonIssue = json->object().value("issue").toObject();
+        int issueId = jsonIssue.isEmpty() ? id : jsonIssue.value("id").toInt();
+
+        // Write through to the issue store and the SQLite mirror, so that the issue does not have to
+        // be retrieved again; updates are only complete if the issue has been stored before
+        if( !jsonIssue.isEmpty() )
+        {
+            Issue issue;
+            readFields( issue, jsonIssue, 0, table );
+
+            if( store )
+                store->insert( issue );
+
+            writeThrough( Issues{issue} );
+        }
+        else if( store && apply && store->contains(issueId) )
+        {
+            Issue issue = *store->find( issueId );
+            apply( issue );
+            store->insert( issue );
+
+            writeThrough( Issues{issue} );
+        }
+
+        callback( true, issueId, RedmineError::NO_ERR, QStringList() );
+    };
+
+    RedmineClient::sendIssue( data, cb, id, parameters );
+
+    RETURN();
+}
+
+void
+SimpleRedmineClient::sendTimeEntry( TimeEntry item, SuccessCb callback, int id, QString parameters )
+{
+    ENTER()(id)(parameters);
+
+    if( item.hours < 0.01 )
+    {
+        DEBUG() << "Time entry has to be at least 0.1 hours (36 seconds)";
+        callback( false, NULL_ID, RedmineError::ERR_TIME_ENTRY_TOO_SHORT, QStringList() );
+        RETURN();
+    }
+
+    if( id == NULL_ID && item.issue.id == NULL_ID && item.project.id == NULL_ID )
+    {
+        DEBUG() << "No issue and no project specified";
+        callback( false, NULL_ID, RedmineError::ERR_INCOMPLETE_DATA, QStringList() );
+        RETURN();
+    }
+
+    sendTimeEntryData( requestBody(item), callback, id, parameters, item );
+
+    RETURN();
+}
+
+void
+SimpleRedmineClient::sendTimeEntryData( QByteArray data, SuccessCb callback, int id, QString parameters,
+                                        TimeEntry written )
+{
+    ENTER()(data)(id)(parameters);
+
+    CustomFieldTable* table = customFieldTable();
+
+    auto cb = [=]( QNetworkReply* reply, QJsonDocument* json )
+    {
+        ENTER();
+
+        // Quit on network error
+        if( reply->error() != QNetworkReply::NoError )
+        {
+            DEBUG() << "Network error:" << reply->errorString();
+            callback( false, NULL_ID, writeError(reply), getErrorList(reply, json) );
+            RETURN();
+        }
+
+        // Updates do not return the time entry
+        QJsonObject jsonTimeEntry = json->object().value("time_entry").toObject();
+
+        TimeEntry timeEntry = written;
+        if( jsonTimeEntry.isEmpty() )
+            timeEntry.id = id;
+        else
+        {
+            timeEntry = TimeEntry();
+            readFields( timeEntry, jsonTimeEntry, 0, table );
+
+            // Only a returned time entry is complete; the written one lacks e.g. the user
+            writeThrough( TimeEntries{timeEntry} );
+        }
+
+        callback( true, timeEntry.id, RedmineError::NO_ERR, QStringList() );
+
+        DEBUG( "Emitting signal timeEntrySaved()" )(timeEntry.id);
+        emit timeEntrySaved( timeEntry );
+
+        RETURN();
+    };
+
+    RedmineClient::sendTimeEntry( data, cb, id, parameters );
+
+    RETURN();
+}
+
+void
+SimpleRedmineClient::bootstrap( BootstrapCb callback, RedmineOptions projectOptions )
+{
+    ENTER()(projectOptions);
+
+    struct Data
+    {
+        Bootstrap     result;
+        int           pending = 6;
+        RedmineError  error = RedmineError::NO_ERR;
+        QStringList   errors;
+        QElapsedTimer timer;
+        BootstrapCb   callback;
+    };
+
+    Data* data = new Data();
+    data->callback = callback;
+    data->timer.start();
+
+    // Called once per reply; the last reply delivers the snapshot
+    auto done = [data]( const char* name, RedmineError redmineError, QStringList errors )
+    {
+        ENTER()(name)(redmineError);
+
+        // The reply arriving last determines the critical path
+        data->result.latency = data->timer.elapsed();
+        data->result.slowest = QString::fromLatin1( name );
+
+        // Report the first error only
+        if( redmineError != RedmineError::NO_ERR && data->error == RedmineError::NO_ERR )
+        {
+            data->error  = redmineError;
+            data->errors = errors;
+        }
+
+        if( --data->pending > 0 )
+            RETURN();
+
+        DEBUG()(data->result.latency)(data->result.slowest);
+
+        data->callback( data->result, data->error, data->errors );
+        delete data;
+
+        RETURN();
+    };
+
+    retrieveCurrentUser( [data, done]( User user, RedmineError redmineError, QStringList errors )
+    {
+        data->result.currentUser = user;
+        done( "currentUser", redmineError, errors );
+    } );
+
+    retrieveProjects( [data, done]( Projects projects, RedmineError redmineError, QStringList errors )
+    {
+        data->result.projects = projects;
+        done( "projects", redmineError, errors );
+    }, projectOptions );
+
+    MetadataCache* cache = metadataCache();
+
+    cache->trackers( [data, done]( Trackers trackers, RedmineError redmineError, QStringList errors )
+    {
+        data->result.trackers = trackers;
+        done( "trackers", redmineError, errors );
+    } );
+
+    cache->issueStatuses( [data, done]( IssueStatuses issueStatuses, RedmineError redmineError,
+                                        QStringList errors )
+    {
+        data->result.issueStatuses = issueStatuses;
+        done( "issueStatuses", redmineError, errors );
+    } );
+
+    cache->issuePriorities( [data, done]( Enumerations issuePriorities, RedmineError redmineError,
+                                          QStringList errors )
+    {
+        data->result.issuePriorities = issuePriorities;
+        done( "issuePriorities", redmineError, errors );
+    } );
+
+    cache->timeEntryActivities( [data, done]( Enumerations timeEntryActivities, RedmineError redmineError,
+                                              QStringList errors )
+    {
+        data->result.timeEntryActivities = timeEntryActivities;
+        done( "timeEntryActivities", redmineError, errors );
+    } );
+
+    RETURN();
+}
+
+void
+SimpleRedmineClient::retrieveCustomFields( CustomFieldsCb callback, CustomFieldFilter filter )
+{
+    ENTER();
+
+    if( failOffline(callback) )
+        RETURN();
+
+    CustomFieldTable* table = customFieldTable();
+
+    auto cb = [=]( QNetworkReply* reply, QJsonDocument* json )
+    {
+        ENTER();
+
+        // Quit on network error
+        if( reply->error() != QNetworkReply::NoError )
+        {
+            DEBUG() << "Network error:" << reply->errorString();
+            callback( CustomFields(), RedmineError::ERR_NETWORK, getErrorList(reply, json) );
+            RETURN();
+        }
+
+        CustomFields customFields;
+
+        // Iterate over the document
+        for( const auto& j1 : json->object() )
+        {
+            // Iterate over all customFields
+            for( const auto& j2 : j1.toArray() )
+            {
+                QJsonObject obj = j2.toObject();
+
+                CustomField customField;
+                readFields( customField, obj );
+
+                if( !filter.type.isEmpty() && filter.type != customField.type )
+                {
+                    DEBUG("Skipping custom field without type")(filter.type);
+                    continue;
+                }
+
+                if( !filter.format.isEmpty() && filter.format != customField.format )
+                {
+                    DEBUG("Skipping custom field without format")(filter.format);
+                    continue;
+                }
+
+                bool foundProject = false;
+                for( const auto& project : customField.projects )
+                    if( project.id == filter.projectId )
+                        foundProject = true;
+
+                if( !customField.allProjects && filter.projectId != NULL_ID && !foundProject )
                 {
-                    Item tracker;
-                    tracker.id = j3.toObject().value("id").toInt();
-                    tracker.name = j3.toObject().value("name").toString();
-                    customField.trackers.push_back( tracker );
+                    DEBUG("Skipping custom field without project")(filter.projectId);
+                    continue;
+                }
 
+                bool foundTracker = false;
+                for( const auto& tracker : customField.trackers )
                     if( tracker.id == filter.trackerId )
                         foundTracker = true;
-                }
 
                 if( filter.trackerId != NULL_ID && !foundTracker )
                 {
@@ -489,6 +1189,9 @@ SimpleRedmineClient::retrieveCustomFields( CustomFieldsCb callback, CustomFieldF
                     continue;
                 }
 
+                // Complete the shared definition
+                table->insert( customField );
+
                 customFields.push_back( customField );
             }
         }
@@ -508,6 +1211,9 @@ SimpleRedmineClient::retrieveEnumerations(QString enumeration, EnumerationsCb ca
 {
     ENTER()(enumeration)(parameters);
 
+    if( failOffline(callback) )
+        RETURN();
+
     auto cb = [=]( QNetworkReply* reply, QJsonDocument* json )
     {
         ENTER();
@@ -531,13 +1237,7 @@ SimpleRedmineClient::retrieveEnumerations(QString enumeration, EnumerationsCb ca
                 QJsonObject obj = j2.toObject();
 
                 Enumeration enumeration;
-
-                // Simple fields
-                enumeration.id        = obj.value("id").toInt();
-                enumeration.name      = obj.value("name").toString();
-                enumeration.isDefault = obj.value("is_default").toBool();
-
-                fillDefaultFields( enumeration, &obj );
+                readFields( enumeration, obj );
 
                 enumerations.push_back( enumeration );
             }
@@ -554,160 +1254,278 @@ SimpleRedmineClient::retrieveEnumerations(QString enumeration, EnumerationsCb ca
 }
 
 void
-parseIssue( Issue& issue, QJsonObject* obj )
+SimpleRedmineClient::retrieveIssue( IssueCb callback, int issueId, QString parameters )
 {
-    ENTER();
-
-    // Simple fields
-    issue.id          = obj->value("id").toInt();
-    issue.description = obj->value("description").toString();
-    issue.doneRatio   = obj->value("done_ratio").toInt();
-    issue.subject     = obj->value("subject").toString();
-
-    QJsonObject parent = obj->value("parent").toObject();
-    if( !parent.isEmpty() )
-        issue.parentId = parent.value("id").toInt();
-
-    fillItem( issue.assignedTo, obj, "assigned_to" );
-    fillItem( issue.author,     obj, "author" );
-    fillItem( issue.category,   obj, "category" );
-    fillItem( issue.priority,   obj, "priority" );
-    fillItem( issue.project,    obj, "project" );
-    fillItem( issue.status,     obj, "status" );
-    fillItem( issue.tracker,    obj, "tracker" );
-    fillItem( issue.version,    obj, "fixed_version" );
-
-    // Dates and times
-    issue.dueDate        = obj->value("due_date").toVariant().toDate();
-    issue.estimatedHours = obj->value("estimated_hours").toDouble();
-    issue.startDate      = obj->value("start_date").toVariant().toDate();
-
-    // Custom field
-    auto addCustomField = [&](QJsonObject cfObj)
-    {
-        CustomField customField;
-        customField.id   = cfObj.value("id").toInt();
-        customField.name = cfObj.value("name").toString();
-
-        if( cfObj.value("value").isString() )
-            customField.values.push_back( cfObj.value("value").toString() );
-        else if( cfObj.value("value").isArray() )
-            for( const auto& v : cfObj.value("value").toArray() )
-                customField.values.push_back( v.toString() );
-
-        customField.multiple = cfObj.value("multiple").toBool();
-        customField.type     = "issue";
-
-        issue.customFields.push_back( customField );
-    };
-
-    for( const auto& cf : obj->value("custom_fields").toArray() )
-        addCustomField( cf.toObject() );
+    ENTER()(issueId)(parameters);
 
-    fillDefaultFields( issue, obj );
+    retrieveIssue( callback, issueId, RedmineOptions(parameters) );
 
     RETURN();
-  }
+}
 
 void
-SimpleRedmineClient::retrieveIssue( IssueCb callback, int issueId, QString parameters )
+SimpleRedmineClient::retrieveIssue( IssueCb callback, int issueId, RedmineOptions options )
 {
-    ENTER()(issueId)(parameters);
+    ENTER()(issueId)(options);
+
+    QPointer<IssueStore> store( issueStore_ );
+
+    // Partially decoded issues must neither be stored nor compared with stored ones
+    bool full = options.profile == ParseProfile::FULL;
+
+    // Issues of a loaded snapshot are decoded here
+    const Issue* stored = full ? storedIssue( issueId ) : nullptr;
+
+    // Do not wait for a timeout while Redmine is not accessible
+    if( isOffline() )
+    {
+        if( stored )
+            callback( *stored, RedmineError::NO_ERR_CACHED, QStringList() );
+        else
+            callback( Issue(), RedmineError::ERR_NETWORK, QStringList() << "Redmine is not accessible" );
+
+        RETURN();
+    }
+
+    // Answer from the store first, if allowed and retrieved recently, like a cached query
+    bool answered = false;
+    auto loadedAt = issueLoadedAt_.constFind( issueId );
+    bool fresh = loadedAt != issueLoadedAt_.constEnd() && !loadedAt->hasExpired( queryCacheTtl_ );
+
+    if( stored && fresh && options.cachePolicy == CachePolicy::STALE_WHILE_REVALIDATE )
+    {
+        DEBUG() << "Answering from the issue store";
+        callback( *stored, RedmineError::NO_ERR, QStringList() );
+        answered = true;
+    }
+
+    quint64 skip = skippedFields<Issue>( options );
+    CustomFieldTable* table = customFieldTable();
 
     auto cb = [=]( QNetworkReply* reply, QJsonDocument* json )
     {
         ENTER();
 
-        // Quit on network error
+        // Quit on network error; a cached answer stays valid
         if( reply->error() != QNetworkReply::NoError )
         {
             DEBUG() << "Network error:" << reply->errorString();
-            callback( Issue(), RedmineError::ERR_NETWORK, getErrorList(reply, json) );
+
+            if( !answered )
+                callback( Issue(), RedmineError::ERR_NETWORK, getErrorList(reply, json) );
+
+            RETURN();
+        }
+
+        Issue issue;
+        readFields( issue, json->object().value("issue").toObject(), skip, table );
+
+        bool changed = true;
+
+        if( store && full )
+        {
+            changed = store->insert( issue );
+            issueLoadedAt_[issueId].start();
+        }
+
+        // Only call back again if the cached answer was outdated
+        if( !answered || changed )
+            callback( issue, RedmineError::NO_ERR, QStringList() );
+
+        RETURN();
+    };
+
+    RedmineClient::retrieveIssue( cb, issueId, options.parameters );
+
+    RETURN();
+}
+
+void
+SimpleRedmineClient::retrieveIssues( IssuesCb callback, RedmineOptions options )
+{
+    ENTER()(options);
+
+    auto fetch = [this]( JsonCb cb, QString parameters )
+    {
+        RedmineClient::retrieveIssues( cb, parameters );
+    };
+
+    // Partially decoded issues must neither be stored nor compared with stored ones
+    if( !issueStore_ || options.profile != ParseProfile::FULL )
+    {
+        if( isOffline() )
+            callback( Issues(), RedmineError::ERR_NETWORK, QStringList() << "Redmine is not accessible" );
+        else
+            retrieveCollection<Issue>( "issues", fetch, mirrored<Issue>(callback, options), options );
+
+        RETURN();
+    }
+
+    QPointer<IssueStore> store( issueStore_ );
+    QString key = queryKey( options );
+
+    // Queries that have been run before can be answered from the store
+    Issues cached;
+
+    // Do not wait for a timeout while Redmine is not accessible; expired queries are better than none
+    if( isOffline() )
+    {
+        if( cachedIssues(key, &cached, false) )
+            callback( cached, RedmineError::NO_ERR_CACHED, QStringList() );
+        else
+            callback( Issues(), RedmineError::ERR_NETWORK, QStringList() << "Redmine is not accessible" );
+
+        RETURN();
+    }
+
+    bool answered = false;
+
+    if( options.cachePolicy == CachePolicy::STALE_WHILE_REVALIDATE && cachedIssues(key, &cached, true) )
+    {
+        DEBUG() << "Answering from the issue store";
+        callback( cached, RedmineError::NO_ERR, QStringList() );
+        answered = true;
+    }
+
+    QVector<int> cachedIds = queryCache_.value( key ).ids;
+
+    auto cb = [=]( Issues issues, RedmineError redmineError, QStringList errors )
+    {
+        ENTER()(issues.size())(redmineError);
+
+        // A cached answer stays valid on errors
+        if( redmineError != RedmineError::NO_ERR )
+        {
+            if( !answered )
+                callback( issues, redmineError, errors );
+
             RETURN();
         }
 
-        Issue issue;
-        QJsonObject obj = json->object().value("issue").toObject();
-        parseIssue( issue, &obj );
-        callback( issue, RedmineError::NO_ERR, QStringList() );
+        // Remember the query, so that it can be answered from the store later
+        QVector<int> ids;
+        ids.reserve( issues.size() );
+
+        for( const auto& issue : issues )
+        {
+            ids.push_back( issue.id );
+            issueLoadedAt_[issue.id].start();
+        }
+
+        cacheQuery( key, ids );
+
+        int changed = store ? store->insert( issues ) : issues.size();
+
+        // Only call back again if the cached answer was outdated
+        if( !answered || changed || ids != cachedIds )
+            callback( issues, RedmineError::NO_ERR, QStringList() );
+
+        RETURN();
+    };
+
+    retrieveCollection<Issue>( "issues", fetch, mirrored<Issue>(cb, options), options );
+
+    RETURN();
+}
+
+void
+SimpleRedmineClient::retrieveIssueViews( IssueViewsCb callback, RedmineOptions options )
+{
+    ENTER()(options);
+
+    auto fetch = [this]( RawCb cb, QString parameters )
+    {
+        RedmineClient::retrieveRawIssues( cb, parameters );
+    };
+
+    QVector<IssueViews>* pages = new QVector<IssueViews>();
+
+    // Only locate the issue records, do not decode them
+    auto decode = [pages]( int page, QByteArray* raw, int* total ) -> int
+    {
+        if( page >= pages->size() )
+            pages->resize( page + 1 );
+
+        (*pages)[page] = IssueView::fromPage( *raw, total );
+
+        return pages->at( page ).size();
+    };
+
+    auto done = [pages, callback]( RedmineError redmineError, QStringList errors )
+    {
+        IssueViews views;
+
+        if( redmineError == RedmineError::NO_ERR )
+        {
+            int size = 0;
+            for( const auto& page : *pages )
+                size += page.size();
+
+            views.reserve( size );
 
-        RETURN();
+            for( const auto& page : *pages )
+                views += page;
+        }
+
+        callback( views, redmineError, errors );
+        delete pages;
     };
 
-    RedmineClient::retrieveIssue( cb, issueId, parameters );
+    retrievePages<QByteArray>( fetch, decode, done, options, pageWindow_ );
 
     RETURN();
 }
 
 void
-SimpleRedmineClient::retrieveIssues( IssuesCb callback, RedmineOptions options )
+SimpleRedmineClient::retrieveIssueTable( IssueTableCb callback, RedmineOptions options )
 {
     ENTER()(options);
 
-    struct Data
+    auto fetch = [this]( JsonCb cb, QString parameters )
     {
-        Issues issues;
-        int offset = 0;
-        JsonCb jsonCb;
+        RedmineClient::retrieveIssues( cb, parameters );
     };
 
-    Data* data = new Data();
+    // Pages may arrive out of order, so the rows are appended once all pages are there
+    QVector<QJsonArray>* pages = new QVector<QJsonArray>();
 
-    data->jsonCb = [=]( QNetworkReply* reply, QJsonDocument* json )
+    auto decode = [pages]( int page, QJsonDocument* json, int* total ) -> int
     {
-        ENTER()(json->toJson());
+        QJsonObject obj = json->object();
+        *total = obj.value( QLatin1String("total_count") ).toInt( -1 );
 
-        Issues& issues = data->issues;
-        int&    offset = data->offset;
-        JsonCb& cb     = data->jsonCb;
+        if( page >= pages->size() )
+            pages->resize( page + 1 );
 
-        // Quit on network error
-        if( reply->error() != QNetworkReply::NoError )
-        {
-            DEBUG() << "Network error:" << reply->errorString();
-            callback( Issues(), RedmineError::ERR_NETWORK, getErrorList(reply, json) );
-            RETURN();
-        }
+        (*pages)[page] = obj.value( QLatin1String("issues") ).toArray();
+
+        return pages->at( page ).size();
+    };
 
-        int count = 0;
+    auto done = [pages, callback]( RedmineError redmineError, QStringList errors )
+    {
+        IssueTable table;
 
-        // Iterate over the document
-        for( const auto& j1 : json->object() )
+        if( redmineError == RedmineError::NO_ERR )
         {
-            // Iterate over all issues
-            for( const auto& j2 : j1.toArray() )
+            int size = 0;
+            for( const auto& page : *pages )
+                size += page.size();
+
+            table.reserve( size );
+
+            for( const auto& page : *pages )
             {
-                Issue issue;
-                QJsonObject obj = j2.toObject();
-                parseIssue( issue, &obj );
-                issues.push_back( issue );
-                ++count;
-                ++offset;
+                for( const auto& issue : page )
+                    table.append( issue.toObject() );
             }
         }
 
-        if( options.getAllItems && count == limit_ )
-        {
-            // In the last run, as many issues as the limit is were found - so there might be more
-            RedmineClient::retrieveIssues(
-                        cb,
-                        QString("%1&offset=%2&limit=%3")
-                            .arg(options.parameters)
-                            .arg(offset)
-                            .arg(limit_) );
-        }
-        else
-        {
-            // No more issues to fetch
-            callback( issues, RedmineError::NO_ERR, QStringList() );
-            delete data;
-        }
-
-        RETURN();
+        callback( table, redmineError, errors );
+        delete pages;
     };
 
-    RedmineClient::retrieveIssues( data->jsonCb,
-                                   QString("%1&offset=%2&limit=%3").arg(options.parameters).arg(0).arg(limit_) );
+    retrievePages<QJsonDocument>( fetch, decode, done, options, pageWindow_ );
 
     RETURN();
 }
@@ -717,6 +1535,9 @@ SimpleRedmineClient::retrieveIssueCategories( IssueCategoriesCb callback, int pr
 {
     ENTER()(projectId)(parameters);
 
+    if( failOffline(callback) )
+        RETURN();
+
     auto cb = [=]( QNetworkReply* reply, QJsonDocument* json )
     {
         ENTER();
@@ -740,13 +1561,7 @@ SimpleRedmineClient::retrieveIssueCategories( IssueCategoriesCb callback, int pr
                 QJsonObject obj = j2.toObject();
 
                 IssueCategory issueCategory;
-
-                // Simple fields
-                issueCategory.id   = obj.value("id").toInt();
-                issueCategory.name = obj.value("name").toString();
-
-                fillItem( issueCategory.project, &obj, "project" );
-                fillItem( issueCategory.assignedTo, &obj, "assigned_to" );
+                readFields( issueCategory, obj );
 
                 issueCategories.push_back( issueCategory );
             }
@@ -777,6 +1592,21 @@ SimpleRedmineClient::retrieveIssueStatuses( IssueStatusesCb callback, QString pa
 {
     ENTER()(parameters);
 
+    // Without Redmine, answer from the metadata cache
+    if( isOffline() && metadataCache_ && parameters.isEmpty() )
+    {
+        IssueStatuses issueStatuses = metadataCache_->snapshot().issueStatuses;
+
+        if( !issueStatuses.isEmpty() )
+        {
+            callback( issueStatuses, RedmineError::NO_ERR_CACHED, QStringList() );
+            RETURN();
+        }
+    }
+
+    if( failOffline(callback) )
+        RETURN();
+
     auto cb = [=]( QNetworkReply* reply, QJsonDocument* json )
     {
         ENTER();
@@ -800,13 +1630,7 @@ SimpleRedmineClient::retrieveIssueStatuses( IssueStatusesCb callback, QString pa
                 QJsonObject obj = j2.toObject();
 
                 IssueStatus issueStatus;
-
-                // Simple fields
-                issueStatus.id        = obj.value("id").toInt();
-                issueStatus.name      = obj.value("name").toString();
-                issueStatus.isDefault = obj.value("is_default").toBool();
-
-                fillDefaultFields( issueStatus, &obj );
+                readFields( issueStatus, obj );
 
                 issueStatuses.push_back( issueStatus );
             }
@@ -827,95 +1651,41 @@ SimpleRedmineClient::retrieveMemberships( MembershipsCb callback, int projectId,
 {
     ENTER()(projectId)(parameters);
 
-    auto cb = [=]( QNetworkReply* reply, QJsonDocument* json )
-    {
-        ENTER();
-
-        // Quit on network error
-        if( reply->error() != QNetworkReply::NoError )
-        {
-            DEBUG() << "Network error:" << reply->errorString();
-            callback( Memberships(), RedmineError::ERR_NETWORK, getErrorList(reply, json) );
-            RETURN();
-        }
-
-        Memberships memberships;
-
-        // Iterate over the document
-        for( const auto& j1 : json->object() )
-        {
-            // Iterate over all issueStatuss
-            for( const auto& j2 : j1.toArray() )
-            {
-                QJsonObject obj = j2.toObject();
-
-                Membership membership;
-
-                // Simple fields
-                membership.id = obj.value("id").toInt();
-
-                fillItem( membership.project, &obj, "project" );
-                fillItem( membership.user, &obj, "user" );
-                fillItem( membership.group, &obj, "group" );
-
-                memberships.push_back( membership );
-            }
-        }
-
-        callback( memberships, RedmineError::NO_ERR, QStringList() );
-
-        RETURN();
-    };
-
-    RedmineClient::retrieveMemberships( cb, projectId, parameters );
+    retrieveMemberships( callback, projectId, RedmineOptions(parameters, true) );
 
     RETURN();
 }
 
 void
-parseProject( Project& project, QJsonObject* obj )
+SimpleRedmineClient::retrieveMemberships( MembershipsCb callback, int projectId, RedmineOptions options )
 {
-    ENTER();
-
-    // Simple fields
-    project.id          = obj->value("id").toInt();
-    project.description = obj->value("description").toString();
-    project.identifier  = obj->value("identifier").toString();
-    project.isPublic    = obj->value("is_public").toBool();
-    project.name        = obj->value("name").toString();
+    ENTER()(projectId)(options);
 
-    fillItem( project.parent, obj, "parent" );
-
-    // Iterate over all issue categories
-    for( const auto& j3 : obj->value("issue_categories").toArray() )
-    {
-        Item category;
-        category.id = j3.toObject().value("id").toInt();
-        category.name = j3.toObject().value("name").toString();
-
-        project.categories.push_back( category );
-    }
-
-    // Iterate over all trackers
-    for( const auto& j3 : obj->value("trackers").toArray() )
+    auto fetch = [this, projectId]( JsonCb cb, QString parameters )
     {
-        Item tracker;
-        tracker.id = j3.toObject().value("id").toInt();
-        tracker.name = j3.toObject().value("name").toString();
-
-        project.trackers.push_back( tracker );
-    }
+        RedmineClient::retrieveMemberships( cb, projectId, parameters );
+    };
 
-    fillDefaultFields( project, obj );
+    retrieveCollection<Membership>( "memberships", fetch, callback, options );
 
     RETURN();
-  }
+}
 
 void
 SimpleRedmineClient::retrieveProject( ProjectCb callback, int projectId, QString parameters )
 {
     ENTER()(projectId)(parameters);
 
+    // Without Redmine, answer from the project tree
+    if( isOffline() && projectTree_ && parameters.isEmpty() && projectTree_->find(projectId) )
+    {
+        callback( *projectTree_->find(projectId), RedmineError::NO_ERR_CACHED, QStringList() );
+        RETURN();
+    }
+
+    if( failOffline(callback) )
+        RETURN();
+
     auto cb = [=]( QNetworkReply* reply, QJsonDocument* json )
     {
         ENTER();
@@ -929,8 +1699,7 @@ SimpleRedmineClient::retrieveProject( ProjectCb callback, int projectId, QString
         }
 
         Project project;
-        QJsonObject obj = json->object().value("project").toObject();
-        parseProject( project, &obj );
+        readFields( project, json->object().value("project").toObject() );
         callback( project, RedmineError::NO_ERR, QStringList() );
 
         RETURN();
@@ -946,95 +1715,226 @@ SimpleRedmineClient::retrieveProjects( ProjectsCb callback, QString parameters )
 {
     ENTER()(parameters);
 
-    auto cb = [=]( QNetworkReply* reply, QJsonDocument* json )
-    {
-        ENTER();
+    retrieveProjects( callback, RedmineOptions(parameters, true) );
 
-        // Quit on network error
-        if( reply->error() != QNetworkReply::NoError )
-        {
-            DEBUG() << "Network error:" << reply->errorString();
-            callback( Projects(), RedmineError::ERR_NETWORK, getErrorList(reply, json) );
-            RETURN();
-        }
+    RETURN();
+}
+
+void
+SimpleRedmineClient::retrieveProjects( ProjectsCb callback, RedmineOptions options )
+{
+    ENTER()(options);
 
+    // Without Redmine, answer from the project tree, in hierarchy order
+    if( isOffline() && projectTree_ && projectTree_->size() && options.parameters.isEmpty() )
+    {
         Projects projects;
+        projects.reserve( projectTree_->size() );
 
-        // Iterate over the document
-        for( const auto& j1 : json->object() )
+        for( int root : projectTree_->roots() )
         {
-            // Iterate over all projects
-            for( const auto& j2 : j1.toArray() )
-            {
-                Project project;
-                QJsonObject obj = j2.toObject();
-                parseProject( project, &obj );
-                projects.push_back( project );
-            }
-        }
+            projects.push_back( *projectTree_->find(root) );
 
-        callback( projects, RedmineError::NO_ERR, QStringList() );
+            for( int id : projectTree_->descendants(root) )
+                projects.push_back( *projectTree_->find(id) );
+        }
 
+        callback( projects, RedmineError::NO_ERR_CACHED, QStringList() );
         RETURN();
+    }
+
+    auto fetch = [this]( JsonCb cb, QString parameters )
+    {
+        RedmineClient::retrieveProjects( cb, parameters );
     };
 
-    RedmineClient::retrieveProjects( cb, parameters );
+    ProjectsCb cb = mirrored<Project>( callback, options );
+
+    // The hierarchy needs the name and the parent; projects decoded without them would lose their position
+    quint64 hierarchyFields = fieldMask<Project>( QStringList() << "name" << "parent" );
+
+    if( projectTree_ && !(skippedFields<Project>(options) & hierarchyFields) )
+    {
+        QPointer<ProjectTree> tree( projectTree_ );
+
+        cb = [tree, cb]( Projects projects, RedmineError redmineError, QStringList errors )
+        {
+            if( tree && redmineError == RedmineError::NO_ERR )
+                tree->insert( projects );
+
+            cb( projects, redmineError, errors );
+        };
+    }
+
+    retrieveCollection<Project>( "projects", fetch, cb, options );
 
     RETURN();
 }
 
 void
-SimpleRedmineClient::retrieveTimeEntries( TimeEntriesCb callback, QString parameters )
+SimpleRedmineClient::syncIssues( SyncCb callback, QString parameters )
 {
     ENTER()(parameters);
 
-    auto cb = [=]( QNetworkReply* reply, QJsonDocument* json )
+    if( !issueStore_ )
     {
-        ENTER();
+        callback( SyncStatistics(), RedmineError::ERR_INCOMPLETE_DATA,
+                  QStringList() << "No issue store has been set" );
+        RETURN();
+    }
 
-        // Quit on network error
-        if( reply->error() != QNetworkReply::NoError )
+    QElapsedTimer timer;
+    timer.start();
+
+    Timestamp cursor = syncCursors_.value( parameters );
+
+    // Include closed issues, since closing an issue is a change as well, unless the caller filters
+    // the status; the ID breaks ties between issues updated within the same second
+    QString query = parameters;
+
+    if( !QUrlQuery(parameters).hasQueryItem("status_id") )
+        query += "&status_id=*";
+
+    query += "&sort=updated_on,id";
+
+    // Only fetch issues updated since the last synchronisation; the comparison is inclusive, so
+    // issues updated within the same second as the cursor are not missed
+    if( cursor.isValid() )
+        query += "&updated_on=%3E%3D" + cursor.toDateTime().toString( Qt::ISODate );
+
+    QPointer<IssueStore> store( issueStore_ );
+
+    struct Data
+    {
+        Issues issues;
+        int total = -1;
+    };
+
+    Data* data = new Data();
+
+    auto cb = [=]( Issues issues, RedmineError redmineError, QStringList errors )
+    {
+        ENTER()(issues.size())(redmineError);
+
+        SyncStatistics statistics;
+        statistics.full   = !cursor.isValid();
+        statistics.cursor = cursor;
+
+        if( redmineError != RedmineError::NO_ERR || !store )
         {
-            DEBUG() << "Network error:" << reply->errorString();
-            callback( TimeEntries(), RedmineError::ERR_NETWORK, getErrorList(reply, json) );
+            statistics.duration = timer.elapsed();
+            callback( statistics, redmineError, errors );
             RETURN();
         }
 
-        TimeEntries timeEntries;
+        // An issue updated during the synchronisation moves to the last page, so that the issues
+        // after its old position shift and one of them may be skipped. The issue then shows up
+        // twice; the cursor is only advanced if the distinct issues match the total count.
+        QSet<int> ids;
+        Timestamp latest = cursor;
 
-        // Iterate over the document
-        for( const auto& j1 : json->object() )
+        for( const auto& issue : issues )
         {
-            // Iterate over all trackers
-            for( const auto& j2 : j1.toArray() )
-            {
-                QJsonObject obj = j2.toObject();
+            ids.insert( issue.id );
+
+            if( issue.updatedOn > latest )
+                latest = issue.updatedOn;
+        }
+
+        statistics.complete = data->total < 0 || ids.size() >= data->total;
 
-                TimeEntry timeEntry;
+        if( statistics.complete )
+            statistics.cursor = latest;
 
-                // Simple fields
-                timeEntry.comment    = obj.value("comments").toString();
-                timeEntry.hours      = obj.value("hours").toDouble();
+        // Decode fetched issues from a loaded snapshot first, so that unchanged ones are not counted
+        if( snapshot_ && store == issueStore_ )
+        {
+            for( const auto& issue : issues )
+                storedIssue( issue.id );
+        }
 
-                // Dates and times
-                timeEntry.spentOn    = obj.value("spent_on").toVariant().toDate();
+        statistics.fetched  = issues.size();
+        statistics.changed  = store->insert( issues );
+        statistics.duration = timer.elapsed();
 
-                fillItem( timeEntry.activity, &obj, "activity" );
-                fillItem( timeEntry.issue,    &obj, "issue" );
-                fillItem( timeEntry.project,  &obj, "project" );
+        if( statistics.cursor.isValid() )
+            syncCursors_.insert( parameters, statistics.cursor );
 
-                fillDefaultFields( timeEntry, &obj );
+        DEBUG()(statistics.fetched)(statistics.changed)(statistics.complete)(statistics.cursor);
 
-                timeEntries.push_back( timeEntry );
-            }
-        }
+        callback( statistics, RedmineError::NO_ERR, QStringList() );
 
-        callback( timeEntries, RedmineError::NO_ERR, QStringList() );
+        DEBUG( "Emitting signal issuesSynchronised()" );
+        emit issuesSynchronised( statistics );
 
         RETURN();
     };
 
-    RedmineClient::retrieveTimeEntries( cb, parameters );
+    auto fetch = [this]( JsonCb cb, QString parameters )
+    {
+        RedmineClient::retrieveIssues( cb, parameters );
+    };
+
+    CustomFieldTable* table = customFieldTable();
+
+    auto decode = [data, table]( int page, QJsonDocument* json, int* total ) -> int
+    {
+        QJsonObject obj   = json->object();
+        QJsonArray  array = obj.value( QLatin1String("issues") ).toArray();
+        const int   count = array.size();
+
+        *total = obj.value( QLatin1String("total_count") ).toInt( -1 );
+
+        if( page == 0 )
+            data->total = *total;
+
+        // Pages are requested one by one, so they arrive in order
+        const int offset = data->issues.size();
+        data->issues.resize( offset + count );
+
+        for( int i = 0; i < count; ++i )
+            readFields( data->issues[offset + i], array.at(i).toObject(), 0, table );
+
+        return count;
+    };
+
+    // Insert the issues here rather than in retrieveIssues(), so that the changed issues are counted
+    RedmineOptions syncOptions( query, true );
+    IssuesCb issuesCb = mirrored<Issue>( cb, syncOptions );
+
+    auto done = [data, issuesCb]( RedmineError redmineError, QStringList errors )
+    {
+        issuesCb( redmineError == RedmineError::NO_ERR ? data->issues : Issues(), redmineError, errors );
+        delete data;
+    };
+
+    // Offsets are only stable while the order does not change, so the pages are requested serially
+    retrievePages<QJsonDocument>( fetch, decode, done, syncOptions, 1 );
+
+    RETURN();
+}
+
+void
+SimpleRedmineClient::retrieveTimeEntries( TimeEntriesCb callback, QString parameters )
+{
+    ENTER()(parameters);
+
+    retrieveTimeEntries( callback, RedmineOptions(parameters, true) );
+
+    RETURN();
+}
+
+void
+SimpleRedmineClient::retrieveTimeEntries( TimeEntriesCb callback, RedmineOptions options )
+{
+    ENTER()(options);
+
+    auto fetch = [this]( JsonCb cb, QString parameters )
+    {
+        RedmineClient::retrieveTimeEntries( cb, parameters );
+    };
+
+    retrieveCollection<TimeEntry>( "time_entries", fetch, mirrored<TimeEntry>(callback, options), options );
 
     RETURN();
 }
@@ -1054,6 +1954,21 @@ SimpleRedmineClient::retrieveTrackers( TrackersCb callback, QString parameters )
 {
     ENTER()(parameters);
 
+    // Without Redmine, answer from the metadata cache
+    if( isOffline() && metadataCache_ && parameters.isEmpty() )
+    {
+        Trackers trackers = metadataCache_->snapshot().trackers;
+
+        if( !trackers.isEmpty() )
+        {
+            callback( trackers, RedmineError::NO_ERR_CACHED, QStringList() );
+            RETURN();
+        }
+    }
+
+    if( failOffline(callback) )
+        RETURN();
+
     auto cb = [=]( QNetworkReply* reply, QJsonDocument* json )
     {
         ENTER();
@@ -1077,12 +1992,7 @@ SimpleRedmineClient::retrieveTrackers( TrackersCb callback, QString parameters )
                 QJsonObject obj = j2.toObject();
 
                 Tracker tracker;
-
-                // Simple fields
-                tracker.id   = obj.value("id").toInt();
-                tracker.name = obj.value("name").toString();
-
-                fillDefaultFields( tracker, &obj );
+                readFields( tracker, obj );
 
                 trackers.push_back( tracker );
             }
@@ -1098,31 +2008,14 @@ SimpleRedmineClient::retrieveTrackers( TrackersCb callback, QString parameters )
     RETURN();
 }
 
-void
-parseUser( User& user, QJsonObject* obj )
-{
-  ENTER();
-
-  // Simple fields
-  user.id   = obj->value("id").toInt();
-
-  user.login     = obj->value("login").toString();
-  user.firstname = obj->value("firstname").toString();
-  user.lastname  = obj->value("lastname").toString();
-
-  user.mail        = obj->value("mail").toString();
-  user.lastLoginOn = obj->value("last_login_on").toVariant().toDateTime();
-
-  fillDefaultFields( user, obj );
-
-  RETURN();
-}
-
 void
 SimpleRedmineClient::retrieveCurrentUser( UserCb callback )
 {
     ENTER();
 
+    if( failOffline(callback) )
+        RETURN();
+
     auto cb = [=]( QNetworkReply* reply, QJsonDocument* json )
     {
         ENTER();
@@ -1136,8 +2029,7 @@ SimpleRedmineClient::retrieveCurrentUser( UserCb callback )
         }
 
         User user;
-        QJsonObject obj = json->object().value("user").toObject();
-        parseUser( user, &obj );
+        readFields( user, json->object().value("user").toObject() );
         callback( user, RedmineError::NO_ERR, QStringList() );
 
         RETURN();
@@ -1153,40 +2045,22 @@ SimpleRedmineClient::retrieveUsers( UsersCb callback, QString parameters )
 {
     ENTER()(parameters);
 
-    auto cb = [=]( QNetworkReply* reply, QJsonDocument* json )
-    {
-        ENTER();
-
-        // Quit on network error
-        if( reply->error() != QNetworkReply::NoError )
-        {
-            DEBUG() << "Network error:" << reply->errorString();
-            callback( Users(), RedmineError::ERR_NETWORK, getErrorList(reply, json) );
-            RETURN();
-        }
-
-        Users users;
-
-        // Iterate over the document
-        for( const auto& j1 : json->object() )
-        {
-            // Iterate over all users
-            for( const auto& j2 : j1.toArray() )
-            {
-                QJsonObject obj = j2.toObject();
+    retrieveUsers( callback, RedmineOptions(parameters, true) );
 
-                User user;
-                parseUser( user, &obj );
-                users.push_back( user );
-            }
-        }
+    RETURN();
+}
 
-        callback( users, RedmineError::NO_ERR, QStringList() );
+void
+SimpleRedmineClient::retrieveUsers( UsersCb callback, RedmineOptions options )
+{
+    ENTER()(options);
 
-        RETURN();
+    auto fetch = [this]( JsonCb cb, QString parameters )
+    {
+        RedmineClient::retrieveUsers( cb, parameters );
     };
 
-    RedmineClient::retrieveUsers( cb, parameters );
+    retrieveCollection<User>( "users", fetch, callback, options );
 
     RETURN();
 }
@@ -1196,6 +2070,9 @@ SimpleRedmineClient::retrieveVersions( VersionsCb callback, int projectId, QStri
 {
     ENTER()(projectId)(parameters);
 
+    if( failOffline(callback) )
+        RETURN();
+
     auto cb = [=]( QNetworkReply* reply, QJsonDocument* json )
     {
         ENTER();
@@ -1219,32 +2096,7 @@ SimpleRedmineClient::retrieveVersions( VersionsCb callback, int projectId, QStri
                 QJsonObject obj = j2.toObject();
 
                 Version version;
-
-                // Simple fields
-                version.id = obj.value("id").toInt();
-                version.name = obj.value("name").toString();
-                version.description = obj.value("description").toString();
-                version.dueDate = obj.value("due_date").toVariant().toDate();
-
-                QString sharing = obj.value("sharing").toString();
-                if( sharing == "none" )
-                    version.sharing = VersionSharing::none;
-                else if( sharing == "descendants" )
-                    version.sharing = VersionSharing::descendants;
-                else if( sharing == "hierarchy" )
-                    version.sharing = VersionSharing::hierarchy;
-                else if( sharing == "tree" )
-                    version.sharing = VersionSharing::tree;
-                else if( sharing == "system" )
-                    version.sharing = VersionSharing::system;
-
-                QString status = obj.value("status").toString();
-                if( status == "open" )
-                    version.status = VersionStatus::open;
-                else if( status == "locked" )
-                    version.status = VersionStatus::locked;
-                else if( status == "closed" )
-                    version.status = VersionStatus::closed;
+                readFields( version, obj );
 
                 versions.push_back( version );
             }
@@ -0,0 +1,434 @@
+#include "CustomFieldTable.h"
+#include "SimpleRedmineTypes.h"
+#include "StringPool.h"
+
+#include <QVariant>
+
+namespace qtredmine {
+
+void
+readValue( const QJsonValue& json, bool& value )
+{
+    value = json.toBool();
+}
+
+void
+readValue( const QJsonValue& json, int& value )
+{
+    // References to other resources
+    if( json.isObject() )
+    {
+        QJsonObject obj = json.toObject();
+
+        if( !obj.isEmpty() )
+            value = obj.value(QLatin1String("id")).toInt();
+    }
+    else
+        value = json.toInt();
+}
+
+void
+readValue( const QJsonValue& json, double& value )
+{
+    value = json.toDouble();
+}
+
+void
+readValue( const QJsonValue& json, QString& value )
+{
+    value = json.toString();
+}
+
+void
+readValue( const QJsonValue& json, QStringList& value )
+{
+    QStringList values;
+
+    for( const auto& element : json.toArray() )
+        values.push_back( element.toString() );
+
+    value = values;
+}
+
+void
+readValue( const QJsonValue& json, QVector<QString>& value )
+{
+    QJsonArray array = json.toArray();
+
+    QVector<QString> values;
+    values.reserve( array.size() );
+
+    // Either plain strings or objects with a value, e.g. possible values of custom fields
+    for( const auto& element : array )
+    {
+        if( element.isObject() )
+            values.push_back( element.toObject().value(QLatin1String("value")).toString() );
+        else
+            values.push_back( element.toString() );
+    }
+
+    value = values;
+}
+
+void
+readValue( const QJsonValue& json, QDate& value )
+{
+    value = json.toVariant().toDate();
+}
+
+void
+readValue( const QJsonValue& json, QDateTime& value )
+{
+    value = json.toVariant().toDateTime();
+}
+
+void
+readValue( const QJsonValue& json, Timestamp& value )
+{
+    value = Timestamp::fromString( json.toString() );
+}
+
+void
+readValue( const QJsonValue& json, Item& value )
+{
+    QJsonObject obj = json.toObject();
+
+    if( !obj.isEmpty() )
+    {
+        value.id   = obj.value(QLatin1String("id")).toInt();
+        value.name = StringPool::itemNames().intern( obj.value(QLatin1String("name")).toString() );
+    }
+}
+
+void
+readValue( const QJsonValue& json, Items& value )
+{
+    QJsonArray array = json.toArray();
+
+    Items items;
+    items.reserve( array.size() );
+
+    for( const auto& element : array )
+    {
+        Item item;
+        readValue( element, item );
+        items.push_back( item );
+    }
+
+    value = items;
+}
+
+void
+readValue( const QJsonValue& json, VersionStatus& value )
+{
+    QString status = json.toString();
+
+    if( status == "open" )
+        value = VersionStatus::open;
+    else if( status == "locked" )
+        value = VersionStatus::locked;
+    else if( status == "closed" )
+        value = VersionStatus::closed;
+}
+
+void
+readValue( const QJsonValue& json, VersionSharing& value )
+{
+    QString sharing = json.toString();
+
+    if( sharing == "none" )
+        value = VersionSharing::none;
+    else if( sharing == "descendants" )
+        value = VersionSharing::descendants;
+    else if( sharing == "hierarchy" )
+        value = VersionSharing::hierarchy;
+    else if( sharing == "tree" )
+        value = VersionSharing::tree;
+    else if( sharing == "system" )
+        value = VersionSharing::system;
+}
+
+void
+readValue( const QJsonValue& json, CustomFieldValues& value, const char* resource, CustomFieldTable* table )
+{
+    QJsonArray array = json.toArray();
+
+    CustomFieldValues values;
+    values.reserve( array.size() );
+
+    for( const auto& cf : array )
+    {
+        QJsonObject cfObj = cf.toObject();
+        QJsonValue cfValue = cfObj.value(QLatin1String("value"));
+
+        CustomFieldValue customField;
+        customField.id    = cfObj.value(QLatin1String("id")).toInt();
+        customField.table = table;
+
+        if( cfValue.isString() )
+            customField.value = cfValue.toString();
+        else if( cfValue.isArray() )
+        {
+            QJsonArray elements = cfValue.toArray();
+
+            for( int i = 0; i < elements.size(); ++i )
+            {
+                if( i == 0 )
+                    customField.value = elements.at( i ).toString();
+                else
+                    customField.moreValues.push_back( elements.at(i).toString() );
+            }
+        }
+
+        // The definition is shared by all resources using this custom field
+        ( table ? *table : CustomFieldTable::instance() )
+            .insertIfMissing( customField.id, cfObj.value(QLatin1String("name")).toString(),
+                              QString::fromLatin1(resource), cfObj.value(QLatin1String("multiple")).toBool() );
+
+        values.push_back( customField );
+    }
+
+    value = values;
+}
+
+QJsonValue
+writeValue( bool value )
+{
+    return value;
+}
+
+QJsonValue
+writeValue( int value )
+{
+    return value;
+}
+
+QJsonValue
+writeValue( double value )
+{
+    return value;
+}
+
+QJsonValue
+writeValue( const QString& value )
+{
+    return value;
+}
+
+QJsonValue
+writeValue( const QStringList& value )
+{
+    return QJsonArray::fromStringList( value );
+}
+
+QJsonValue
+writeValue( const QVector<QString>& value )
+{
+    QJsonArray array;
+
+    for( const auto& element : value )
+        array.append( element );
+
+    return array;
+}
+
+QJsonValue
+writeValue( const QDate& value )
+{
+    return value.toString( Qt::ISODate );
+}
+
+QJsonValue
+writeValue( const QDateTime& value )
+{
+    return value.toString( Qt::ISODate );
+}
+
+QJsonValue
+writeValue( const Timestamp& value )
+{
+    return value.toDateTime().toString( Qt::ISODate );
+}
+
+QJsonValue
+writeValue( const Item& value )
+{
+    return value.id;
+}
+
+QJsonValue
+writeValue( const Items& value )
+{
+    QJsonArray array;
+
+    for( const auto& item : value )
+        array.append( item.id );
+
+    return array;
+}
+
+QJsonValue
+writeValue( const CustomFieldValues& value )
+{
+    QJsonArray array;
+
+    for( const auto& customField : value )
+    {
+        QJsonObject cf;
+        cf["id"] = customField.id;
+
+        if( customField.moreValues.isEmpty() )
+            cf["value"] = customField.value;
+        else
+            cf["value"] = QJsonArray::fromStringList( customField.values() );
+
+        array.append( cf );
+    }
+
+    return array;
+}
+
+QJsonValue
+writeValue( VersionStatus value )
+{
+    switch( value )
+    {
+    case VersionStatus::open:   return QString( "open" );
+    case VersionStatus::locked: return QString( "locked" );
+    case VersionStatus::closed: return QString( "closed" );
+    }
+
+    return QJsonValue();
+}
+
+QJsonValue
+writeValue( VersionSharing value )
+{
+    switch( value )
+    {
+    case VersionSharing::none:        return QString( "none" );
+    case VersionSharing::descendants: return QString( "descendants" );
+    case VersionSharing::hierarchy:   return QString( "hierarchy" );
+    case VersionSharing::tree:        return QString( "tree" );
+    case VersionSharing::system:      return QString( "system" );
+    }
+
+    return QJsonValue();
+}
+
+void
+writeValue( JsonWriter& writer, bool value )
+{
+    writer.value( value );
+}
+
+void
+writeValue( JsonWriter& writer, int value )
+{
+    writer.value( value );
+}
+
+void
+writeValue( JsonWriter& writer, double value )
+{
+    writer.value( value );
+}
+
+void
+writeValue( JsonWriter& writer, const QString& value )
+{
+    writer.value( value );
+}
+
+void
+writeValue( JsonWriter& writer, const QStringList& value )
+{
+    writer.beginArray();
+
+    for( const auto& element : value )
+        writer.value( element );
+
+    writer.endArray();
+}
+
+void
+writeValue( JsonWriter& writer, const QVector<QString>& value )
+{
+    writer.beginArray();
+
+    for( const auto& element : value )
+        writer.value( element );
+
+    writer.endArray();
+}
+
+void
+writeValue( JsonWriter& writer, const QDate& value )
+{
+    writer.value( value.toString(Qt::ISODate) );
+}
+
+void
+writeValue( JsonWriter& writer, const QDateTime& value )
+{
+    writer.value( value.toString(Qt::ISODate) );
+}
+
+void
+writeValue( JsonWriter& writer, const Timestamp& value )
+{
+    writer.value( value.toDateTime().toString(Qt::ISODate) );
+}
+
+void
+writeValue( JsonWriter& writer, const Item& value )
+{
+    writer.value( value.id );
+}
+
+void
+writeValue( JsonWriter& writer, const Items& value )
+{
+    writer.beginArray();
+
+    for( const auto& item : value )
+        writer.value( item.id );
+
+    writer.endArray();
+}
+
+void
+writeValue( JsonWriter& writer, const CustomFieldValues& value )
+{
+    writer.beginArray();
+
+    for( const auto& customField : value )
+    {
+        writer.beginObject();
+        writer.key( "id" ).value( customField.id );
+        writer.key( "value" );
+
+        if( customField.moreValues.isEmpty() )
+            writer.value( customField.value );
+        else
+            writeValue( writer, customField.values() );
+
+        writer.endObject();
+    }
+
+    writer.endArray();
+}
+
+void
+writeValue( JsonWriter& writer, VersionStatus value )
+{
+    writer.value( writeValue(value).toString() );
+}
+
+void
+writeValue( JsonWriter& writer, VersionSharing value )
+{
+    writer.value( writeValue(value).toString() );
+}
+
+} // qtredmine
@@ -0,0 +1,745 @@
+#include "Logging.h"
+#include "SqliteMirror.h"
+#include "StringPool.h"
+
+#include <QSqlError>
+#include <QStringList>
+#include <QTimer>
+
+#include <algorithm>
+
+using namespace qtredmine;
+
+const int SqliteMirror::SCHEMA_VERSION;
+const int SqliteMirror::CHUNK_SIZE;
+
+namespace {
+
+/// Item column of the issues table
+struct ItemColumn
+{
+    const char* name;  ///< Column name prefix
+    Item Issue::* item; ///< Issue item
+};
+
+/// Item columns of the issues table, stored as <name>_id and <name>_name
+const ItemColumn ISSUE_ITEMS[] = {
+    { "project",     &Issue::project },
+    { "tracker",     &Issue::tracker },
+    { "status",      &Issue::status },
+    { "priority",    &Issue::priority },
+    { "author",      &Issue::author },
+    { "assigned_to", &Issue::assignedTo },
+    { "category",    &Issue::category },
+    { "version",     &Issue::version },
+};
+
+/// Value columns of the issues table, following the ID, parent ID and item columns
+const char* ISSUE_VALUES[] = {
+    "subject",
+    "description",
+    "start_date",
+    "due_date",
+    "done_ratio",
+    "estimated_hours",
+    "created_on",
+    "updated_on",
+};
+
+// Get the column names of the issues table in binding order
+QStringList
+issueColumns()
+{
+    QStringList columns;
+    columns << "id" << "parent_id";
+
+    for( const auto& column : ISSUE_ITEMS )
+        columns << QString("%1_id").arg(column.name) << QString("%1_name").arg(column.name);
+
+    for( const char* column : ISSUE_VALUES )
+        columns << column;
+
+    return columns;
+}
+
+// Create an insert statement for a table
+QString
+insertStatement( const QString& table, const QStringList& columns )
+{
+    QStringList placeholders;
+    for( int i = 0; i < columns.size(); ++i )
+        placeholders << "?";
+
+    return QString( "INSERT OR REPLACE INTO %1 (%2) VALUES (%3)" )
+            .arg( table, columns.join(", "), placeholders.join(", ") );
+}
+
+// Convert an ID into a column value; NULL_ID is stored as NULL
+QVariant
+idValue( int id )
+{
+    return id == NULL_ID ? QVariant() : QVariant( id );
+}
+
+// Convert a timestamp into a column value
+QVariant
+timeValue( const Timestamp& time )
+{
+    return time.isValid() ? QVariant( time.toMSecsSinceEpoch() ) : QVariant();
+}
+
+// Convert a date into a column value
+QVariant
+dateValue( const QDate& date )
+{
+    return date.isValid() ? QVariant( date.toString(Qt::ISODate) ) : QVariant();
+}
+
+// Bind an item as ID and name
+void
+bindItem( QSqlQuery& query, const Item& item )
+{
+    query.addBindValue( idValue(item.id) );
+    query.addBindValue( item.id == NULL_ID ? QVariant() : QVariant(item.name) );
+}
+
+// Read an ID column; NULL is read as NULL_ID
+int
+toId( const QVariant& value )
+{
+    return value.isNull() ? NULL_ID : value.toInt();
+}
+
+// Read a time column
+Timestamp
+toTime( const QVariant& value )
+{
+    return value.isNull() ? Timestamp() : Timestamp::fromMSecsSinceEpoch( value.toLongLong() );
+}
+
+} // namespace
+
+SqliteMirror::SqliteMirror( QString path, QObject* parent )
+    : QObject( parent ),
+      connectionName_( QString("qtredmine-mirror-%1").arg(reinterpret_cast<quintptr>(this)) )
+{
+    ENTER()(path);
+
+    QSqlDatabase db = QSqlDatabase::addDatabase( "QSQLITE", connectionName_ );
+    db.setDatabaseName( path );
+
+    if( !db.open() )
+    {
+        DEBUG() << "Could not open mirror database:" << db.lastError().text();
+        RETURN();
+    }
+
+    // Write-ahead logging lets reporting jobs read while the mirror is written. Recursive triggers
+    // make INSERT OR REPLACE fire the delete trigger of the replaced row, keeping the FTS5 index exact.
+    exec( "PRAGMA journal_mode = WAL" );
+    exec( "PRAGMA synchronous = NORMAL" );
+    exec( "PRAGMA recursive_triggers = ON" );
+
+    open_ = createSchema();
+
+    DEBUG()(open_)(fullTextSearch_);
+
+    RETURN();
+}
+
+SqliteMirror::~SqliteMirror()
+{
+    ENTER();
+
+    // Queued resources have been reported as retrieved already, so they are not dropped
+    flush();
+
+    {
+        QSqlDatabase db = QSqlDatabase::database( connectionName_, false );
+        db.close();
+    }
+
+    // All connection handles must be gone before the connection can be removed
+    QSqlDatabase::removeDatabase( connectionName_ );
+
+    RETURN();
+}
+
+bool
+SqliteMirror::exec( const QString& statement )
+{
+    QSqlQuery query( database() );
+
+    if( query.exec(statement) )
+        return true;
+
+    DEBUG() << "SQL error:" << query.lastError().text() << statement;
+    return false;
+}
+
+bool
+SqliteMirror::createSchema()
+{
+    ENTER();
+
+    QSqlQuery query( database() );
+    query.exec( "PRAGMA user_version" );
+    int version = query.next() ? query.value(0).toInt() : 0;
+
+    // The mirror can always be rebuilt from Redmine, so outdated schemas are simply dropped
+    if( version != 0 && version != SCHEMA_VERSION )
+    {
+        DEBUG() << "Dropping mirror schema version" << version;
+
+        for( const char* table : { "issues_fts", "issues", "issue_custom_fields", "time_entries", "projects" } )
+            exec( QString("DROP TABLE IF EXISTS %1").arg(table) );
+    }
+
+    QStringList issueDefinitions;
+    issueDefinitions << "id INTEGER PRIMARY KEY" << "parent_id INTEGER";
+
+    for( const auto& column : ISSUE_ITEMS )
+        issueDefinitions << QString("%1_id INTEGER").arg(column.name) << QString("%1_name TEXT").arg(column.name);
+
+    issueDefinitions << "subject TEXT" << "description TEXT" << "start_date TEXT" << "due_date TEXT"
+                     << "done_ratio REAL" << "estimated_hours REAL" << "created_on INTEGER" << "updated_on INTEGER";
+
+    bool ok = exec( QString("CREATE TABLE IF NOT EXISTS issues (%1)").arg(issueDefinitions.join(", ")) )
+            && exec( "CREATE INDEX IF NOT EXISTS issues_project ON issues (project_id)" )
+            && exec( "CREATE INDEX IF NOT EXISTS issues_status ON issues (status_id)" )
+            && exec( "CREATE INDEX IF NOT EXISTS issues_assigned_to ON issues (assigned_to_id)" )
+            && exec( "CREATE INDEX IF NOT EXISTS issues_updated_on ON issues (updated_on)" )
+            && exec( "CREATE TABLE IF NOT EXISTS issue_custom_fields ("
+                     "issue_id INTEGER NOT NULL, custom_field_id INTEGER NOT NULL, position INTEGER NOT NULL, "
+                     "value TEXT, PRIMARY KEY (issue_id, custom_field_id, position)) WITHOUT ROWID" )
+            && exec( "CREATE TABLE IF NOT EXISTS time_entries ("
+                     "id INTEGER PRIMARY KEY, issue_id INTEGER, project_id INTEGER, project_name TEXT, "
+                     "activity_id INTEGER, activity_name TEXT, user_id INTEGER, user_name TEXT, "
+                     "hours REAL, comment TEXT, spent_on TEXT, created_on INTEGER, updated_on INTEGER)" )
+            && exec( "CREATE INDEX IF NOT EXISTS time_entries_issue ON time_entries (issue_id)" )
+            && exec( "CREATE INDEX IF NOT EXISTS time_entries_project ON time_entries (project_id, spent_on)" )
+            && exec( "CREATE TABLE IF NOT EXISTS projects ("
+                     "id INTEGER PRIMARY KEY, identifier TEXT, name TEXT, description TEXT, "
+                     "parent_id INTEGER, is_public INTEGER, created_on INTEGER, updated_on INTEGER)" );
+
+    if( !ok )
+        RETURN( false );
+
+    query.exec( "SELECT 1 FROM sqlite_master WHERE name = 'issues_fts'" );
+    bool indexed = query.next();
+
+    // FTS5 is optional; without it, searches fall back to LIKE
+    fullTextSearch_ =
+            exec( "CREATE VIRTUAL TABLE IF NOT EXISTS issues_fts USING fts5("
+                  "subject, description, content='issues', content_rowid='id')" )
+            && exec( "CREATE TRIGGER IF NOT EXISTS issues_fts_insert AFTER INSERT ON issues BEGIN "
+                     "INSERT INTO issues_fts (rowid, subject, description) VALUES (new.id, new.subject, new.description); "
+                     "END" )
+            && exec( "CREATE TRIGGER IF NOT EXISTS issues_fts_delete AFTER DELETE ON issues BEGIN "
+                     "INSERT INTO issues_fts (issues_fts, rowid, subject, description) "
+                     "VALUES ('delete', old.id, old.subject, old.description); "
+                     "END" )
+            && exec( "CREATE TRIGGER IF NOT EXISTS issues_fts_update AFTER UPDATE ON issues BEGIN "
+                     "INSERT INTO issues_fts (issues_fts, rowid, subject, description) "
+                     "VALUES ('delete', old.id, old.subject, old.description); "
+                     "INSERT INTO issues_fts (rowid, subject, description) VALUES (new.id, new.subject, new.description); "
+                     "END" );
+
+    // Index the issues written while FTS5 was not available
+    if( fullTextSearch_ && !indexed )
+        exec( "INSERT INTO issues_fts (issues_fts) VALUES ('rebuild')" );
+
+    exec( QString("PRAGMA user_version = %1").arg(SCHEMA_VERSION) );
+
+    RETURN( true );
+}
+
+bool
+SqliteMirror::isOpen() const
+{
+    return open_;
+}
+
+bool
+SqliteMirror::hasFullTextSearch() const
+{
+    return fullTextSearch_;
+}
+
+QSqlDatabase
+SqliteMirror::database() const
+{
+    return QSqlDatabase::database( connectionName_, false );
+}
+
+bool
+SqliteMirror::write( const Issues& issues )
+{
+    ENTER()(issues.size());
+
+    flush();
+    bool ok = write( issues, 0, issues.size() );
+
+    RETURN( ok );
+}
+
+void
+SqliteMirror::enqueue( const Issues& issues )
+{
+    ENTER()(issues.size());
+
+    enqueue( [this, issues]( int begin, int end ){ return write( issues, begin, end ); }, issues.size() );
+
+    RETURN();
+}
+
+bool
+SqliteMirror::write( const Issues& issues, int begin, int end )
+{
+    ENTER()(begin)(end);
+
+    if( !open_ )
+        RETURN( false );
+
+    QSqlDatabase db = database();
+    db.transaction();
+
+    // Statements are prepared once per batch and executed for each issue
+    QSqlQuery insert( db );
+    insert.prepare( insertStatement("issues", issueColumns()) );
+
+    QSqlQuery deleteCustomFields( db );
+    deleteCustomFields.prepare( "DELETE FROM issue_custom_fields WHERE issue_id = ?" );
+
+    QSqlQuery insertCustomField( db );
+    insertCustomField.prepare( "INSERT INTO issue_custom_fields (issue_id, custom_field_id, position, value) "
+                               "VALUES (?, ?, ?, ?)" );
+
+    bool ok = true;
+
+    for( int i = begin; i < end; ++i )
+    {
+        const Issue& issue = issues.at( i );
+
+        if( issue.id == NULL_ID )
+            continue;
+
+        insert.addBindValue( issue.id );
+        insert.addBindValue( idValue(issue.parentId) );
+
+        for( const auto& column : ISSUE_ITEMS )
+            bindItem( insert, issue.*column.item );
+
+        insert.addBindValue( issue.subject );
+        insert.addBindValue( issue.description );
+        insert.addBindValue( dateValue(issue.startDate) );
+        insert.addBindValue( dateValue(issue.dueDate) );
+        insert.addBindValue( issue.doneRatio );
+        insert.addBindValue( issue.estimatedHours );
+        insert.addBindValue( timeValue(issue.createdOn) );
+        insert.addBindValue( timeValue(issue.updatedOn) );
+
+        deleteCustomFields.addBindValue( issue.id );
+
+        ok = insert.exec() && deleteCustomFields.exec();
+
+        for( const auto& customField : issue.customFields )
+        {
+            QStringList values = customField.values();
+
+            for( int position = 0; ok && position < values.size(); ++position )
+            {
+                insertCustomField.addBindValue( issue.id );
+                insertCustomField.addBindValue( customField.id );
+                insertCustomField.addBindValue( position );
+                insertCustomField.addBindValue( values.at(position) );
+                ok = insertCustomField.exec();
+            }
+        }
+
+        if( !ok )
+        {
+            DEBUG() << "SQL error:" << insert.lastError().text() << deleteCustomFields.lastError().text()
+                    << insertCustomField.lastError().text();
+            break;
+        }
+    }
+
+    if( ok )
+        ok = db.commit();
+    else
+        db.rollback();
+
+    RETURN( ok );
+}
+
+bool
+SqliteMirror::write( const TimeEntries& timeEntries )
+{
+    ENTER()(timeEntries.size());
+
+    flush();
+    bool ok = write( timeEntries, 0, timeEntries.size() );
+
+    RETURN( ok );
+}
+
+void
+SqliteMirror::enqueue( const TimeEntries& timeEntries )
+{
+    ENTER()(timeEntries.size());
+
+    enqueue( [this, timeEntries]( int begin, int end ){ return write( timeEntries, begin, end ); }, timeEntries.size() );
+
+    RETURN();
+}
+
+bool
+SqliteMirror::write( const TimeEntries& timeEntries, int begin, int end )
+{
+    ENTER()(begin)(end);
+
+    if( !open_ )
+        RETURN( false );
+
+    QSqlDatabase db = database();
+    db.transaction();
+
+    QSqlQuery insert( db );
+    insert.prepare( insertStatement("time_entries", QStringList()
+                                    << "id" << "issue_id" << "project_id" << "project_name"
+                                    << "activity_id" << "activity_name" << "user_id" << "user_name"
+                                    << "hours" << "comment" << "spent_on" << "created_on" << "updated_on") );
+
+    bool ok = true;
+
+    for( int i = begin; i < end; ++i )
+    {
+        const TimeEntry& timeEntry = timeEntries.at( i );
+
+        if( timeEntry.id == NULL_ID )
+            continue;
+
+        insert.addBindValue( timeEntry.id );
+        insert.addBindValue( idValue(timeEntry.issue.id) );
+        bindItem( insert, timeEntry.project );
+        bindItem( insert, timeEntry.activity );
+        bindItem( insert, timeEntry.user );
+        insert.addBindValue( timeEntry.hours );
+        insert.addBindValue( timeEntry.comment );
+        insert.addBindValue( dateValue(timeEntry.spentOn) );
+        insert.addBindValue( timeValue(timeEntry.createdOn) );
+        insert.addBindValue( timeValue(timeEntry.updatedOn) );
+
+        if( !insert.exec() )
+        {
+            DEBUG() << "SQL error:" << insert.lastError().text();
+            ok = false;
+            break;
+        }
+    }
+
+    if( ok )
+        ok = db.commit();
+    else
+        db.rollback();
+
+    RETURN( ok );
+}
+
+bool
+SqliteMirror::write( const Projects& projects )
+{
+    ENTER()(projects.size());
+
+    flush();
+    bool ok = write( projects, 0, projects.size() );
+
+    RETURN( ok );
+}
+
+void
+SqliteMirror::enqueue( const Projects& projects )
+{
+    ENTER()(projects.size());
+
+    enqueue( [this, projects]( int begin, int end ){ return write( projects, begin, end ); }, projects.size() );
+
+    RETURN();
+}
+
+bool
+SqliteMirror::write( const Projects& projects, int begin, int end )
+{
+    ENTER()(begin)(end);
+
+    if( !open_ )
+        RETURN( false );
+
+    QSqlDatabase db = database();
+    db.transaction();
+
+    QSqlQuery insert( db );
+    insert.prepare( insertStatement("projects", QStringList()
+                                    << "id" << "identifier" << "name" << "description"
+                                    << "parent_id" << "is_public" << "created_on" << "updated_on") );
+
+    bool ok = true;
+
+    for( int i = begin; i < end; ++i )
+    {
+        const Project& project = projects.at( i );
+
+        if( project.id == NULL_ID )
+            continue;
+
+        insert.addBindValue( project.id );
+        insert.addBindValue( project.identifier );
+        insert.addBindValue( project.name );
+        insert.addBindValue( project.description );
+        insert.addBindValue( idValue(project.parent.id) );
+        insert.addBindValue( project.isPublic );
+        insert.addBindValue( timeValue(project.createdOn) );
+        insert.addBindValue( timeValue(project.updatedOn) );
+
+        if( !insert.exec() )
+        {
+            DEBUG() << "SQL error:" << insert.lastError().text();
+            ok = false;
+            break;
+        }
+    }
+
+    if( ok )
+        ok = db.commit();
+    else
+        db.rollback();
+
+    RETURN( ok );
+}
+
+void
+SqliteMirror::enqueue( std::function<bool(int, int)> write, int size )
+{
+    if( !open_ || size == 0 )
+        return;
+
+    pending_.enqueue( PendingWrite{write, size, 0} );
+
+    // Otherwise, a chunk has been scheduled already
+    if( pending_.size() == 1 )
+        QTimer::singleShot( 0, this, [this](){ writeChunk(); } );
+}
+
+void
+SqliteMirror::writeChunk()
+{
+    ENTER()(pending_.size());
+
+    // The queue may have been flushed or cleared in the meantime
+    if( pending_.isEmpty() )
+        RETURN();
+
+    PendingWrite& pending = pending_.head();
+    int end = std::min( pending.next + CHUNK_SIZE, pending.size );
+
+    if( !pending.write(pending.next, end) )
+        DEBUG( "Chunk has been rolled back" )(pending.next)(end);
+
+    pending.next = end;
+
+    if( pending.next == pending.size )
+        pending_.dequeue();
+
+    // Yield to the event loop between chunks
+    if( !pending_.isEmpty() )
+        QTimer::singleShot( 0, this, [this](){ writeChunk(); } );
+
+    RETURN();
+}
+
+bool
+SqliteMirror::flush()
+{
+    ENTER()(pending_.size());
+
+    bool ok = true;
+
+    while( !pending_.isEmpty() )
+    {
+        PendingWrite pending = pending_.dequeue();
+        ok = pending.write( pending.next, pending.size ) && ok;
+    }
+
+    RETURN( ok );
+}
+
+bool
+SqliteMirror::hasPendingWrites() const
+{
+    return !pending_.isEmpty();
+}
+
+bool
+SqliteMirror::clear()
+{
+    ENTER();
+
+    pending_.clear();
+
+    if( !open_ )
+        RETURN( false );
+
+    QSqlDatabase db = database();
+    db.transaction();
+
+    bool ok = exec( "DELETE FROM issues" )
+            && exec( "DELETE FROM issue_custom_fields" )
+            && exec( "DELETE FROM time_entries" )
+            && exec( "DELETE FROM projects" );
+
+    if( ok )
+        ok = db.commit();
+    else
+        db.rollback();
+
+    RETURN( ok );
+}
+
+Issues
+SqliteMirror::readIssues( QSqlQuery& query ) const
+{
+    QSqlQuery customFields( database() );
+    customFields.prepare( "SELECT custom_field_id, value FROM issue_custom_fields "
+                          "WHERE issue_id = ? ORDER BY custom_field_id, position" );
+
+    Issues issues;
+
+    while( query.next() )
+    {
+        Issue issue;
+        issue.id       = query.value( 0 ).toInt();
+        issue.parentId = toId( query.value(1) );
+
+        int column = 2;
+
+        for( const auto& itemColumn : ISSUE_ITEMS )
+        {
+            Item& item = issue.*itemColumn.item;
+            item.id   = toId( query.value(column++) );
+            item.name = StringPool::itemNames().intern( query.value(column++).toString() );
+        }
+
+        issue.subject        = query.value( column++ ).toString();
+        issue.description    = query.value( column++ ).toString();
+        issue.startDate      = QDate::fromString( query.value(column++).toString(), Qt::ISODate );
+        issue.dueDate        = QDate::fromString( query.value(column++).toString(), Qt::ISODate );
+        issue.doneRatio      = query.value( column++ ).toDouble();
+        issue.estimatedHours = query.value( column++ ).toDouble();
+        issue.createdOn      = toTime( query.value(column++) );
+        issue.updatedOn      = toTime( query.value(column++) );
+
+        // Values of one custom field are consecutive, the first one at position 0
+        customFields.addBindValue( issue.id );
+        customFields.exec();
+
+        while( customFields.next() )
+        {
+            int id = customFields.value( 0 ).toInt();
+            QString value = customFields.value( 1 ).toString();
+
+            if( !issue.customFields.isEmpty() && issue.customFields.last().id == id )
+            {
+                issue.customFields.last().moreValues.append( value );
+            }
+            else
+            {
+                CustomFieldValue customField;
+                customField.id    = id;
+                customField.value = value;
+                issue.customFields.push_back( customField );
+            }
+        }
+
+        issues.push_back( issue );
+    }
+
+    return issues;
+}
+
+Issues
+SqliteMirror::issues( QString condition, QVariantList values ) const
+{
+    ENTER()(condition)(values);
+
+    if( !open_ )
+        RETURN( Issues() );
+
+    QString statement = QString( "SELECT %1 FROM issues" ).arg( issueColumns().join(", ") );
+
+    if( !condition.isEmpty() )
+        statement += " WHERE " + condition;
+
+    statement += " ORDER BY id";
+
+    QSqlQuery query( database() );
+    query.prepare( statement );
+
+    for( const auto& value : values )
+        query.addBindValue( value );
+
+    if( !query.exec() )
+    {
+        DEBUG() << "SQL error:" << query.lastError().text() << statement;
+        RETURN( Issues() );
+    }
+
+    Issues issues = readIssues( query );
+
+    RETURN( issues, issues.size() );
+}
+
+Issues
+SqliteMirror::search( QString text, int limit ) const
+{
+    ENTER()(text)(limit);
+
+    if( !open_ )
+        RETURN( Issues() );
+
+    QStringList columns = issueColumns();
+    for( auto& column : columns )
+        column.prepend( "issues." );
+
+    QSqlQuery query( database() );
+
+    if( fullTextSearch_ )
+    {
+        query.prepare( QString("SELECT %1 FROM issues_fts JOIN issues ON issues.id = issues_fts.rowid "
+                               "WHERE issues_fts MATCH ? ORDER BY issues_fts.rank LIMIT ?")
+                       .arg(columns.join(", ")) );
+        query.addBindValue( text );
+    }
+    else
+    {
+        query.prepare( QString("SELECT %1 FROM issues WHERE subject LIKE ? OR description LIKE ? "
+                               "ORDER BY id LIMIT ?")
+                       .arg(columns.join(", ")) );
+
+        QString pattern = "%" + text + "%";
+        query.addBindValue( pattern );
+        query.addBindValue( pattern );
+    }
+
+    query.addBindValue( limit );
+
+    if( !query.exec() )
+    {
+        DEBUG() << "SQL error:" << query.lastError().text();
+        RETURN( Issues() );
+    }
+
+    Issues issues = readIssues( query );
+
+    RETURN( issues, issues.size() );
+}
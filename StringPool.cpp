@@ -0,0 +1,73 @@
+#include "Logging.h"
+#include "StringPool.h"
+
+#include <QMutexLocker>
+
+using namespace qtredmine;
+
+QString
+StringPool::intern( const QString& string )
+{
+    // Null and empty strings do not allocate anyway
+    if( string.isEmpty() )
+        return string;
+
+    QMutexLocker locker( &mutex_ );
+
+    auto it = strings_.constFind( string );
+    if( it != strings_.constEnd() )
+        return *it;
+
+    strings_.insert( string );
+    return string;
+}
+
+void
+StringPool::clear()
+{
+    ENTER();
+
+    QMutexLocker locker( &mutex_ );
+    strings_.clear();
+
+    RETURN();
+}
+
+int
+StringPool::trim()
+{
+    ENTER();
+
+    QMutexLocker locker( &mutex_ );
+
+    int removed = 0;
+
+    // A detached string has no other reference than the pool; strings are only handed out by
+    // intern(), which holds the mutex, so no new reference can appear meanwhile
+    for( auto it = strings_.begin(); it != strings_.end(); )
+    {
+        if( it->isDetached() )
+        {
+            it = strings_.erase( it );
+            ++removed;
+        }
+        else
+            ++it;
+    }
+
+    RETURN( removed );
+}
+
+int
+StringPool::size() const
+{
+    QMutexLocker locker( &mutex_ );
+    return strings_.size();
+}
+
+StringPool&
+StringPool::itemNames()
+{
+    static StringPool pool;
+    return pool;
+}
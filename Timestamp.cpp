@@ -0,0 +1,109 @@
+#include "Timestamp.h"
+
+#include <QDate>
+
+using namespace qtredmine;
+
+const qint64 Timestamp::INVALID;
+
+namespace {
+
+// Parse a fixed number of decimal digits
+bool
+parseDigits( const QChar* p, int count, int& value )
+{
+    value = 0;
+
+    for( int i = 0; i < count; ++i )
+    {
+        const ushort c = p[i].unicode();
+
+        if( c < '0' || c > '9' )
+            return false;
+
+        value = value * 10 + (c - '0');
+    }
+
+    return true;
+}
+
+// Number of days between 1970-01-01 and a date of the proleptic Gregorian calendar
+qint64
+daysFromCivil( int year, int month, int day )
+{
+    year -= month <= 2;
+
+    const qint64 era = (year >= 0 ? year : year - 399) / 400;
+    const qint64 yoe = year - era * 400;
+    const qint64 doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const qint64 doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+    return era * 146097 + doe - 719468;
+}
+
+} // namespace
+
+Timestamp
+Timestamp::fromString( const QString& string )
+{
+    const QChar* p = string.constData();
+    const int length = string.size();
+
+    int year, month, day, hour, minute, second;
+
+    // Fast path for YYYY-MM-DDTHH:MM:SS[.fff](Z|+HH:MM|-HH:MM)
+    if( length >= 20
+        && p[4].unicode() == '-' && p[7].unicode() == '-' && p[10].unicode() == 'T'
+        && p[13].unicode() == ':' && p[16].unicode() == ':'
+        && parseDigits( p, 4, year ) && parseDigits( p + 5, 2, month ) && parseDigits( p + 8, 2, day )
+        && parseDigits( p + 11, 2, hour ) && parseDigits( p + 14, 2, minute )
+        && parseDigits( p + 17, 2, second )
+        && QDate::isValid( year, month, day ) && hour < 24 && minute < 60 && second < 60 )
+    {
+        int i = 19;
+        int msec = 0;
+
+        // Fractional seconds
+        if( p[i].unicode() == '.' )
+        {
+            int scale = 100;
+
+            for( ++i; i < length && p[i].unicode() >= '0' && p[i].unicode() <= '9'; ++i )
+            {
+                msec += (p[i].unicode() - '0') * scale;
+                scale /= 10;
+            }
+        }
+
+        // Time zone
+        bool valid = false;
+        qint64 offset = 0;
+
+        if( i + 1 == length && p[i].unicode() == 'Z' )
+            valid = true;
+        else if( i + 6 == length && (p[i].unicode() == '+' || p[i].unicode() == '-')
+                 && p[i + 3].unicode() == ':' )
+        {
+            int offsetHours, offsetMinutes;
+
+            if( parseDigits(p + i + 1, 2, offsetHours) && parseDigits(p + i + 4, 2, offsetMinutes) )
+            {
+                offset = (offsetHours * 60 + offsetMinutes) * 60 * 1000;
+
+                if( p[i].unicode() == '-' )
+                    offset = -offset;
+
+                valid = true;
+            }
+        }
+
+        if( valid )
+        {
+            const qint64 seconds = ((daysFromCivil(year, month, day) * 24 + hour) * 60 + minute) * 60 + second;
+            return fromMSecsSinceEpoch( seconds * 1000 + msec - offset );
+        }
+    }
+
+    // Fall back to QDateTime for all other formats
+    return Timestamp( QDateTime::fromString(string, Qt::ISODate) );
+}
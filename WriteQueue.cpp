@@ -0,0 +1,416 @@
+#include "Logging.h"
+#include "SimpleRedmineClient.h"
+#include "WriteQueue.h"
+
+#include <QJsonDocument>
+#include <QPair>
+#include <QPointer>
+#include <QSaveFile>
+#include <QSet>
+
+using namespace qtredmine;
+
+namespace {
+
+/// Names of the resources in the log file
+const char* RESOURCE_NAMES[] = { "issue", "time_entry" };
+
+} // namespace
+
+WriteQueue::WriteQueue( SimpleRedmineClient* redmine, QString path, QObject* parent )
+    : QObject( parent ),
+      redmine_( redmine ),
+      file_( path )
+{
+    ENTER()(path);
+
+    load();
+
+    retryTimer_.setSingleShot( true );
+    retryTimer_.setInterval( 30 * 1000 );
+    connect( &retryTimer_, &QTimer::timeout, this, &WriteQueue::replay );
+
+    // Resume replay as soon as Redmine is accessible again
+    connect( redmine_, &SimpleRedmineClient::connectionChanged, this,
+             [=]( QNetworkAccessManager::NetworkAccessibility connected )
+    {
+        if( connected == QNetworkAccessManager::Accessible )
+            replay();
+    } );
+
+    if( !pending_.isEmpty() && redmine_->connectionStatus() == QNetworkAccessManager::Accessible )
+        replay();
+
+    RETURN();
+}
+
+void
+WriteQueue::load()
+{
+    ENTER()(file_.fileName());
+
+    // Collect the writes that have not been completed
+    if( file_.open(QIODevice::ReadOnly) )
+    {
+        while( !file_.atEnd() )
+        {
+            // A record cut short by a crash is not valid JSON and therefore skipped
+            QJsonObject record = QJsonDocument::fromJson( file_.readLine() ).object();
+
+            if( record.isEmpty() )
+                continue;
+
+            qint64 seq = static_cast<qint64>( record.value("seq").toDouble() );
+            nextSeq_ = qMax( nextSeq_, seq + 1 );
+
+            // State changes of a write enqueued before
+            if( !record.contains("resource") )
+            {
+                for( int i = 0; i < pending_.size(); ++i )
+                {
+                    if( pending_[i].seq != seq )
+                        continue;
+
+                    if( record.value("done").toBool() )
+                        pending_.removeAt( i );
+                    else
+                        pending_[i].attempts = record.value("attempts").toInt( pending_[i].attempts );
+
+                    break;
+                }
+
+                continue;
+            }
+
+            Item item;
+            item.seq        = seq;
+            item.resource   = record.value("resource").toString() == QLatin1String(RESOURCE_NAMES[TIME_ENTRY])
+                              ? TIME_ENTRY : ISSUE;
+            item.id         = record.value("id").toInt( NULL_ID );
+            item.parameters = record.value("parameters").toString();
+            item.data       = QByteArray::fromBase64( record.value("data").toString().toLatin1() );
+            item.attempts   = record.value("attempts").toInt();
+            pending_.push_back( item );
+        }
+
+        file_.close();
+    }
+
+    DEBUG()(pending_.size());
+
+    // Compact the log file, replacing it atomically
+    QSaveFile compacted( file_.fileName() );
+
+    if( compacted.open(QIODevice::WriteOnly) )
+    {
+        for( const auto& item : pending_ )
+        {
+            compacted.write( QJsonDocument(toRecord(item)).toJson(QJsonDocument::Compact) );
+            compacted.write( "\n" );
+        }
+
+        compacted.commit();
+    }
+
+    if( !file_.open(QIODevice::WriteOnly | QIODevice::Append) )
+        DEBUG() << "Could not open write queue file:" << file_.errorString();
+
+    RETURN();
+}
+
+QJsonObject
+WriteQueue::toRecord( const Item& item )
+{
+    QJsonObject record;
+    record["seq"]        = static_cast<double>( item.seq );
+    record["resource"]   = RESOURCE_NAMES[item.resource];
+    record["id"]         = item.id;
+    record["parameters"] = item.parameters;
+    record["data"]       = QString::fromLatin1( item.data.toBase64() );
+    record["attempts"]   = item.attempts;
+
+    return record;
+}
+
+QJsonObject
+WriteQueue::toRecord( qint64 seq, const char* key, const QJsonValue& value )
+{
+    QJsonObject record;
+    record["seq"] = static_cast<double>( seq );
+    record[key]   = value;
+
+    return record;
+}
+
+void
+WriteQueue::append( const QJsonObject& record )
+{
+    if( !file_.isOpen() )
+        return;
+
+    // One record per line; flushed immediately so that it survives a crash of the process
+    file_.write( QJsonDocument(record).toJson(QJsonDocument::Compact) );
+    file_.write( "\n" );
+    file_.flush();
+}
+
+qint64
+WriteQueue::enqueue( Resource resource, QByteArray data, SuccessCb callback, int id, QString parameters,
+                     std::function<void(Issue&)> apply )
+{
+    ENTER()(resource)(id)(parameters);
+
+    Item item;
+    item.seq        = nextSeq_++;
+    item.resource   = resource;
+    item.id         = id;
+    item.parameters = parameters;
+    item.data       = data;
+    item.callback   = callback;
+    item.apply      = apply;
+
+    // Persist the write before sending it
+    append( toRecord(item) );
+
+    pending_.push_back( item );
+
+    if( !paused_ && redmine_->connectionStatus() != QNetworkAccessManager::NotAccessible )
+        replay();
+
+    RETURN( item.seq );
+}
+
+void
+WriteQueue::replay()
+{
+    ENTER()(pending_.size())(running_);
+
+    paused_ = false;
+    retryTimer_.stop();
+
+    // Resources with an earlier pending write; later writes to them have to wait
+    QSet<QPair<int, int>> busy;
+    QVector<qint64> startable;
+
+    for( const auto& item : pending_ )
+    {
+        if( running_ + startable.size() >= maxConcurrency_ )
+            break;
+
+        bool blocked = false;
+
+        // New resources cannot conflict with each other
+        if( item.id != NULL_ID )
+        {
+            QPair<int, int> key( item.resource, item.id );
+            blocked = busy.contains( key );
+            busy.insert( key );
+        }
+
+        if( !item.running && !blocked )
+            startable.push_back( item.seq );
+    }
+
+    for( qint64 seq : startable )
+    {
+        for( auto& item : pending_ )
+        {
+            if( item.seq == seq )
+            {
+                start( item );
+                break;
+            }
+        }
+    }
+
+    RETURN();
+}
+
+void
+WriteQueue::start( Item& item )
+{
+    ENTER()(item.seq)(item.resource)(item.id);
+
+    item.running = true;
+    ++running_;
+
+    // Persist the attempt before sending; a restored write with attempts may have reached Redmine
+    append( toRecord(item.seq, "attempts", ++item.attempts) );
+
+    QPointer<WriteQueue> self( this );
+    qint64 seq = item.seq;
+
+    auto cb = [self, seq]( bool success, int id, RedmineError redmineError, QStringList errors )
+    {
+        if( self )
+            self->finish( seq, success, id, redmineError, errors );
+    };
+
+    if( item.resource == TIME_ENTRY )
+        redmine_->sendTimeEntryData( item.data, cb, item.id, item.parameters );
+    else
+        redmine_->sendIssueData( item.data, cb, item.id, item.parameters, item.apply );
+
+    RETURN();
+}
+
+void
+WriteQueue::finish( qint64 seq, bool success, int id, RedmineError redmineError, QStringList errors )
+{
+    ENTER()(seq)(success)(id)(redmineError)(errors);
+
+    --running_;
+
+    int index = -1;
+    for( int i = 0; i < pending_.size(); ++i )
+    {
+        if( pending_[i].seq == seq )
+        {
+            index = i;
+            break;
+        }
+    }
+
+    if( index == -1 )
+        RETURN();
+
+    // Without an HTTP reply, the write did not get through; keep it and retry later
+    if( !success && redmineError == RedmineError::ERR_UNREACHABLE )
+    {
+        DEBUG() << "Redmine not reachable, pausing replay";
+
+        pending_[index].running = false;
+        paused_ = true;
+        retryTimer_.start();
+
+        RETURN();
+    }
+
+    Item item = pending_.takeAt( index );
+
+    append( toRecord(seq, "done", true) );
+
+    if( item.callback )
+        item.callback( success, id, redmineError, errors );
+
+    // The written fields of a restored write cannot be applied, so the stored issue is refreshed
+    if( success && item.resource == ISSUE && !item.apply && id != NULL_ID && redmine_->issueStore() )
+        redmine_->retrieveIssue( []( Issue, RedmineError, QStringList ){}, id );
+
+    DEBUG( "Emitting signal replayed()" )(seq)(success);
+    emit replayed( seq, success, id, redmineError, errors );
+
+    if( pending_.isEmpty() )
+    {
+        // Nothing left to replay, so the log can start over
+        if( file_.isOpen() )
+            file_.resize( 0 );
+
+        DEBUG( "Emitting signal drained()" );
+        emit drained();
+    }
+    else if( !paused_ )
+        replay();
+
+    RETURN();
+}
+
+bool
+WriteQueue::isDurable() const
+{
+    return file_.isOpen();
+}
+
+int
+WriteQueue::size() const
+{
+    return pending_.size();
+}
+
+int
+WriteQueue::maxConcurrency() const
+{
+    return maxConcurrency_;
+}
+
+void
+WriteQueue::setMaxConcurrency( int maxConcurrency )
+{
+    ENTER()(maxConcurrency);
+
+    maxConcurrency_ = qMax( maxConcurrency, 1 );
+
+    RETURN();
+}
+
+int
+WriteQueue::retryInterval() const
+{
+    return retryTimer_.interval();
+}
+
+void
+WriteQueue::setRetryInterval( int msecs )
+{
+    ENTER()(msecs);
+
+    retryTimer_.setInterval( msecs );
+
+    RETURN();
+}
+
+qint64
+WriteQueue::sendIssue( Issue item, SuccessCb callback, int id, QString parameters )
+{
+    ENTER()(id)(parameters);
+
+    auto apply = [item]( Issue& issue ){ mergeFields( issue, item ); };
+
+    qint64 seq = enqueue( ISSUE, requestBody(item), callback, id, parameters, apply );
+
+    RETURN( seq );
+}
+
+qint64
+WriteQueue::updateIssue( Issue item, Issue original, SuccessCb callback, QString parameters )
+{
+    ENTER()(item.id)(parameters);
+
+    if( item.id == NULL_ID )
+    {
+        DEBUG() << "No issue ID specified";
+
+        if( callback )
+            callback( false, NULL_ID, RedmineError::ERR_INCOMPLETE_DATA, QStringList() );
+
+        RETURN( 0 );
+    }
+
+    int changes = 0;
+    QByteArray data = patchBody( item, original, &changes );
+
+    // Nothing to update
+    if( !changes )
+    {
+        if( callback )
+            callback( true, item.id, RedmineError::NO_ERR, QStringList() );
+
+        RETURN( 0 );
+    }
+
+    auto apply = [item, original]( Issue& issue ){ mergeFields( issue, item, original ); };
+
+    qint64 seq = enqueue( ISSUE, data, callback, item.id, parameters, apply );
+
+    RETURN( seq );
+}
+
+qint64
+WriteQueue::sendTimeEntry( TimeEntry item, SuccessCb callback, int id, QString parameters )
+{
+    ENTER()(id)(parameters);
+
+    qint64 seq = enqueue( TIME_ENTRY, requestBody(item), callback, id, parameters );
+
+    RETURN( seq );
+}
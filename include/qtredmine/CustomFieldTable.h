@@ -0,0 +1,111 @@
+#ifndef CUSTOMFIELDTABLE_H
+#define CUSTOMFIELDTABLE_H
+
+#include "qtredmine_global.h"
+
+#include "SimpleRedmineTypes.h"
+
+#include <QHash>
+#include <QReadWriteLock>
+
+namespace qtredmine {
+
+/**
+ * @brief Shared table of custom field definitions
+ *
+ * Custom field values in issues and time entries only carry the custom field ID, their values and
+ * the table of their Redmine server. The definitions are stored once in this table: they are added
+ * with the information available in the resource when a custom field is first seen while parsing,
+ * and replaced by the complete definition when custom fields are retrieved using
+ * SimpleRedmineClient::retrieveCustomFields().
+ *
+ * Custom field IDs are only unique per Redmine server, so there is one table per server, see
+ * forServer(). Tables are never destroyed, so that custom field values can refer to them for as long
+ * as they exist.
+ *
+ * The table is thread-safe.
+ */
+class QTREDMINESHARED_EXPORT CustomFieldTable
+{
+private:
+    /// Custom field definitions by ID
+    QHash<int, CustomField> fields_;
+
+    /// Lock protecting the table
+    mutable QReadWriteLock lock_;
+
+public:
+    /**
+     * @brief Add or replace a custom field definition
+     *
+     * @param field Custom field definition
+     */
+    void insert( const CustomField& field );
+
+    /**
+     * @brief Add a custom field definition if the custom field is not yet known
+     *
+     * @param id       Custom field ID
+     * @param name     Custom field name
+     * @param type     Customised type
+     * @param multiple Custom field may contain multiple values
+     */
+    void insertIfMissing( int id, const QString& name, const QString& type, bool multiple );
+
+    /**
+     * @brief Check whether a custom field is known
+     *
+     * @param id Custom field ID
+     *
+     * @return true if the custom field is known, false otherwise
+     */
+    bool contains( int id ) const;
+
+    /**
+     * @brief Get a custom field definition
+     *
+     * @param id Custom field ID
+     *
+     * @return Custom field definition; empty if the custom field is unknown
+     */
+    CustomField value( int id ) const;
+
+    /**
+     * @brief Get a custom field name
+     *
+     * @param id Custom field ID
+     *
+     * @return Custom field name; empty if the custom field is unknown
+     */
+    QString name( int id ) const;
+
+    /**
+     * @brief Get all custom field definitions
+     *
+     * @return Custom field definitions in ascending ID order
+     */
+    CustomFields values() const;
+
+    /**
+     * @brief Get the default custom field table
+     *
+     * The default table is used for custom field values that do not belong to a Redmine server, e.g.
+     * values created by the application.
+     *
+     * @return Default custom field table
+     */
+    static CustomFieldTable& instance();
+
+    /**
+     * @brief Get the custom field table of a Redmine server
+     *
+     * @param url Redmine base URL
+     *
+     * @return Custom field table of the server; created on first use
+     */
+    static CustomFieldTable& forServer( const QString& url );
+};
+
+} // qtredmine
+
+#endif // CUSTOMFIELDTABLE_H
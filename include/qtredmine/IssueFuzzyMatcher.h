@@ -0,0 +1,151 @@
+#ifndef ISSUEFUZZYMATCHER_H
+#define ISSUEFUZZYMATCHER_H
+
+#include "qtredmine_global.h"
+
+#include "SimpleRedmineTypes.h"
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QVector>
+
+namespace qtredmine {
+
+class IssueStore;
+
+/**
+ * @brief Trigram-based fuzzy matcher for issue quick-search
+ *
+ * Issues are matched by subject, ID and project name. Each field is split into words, and every
+ * word is padded and decomposed into trigrams, i.e. sequences of three characters. A query matches
+ * an issue field if they share trigrams, so that typing errors, missing characters and swapped
+ * characters still produce a match:
+ *
+ * - The score of a field is mostly the share of the query trigrams it contains, with a smaller
+ *   part for its similarity to the query as a whole, so that shorter fields rank higher.
+ * - The score of an issue is the best score of its fields; project names are weighted slightly
+ *   lower, so that subject matches come first.
+ * - A query that is an issue ID, e.g. \c 1234 or \c #1234, always ranks that issue first.
+ *
+ * Issues are kept in slots that are reused after removal; each field has an inverted index from
+ * trigrams to the sorted slots containing them. Inserting, replacing or removing an issue only
+ * touches the postings of its own trigrams.
+ *
+ * A matcher attached to an IssueStore follows it, like IssueTextIndex.
+ */
+class QTREDMINESHARED_EXPORT IssueFuzzyMatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// Matched fields
+    enum Field
+    {
+        SUBJECT,
+        ID,
+        PROJECT,
+        FIELD_COUNT,
+    };
+    Q_ENUM( Field )
+
+    /// Matching issue
+    struct Match
+    {
+        int    id = NULL_ID;    ///< Issue ID
+        double score = 0;       ///< Score between 0 and 1
+        Field  field = SUBJECT; ///< Best matching field
+    };
+
+    /// Match vector
+    using Matches = QVector<Match>;
+
+    /// Minimum share of the query trigrams a field has to contain to match
+    static constexpr double MIN_COVERAGE = 1.0 / 3;
+
+private:
+    /// Slots by issue ID
+    QHash<int, int> slots_;
+
+    /// Issue IDs by slot; \c NULL_ID for free slots
+    QVector<int> ids_;
+
+    /// Free slots
+    QVector<int> freeSlots_;
+
+    /// Field texts by field and slot
+    QVector<QString> texts_[FIELD_COUNT];
+
+    /// Number of distinct trigrams by field and slot
+    QVector<int> trigramCounts_[FIELD_COUNT];
+
+    /// Inverted indexes by field, mapping each trigram to the sorted slots containing it
+    QHash<quint64, QVector<int>> postings_[FIELD_COUNT];
+
+    /// Issue store followed by the matcher
+    QPointer<IssueStore> store_;
+
+    /// Replace the indexed text of a field
+    void setText( int field, int slot, const QString& text );
+
+    /// Index the issues of the store with the given IDs
+    void insertFromStore( QVector<int> ids );
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param store  Issue store to follow; its issues are indexed immediately (default: none)
+     * @param parent Parent QObject (default: nullptr)
+     */
+    explicit IssueFuzzyMatcher( IssueStore* store = nullptr, QObject* parent = nullptr );
+
+    /// @name Modification
+    /// @{
+
+    /**
+     * @brief Insert or replace an issue
+     *
+     * @param issue Issue; must have an ID
+     */
+    void insert( const Issue& issue );
+
+    /**
+     * @brief Insert or replace issues
+     *
+     * @param issues Issues; issues without an ID are ignored
+     */
+    void insert( const Issues& issues );
+
+    /**
+     * @brief Remove an issue
+     *
+     * @param id Issue ID
+     */
+    void remove( int id );
+
+    /**
+     * @brief Remove all issues
+     */
+    void clear();
+
+    /// @}
+
+    /// @return Number of indexed issues
+    int size() const;
+
+    /**
+     * @brief Search issues
+     *
+     * @param query Search text, e.g. part of a subject, an issue ID or a project name
+     * @param limit Maximum number of results (default: 10)
+     *
+     * @return Best matches, highest score first
+     */
+    Matches search( const QString& query, int limit = 10 ) const;
+};
+
+} // qtredmine
+
+#endif // ISSUEFUZZYMATCHER_H
@@ -0,0 +1,208 @@
+#ifndef ISSUEHIERARCHY_H
+#define ISSUEHIERARCHY_H
+
+#include "qtredmine_global.h"
+
+#include "SimpleRedmineTypes.h"
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QVector>
+
+namespace qtredmine {
+
+class IssueStore;
+
+/**
+ * @brief Parent/child index over issues with subtree rollups
+ *
+ * Every issue is linked to its parent by Issue::parentId. Each issue keeps the rollup of its
+ * subtree, i.e. of itself and all its descendants, which is updated along the ancestor chain
+ * whenever an issue is inserted, modified, moved or removed:
+ *
+ * - children(), descendants() and ancestors() take time proportional to their result.
+ * - rollup() takes constant time; inserting, modifying or removing an issue takes time
+ *   proportional to its depth.
+ *
+ * A parent that is not indexed itself, e.g. because it belongs to another project, is kept as a
+ * placeholder while it has indexed children, so that their subtree can still be queried. A parent
+ * that would close a cycle, e.g. while an issue moved between two retrievals, is not linked until
+ * the cycle is resolved.
+ *
+ * An index attached to an IssueStore follows it, like IssueTextIndex.
+ */
+class QTREDMINESHARED_EXPORT IssueHierarchy : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// Aggregates over a subtree
+    struct Rollup
+    {
+        int    issueCount = 0;         ///< Number of indexed issues
+        double estimatedHours = 0;     ///< Sum of the estimated hours
+        double doneHours = 0;          ///< Sum of the estimated hours times the done ratio
+        double doneRatioSum = 0;       ///< Sum of the done ratios
+
+        /**
+         * @brief Get the done ratio of the subtree
+         *
+         * @return Done ratio weighted by estimated hours, between 0 and 100; the mean done ratio if
+         *         no issue has an estimate
+         */
+        double doneRatio() const;
+    };
+
+private:
+    /// Node of the hierarchy
+    struct Node
+    {
+        int          parentId = NULL_ID;  ///< Parent issue ID
+        bool         linked = false;      ///< Whether the node is a child of its parent
+        bool         indexed = false;     ///< Whether the issue is indexed or only a placeholder
+        double       estimatedHours = 0;  ///< Estimated hours of the issue itself
+        double       doneRatio = 0;       ///< Done ratio of the issue itself
+        QVector<int> children;            ///< IDs of the linked children
+        Rollup       rollup;              ///< Rollup of the subtree
+    };
+
+    /// Nodes by issue ID
+    QHash<int, Node> nodes_;
+
+    /// Number of indexed issues
+    int size_ = 0;
+
+    /// IDs of the nodes whose parent would close a cycle
+    QSet<int> unlinked_;
+
+    /// Issue store followed by the index
+    QPointer<IssueStore> store_;
+
+    /// Add the rollup of a node to its parent and the parent's ancestors
+    void link( int id );
+
+    /// Subtract the rollup of a node from its ancestors and detach it from its parent
+    void unlink( int id );
+
+    /// Check whether a node is an ancestor of another one or the node itself
+    bool isAncestor( int ancestor, int id ) const;
+
+    /// Remove a placeholder without children
+    void prune( int id );
+
+    /// Set the values of a node and update the rollups
+    void update( int id, int parentId, double estimatedHours, double doneRatio, bool indexed );
+
+    /// Index the issues of the store with the given IDs
+    void insertFromStore( QVector<int> ids );
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param store  Issue store to follow; its issues are indexed immediately (default: none)
+     * @param parent Parent QObject (default: nullptr)
+     */
+    explicit IssueHierarchy( IssueStore* store = nullptr, QObject* parent = nullptr );
+
+    /// @name Modification
+    /// @{
+
+    /**
+     * @brief Insert or replace an issue
+     *
+     * @param issue Issue; must have an ID
+     */
+    void insert( const Issue& issue );
+
+    /**
+     * @brief Insert or replace issues
+     *
+     * @param issues Issues; issues without an ID are ignored
+     */
+    void insert( const Issues& issues );
+
+    /**
+     * @brief Remove an issue
+     *
+     * Children of the issue remain in its subtree.
+     *
+     * @param id Issue ID
+     */
+    void remove( int id );
+
+    /**
+     * @brief Remove all issues
+     */
+    void clear();
+
+    /// @}
+
+    /// @name Lookup
+    /// @{
+
+    /// @return Number of indexed issues
+    int size() const;
+
+    /**
+     * @brief Check whether an issue is indexed
+     *
+     * @param id Issue ID
+     *
+     * @return true if indexed, false otherwise, also for placeholders
+     */
+    bool contains( int id ) const;
+
+    /**
+     * @brief Get the parent of an issue
+     *
+     * @param id Issue ID
+     *
+     * @return Parent issue ID, or \c NULL_ID for root and unknown issues
+     */
+    int parent( int id ) const;
+
+    /**
+     * @brief Get the children of an issue
+     *
+     * @param id Issue ID; may be a placeholder
+     *
+     * @return IDs of the indexed children in no particular order
+     */
+    QVector<int> children( int id ) const;
+
+    /**
+     * @brief Get the descendants of an issue
+     *
+     * @param id Issue ID; may be a placeholder
+     *
+     * @return IDs of the indexed descendants, each before its own descendants
+     */
+    QVector<int> descendants( int id ) const;
+
+    /**
+     * @brief Get the ancestors of an issue
+     *
+     * @param id Issue ID
+     *
+     * @return IDs of the ancestors, nearest first; the last one may be a placeholder
+     */
+    QVector<int> ancestors( int id ) const;
+
+    /**
+     * @brief Get the rollup of the subtree of an issue
+     *
+     * @param id Issue ID; may be a placeholder
+     *
+     * @return Rollup of the issue and its descendants; empty for unknown issues
+     */
+    Rollup rollup( int id ) const;
+
+    /// @}
+};
+
+} // qtredmine
+
+#endif // ISSUEHIERARCHY_H
@@ -0,0 +1,191 @@
+#ifndef ISSUESNAPSHOT_H
+#define ISSUESNAPSHOT_H
+
+#include "qtredmine_global.h"
+
+#include "SimpleRedmineTypes.h"
+
+#include <QFile>
+#include <QString>
+
+namespace qtredmine {
+
+/// Metadata stored alongside the issues of a snapshot
+struct SnapshotMetadata
+{
+    IssueStatuses issueStatuses;       ///< Issue statuses
+    Trackers      trackers;            ///< Trackers
+    Enumerations  issuePriorities;     ///< Issue priorities
+    Enumerations  timeEntryActivities; ///< Time entry activities
+    CustomFields  customFields;        ///< Custom field definitions, see CustomFieldTable::values()
+    Timestamp     syncCursor;          ///< Cursor of the last synchronisation, see SimpleRedmineClient::syncIssues()
+};
+
+/**
+ * @brief Memory-mapped binary snapshot of an issue cache
+ *
+ * A snapshot file consists of a header followed by sections:
+ *
+ * - One fixed-size record per issue, sorted by ID. Items are stored as ID and name reference,
+ *   times and dates as 64-bit values.
+ * - The custom field values of all issues.
+ * - The metadata as fixed-size records.
+ * - The custom field definitions as fixed-size records, with their possible values, projects and
+ *   trackers.
+ * - A heap of interned UTF-16 strings, referenced by 32-bit byte offset. Every distinct string is
+ *   stored only once. write() fails if the strings do not fit.
+ *
+ * Opening a snapshot maps the file into memory and only validates the header, so it takes the same
+ * time regardless of the number of issues. Records are decoded when they are accessed, and only the
+ * pages containing them are read from disk.
+ *
+ * The format is versioned and stored in host byte order; snapshots written by a different version or
+ * on a host with a different byte order are rejected by open().
+ *
+ * SimpleRedmineClient::saveSnapshot() and SimpleRedmineClient::loadSnapshot() save and restore the
+ * issue store of a client together with its metadata.
+ */
+class QTREDMINESHARED_EXPORT IssueSnapshot
+{
+public:
+    /// Version of the snapshot format
+    static const quint32 VERSION = 2;
+
+private:
+    struct Header;
+    struct Record;
+    struct CustomFieldRecord;
+    struct MetadataRecord;
+    struct DefinitionRecord;
+
+    /// Snapshot file
+    QFile file_;
+
+    /// Mapped file contents
+    const uchar* data_ = nullptr;
+
+    /// Size of the mapped file
+    qint64 size_ = 0;
+
+    /// Header
+    const Header* header_ = nullptr;
+
+    /// Issue records
+    const Record* records_ = nullptr;
+
+    /// Get a string from the string heap
+    QString string( quint32 ref ) const;
+
+    /// Get an item name from the string heap, interned in the item name pool
+    QString itemName( quint32 ref ) const;
+
+    /// Decode the metadata records of a section
+    template<typename T>
+    QVector<T> metadataRecords( int section ) const;
+
+    /// Decode the custom field definitions
+    CustomFields definitions() const;
+
+public:
+    /**
+     * @brief Constructor for a closed snapshot
+     */
+    IssueSnapshot() = default;
+
+    /**
+     * @brief Destructor, unmapping the file
+     */
+    ~IssueSnapshot();
+
+    /**
+     * @brief Write a snapshot file
+     *
+     * The file is replaced atomically. Issues without an ID are skipped.
+     *
+     * @param path     Path of the snapshot file
+     * @param issues   Issues
+     * @param metadata Metadata (default: none)
+     *
+     * @return true on success, false otherwise
+     */
+    static bool write( const QString& path, const Issues& issues, const SnapshotMetadata& metadata = SnapshotMetadata() );
+
+    /**
+     * @brief Open and map a snapshot file
+     *
+     * A previously opened snapshot is closed first.
+     *
+     * @param path Path of the snapshot file
+     *
+     * @return true on success, false if the file cannot be mapped or is not a valid snapshot
+     */
+    bool open( const QString& path );
+
+    /**
+     * @brief Close the snapshot, unmapping the file
+     */
+    void close();
+
+    /// @return true if a snapshot is open, false otherwise
+    bool isOpen() const;
+
+    /// @return Number of issues
+    int size() const;
+
+    /**
+     * @brief Get the ID of an issue without decoding it
+     *
+     * @param row Row number, in ascending ID order
+     *
+     * @return Issue ID
+     */
+    int id( int row ) const;
+
+    /**
+     * @brief Get the update time of an issue without decoding it
+     *
+     * @param row Row number, in ascending ID order
+     *
+     * @return Update time
+     */
+    Timestamp updatedOn( int row ) const;
+
+    /**
+     * @brief Find the row of an issue by binary search
+     *
+     * @param id Issue ID
+     *
+     * @return Row number, or -1 if not found
+     */
+    int indexOf( int id ) const;
+
+    /**
+     * @brief Decode an issue
+     *
+     * @param row   Row number, in ascending ID order
+     * @param table Custom field table the custom field values refer to; nullptr for the default table
+     *
+     * @return Issue
+     */
+    Issue issue( int row, const CustomFieldTable* table = nullptr ) const;
+
+    /**
+     * @brief Decode all issues
+     *
+     * @param table Custom field table the custom field values refer to; nullptr for the default table
+     *
+     * @return Issues in ascending ID order
+     */
+    Issues issues( const CustomFieldTable* table = nullptr ) const;
+
+    /**
+     * @brief Decode the metadata
+     *
+     * @return Metadata
+     */
+    SnapshotMetadata metadata() const;
+};
+
+} // qtredmine
+
+#endif // ISSUESNAPSHOT_H
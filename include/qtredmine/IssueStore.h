@@ -0,0 +1,283 @@
+#ifndef ISSUESTORE_H
+#define ISSUESTORE_H
+
+#include "qtredmine_global.h"
+
+#include "SimpleRedmineTypes.h"
+
+#include <QHash>
+#include <QObject>
+#include <QVector>
+
+#include <iterator>
+
+namespace qtredmine {
+
+/**
+ * @brief Indexed in-memory issue store
+ *
+ * Keeps issues in one contiguous vector with an ID lookup table and secondary indexes on project,
+ * status, tracker, assignee and version:
+ *
+ * - find() and contains() take constant time.
+ * - Queries return a View onto the store. The view iterates over the matching issues in place,
+ *   so no issues are copied.
+ * - Inserting or removing an issue only updates the index entries of its own keys.
+ *
+ * Issues without a value for an indexed field are indexed under \c NULL_ID, e.g. unassigned issues
+ * are returned by byAssignee( NULL_ID ).
+ *
+ * Views and pointers returned by the store are invalidated by the next modification.
+ *
+ * The store can be fed automatically by SimpleRedmineClient::setIssueStore().
+ */
+class QTREDMINESHARED_EXPORT IssueStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// Secondary indexes
+    enum Index
+    {
+        PROJECT,
+        STATUS,
+        TRACKER,
+        ASSIGNEE,
+        VERSION,
+        INDEX_COUNT,
+    };
+    Q_ENUM( Index )
+
+    /**
+     * @brief View onto a set of issues in the store
+     */
+    class QTREDMINESHARED_EXPORT View
+    {
+    private:
+        /// Store containing the issues
+        const IssueStore* store_ = nullptr;
+
+        /// IDs of the issues
+        const QVector<int>* ids_ = nullptr;
+
+    public:
+        /// Iterator over the issues of a view
+        class const_iterator
+        {
+        private:
+            const IssueStore* store_ = nullptr;
+            QVector<int>::const_iterator it_;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = Issue;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = const Issue*;
+            using reference         = const Issue&;
+
+            const_iterator() = default;
+            const_iterator( const IssueStore* store, QVector<int>::const_iterator it )
+                : store_( store ), it_( it ) {}
+
+            reference operator*() const { return *store_->find( *it_ ); }
+            pointer operator->() const { return store_->find( *it_ ); }
+
+            const_iterator& operator++() { ++it_; return *this; }
+            const_iterator operator++( int ) { const_iterator old = *this; ++it_; return old; }
+
+            bool operator==( const const_iterator& other ) const { return it_ == other.it_; }
+            bool operator!=( const const_iterator& other ) const { return it_ != other.it_; }
+        };
+
+        /**
+         * @brief Constructor for an empty view
+         */
+        View() = default;
+
+        /**
+         * @brief Constructor
+         *
+         * @param store Store containing the issues
+         * @param ids   IDs of the issues; must be owned by the store
+         */
+        View( const IssueStore* store, const QVector<int>* ids )
+            : store_( store ), ids_( ids ) {}
+
+        /// @return Number of issues in the view
+        int size() const { return ids_ ? ids_->size() : 0; }
+
+        /// @return true if the view contains no issues, false otherwise
+        bool isEmpty() const { return size() == 0; }
+
+        /// @return Issue at position \c i of the view
+        const Issue& at( int i ) const { return *store_->find( ids_->at(i) ); }
+
+        /// @return Iterator to the first issue
+        const_iterator begin() const { return ids_ ? const_iterator( store_, ids_->constBegin() ) : const_iterator(); }
+
+        /// @return Iterator after the last issue
+        const_iterator end() const { return ids_ ? const_iterator( store_, ids_->constEnd() ) : const_iterator(); }
+
+        /// @return IDs of the issues in the view
+        QVector<int> ids() const { return ids_ ? *ids_ : QVector<int>(); }
+
+        /// @return Copies of the issues in the view
+        Issues toIssues() const;
+    };
+
+private:
+    /// Issues
+    Issues issues_;
+
+    /// Positions of the issues in \c issues_ by ID
+    QHash<int, int> positions_;
+
+    /// Secondary indexes, mapping a key to the IDs of the issues having it
+    QHash<int, QVector<int>> indexes_[INDEX_COUNT];
+
+    /// Get the key of an issue in an index
+    static int key( const Issue& issue, Index index );
+
+    /// Add an issue to an index
+    void addToIndex( Index index, int key, int id );
+
+    /// Remove an issue from an index
+    void removeFromIndex( Index index, int key, int id );
+
+    /// Insert or replace a single issue without emitting signals; returns true if the store changed
+    bool insertIssue( const Issue& issue );
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param parent Parent QObject (default: nullptr)
+     */
+    explicit IssueStore( QObject* parent = nullptr );
+
+    /// @name Modification
+    /// @{
+
+    /**
+     * @brief Insert or replace an issue
+     *
+     * @param issue Issue; must have an ID
+     *
+     * @return true if the issue is new or differs from the stored one, false otherwise
+     */
+    bool insert( const Issue& issue );
+
+    /**
+     * @brief Insert or replace issues
+     *
+     * The issuesChanged() signal is emitted once for all new or modified issues.
+     *
+     * @param issues Issues; issues without an ID are ignored
+     *
+     * @return Number of new or modified issues
+     */
+    int insert( const Issues& issues );
+
+    /**
+     * @brief Remove an issue
+     *
+     * @param id Issue ID
+     *
+     * @return true if the issue was stored, false otherwise
+     */
+    bool remove( int id );
+
+    /**
+     * @brief Remove all issues
+     *
+     * Item names no longer referenced anywhere are removed from StringPool::itemNames().
+     */
+    void clear();
+
+    /// @}
+
+    /// @name Lookup
+    /// @{
+
+    /**
+     * @brief Find an issue by ID
+     *
+     * @param id Issue ID
+     *
+     * @return Pointer to the stored issue, or nullptr if not found
+     */
+    const Issue* find( int id ) const;
+
+    /**
+     * @brief Check whether an issue is stored
+     *
+     * @param id Issue ID
+     *
+     * @return true if stored, false otherwise
+     */
+    bool contains( int id ) const;
+
+    /// @return Number of stored issues
+    int size() const;
+
+    /// @return true if no issues are stored, false otherwise
+    bool isEmpty() const;
+
+    /**
+     * @brief Get all stored issues
+     *
+     * @return Issues in no particular order
+     */
+    const Issues& issues() const;
+
+    /**
+     * @brief Query a secondary index
+     *
+     * @param index Index to query
+     * @param key   ID of the project, status, tracker, user or version
+     *
+     * @return View onto the matching issues
+     */
+    View query( Index index, int key ) const;
+
+    View byProject( int projectId ) const { return query( PROJECT, projectId ); }    ///< Issues of a project
+    View byStatus( int statusId ) const { return query( STATUS, statusId ); }        ///< Issues with a status
+    View byTracker( int trackerId ) const { return query( TRACKER, trackerId ); }    ///< Issues of a tracker
+    View byAssignee( int userId ) const { return query( ASSIGNEE, userId ); }        ///< Issues assigned to a user
+    View byVersion( int versionId ) const { return query( VERSION, versionId ); }    ///< Issues of a version
+
+    /**
+     * @brief Get the keys present in a secondary index
+     *
+     * @param index Index
+     *
+     * @return Keys in no particular order
+     */
+    QList<int> keys( Index index ) const;
+
+    /// @}
+
+signals:
+    /**
+     * @brief Signal that issues have been inserted or modified
+     *
+     * @param ids IDs of the new or modified issues
+     */
+    void issuesChanged( QVector<int> ids );
+
+    /**
+     * @brief Signal that issues have been removed
+     *
+     * @param ids IDs of the removed issues
+     */
+    void issuesRemoved( QVector<int> ids );
+
+    /**
+     * @brief Signal that all issues have been removed
+     */
+    void cleared();
+};
+
+} // qtredmine
+
+#endif // ISSUESTORE_H
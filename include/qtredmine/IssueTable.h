@@ -0,0 +1,196 @@
+#ifndef ISSUETABLE_H
+#define ISSUETABLE_H
+
+#include "qtredmine_global.h"
+
+#include "SimpleRedmineTypes.h"
+
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+#include <QStringRef>
+#include <QVector>
+
+#include <functional>
+#include <limits>
+
+namespace qtredmine {
+
+/**
+ * @brief Column of strings stored in one shared arena
+ *
+ * All strings of the column are stored back to back in a single buffer, so that a column of
+ * 100k subjects costs two allocations instead of 100k.
+ */
+class QTREDMINESHARED_EXPORT StringColumn
+{
+private:
+    /// Characters of all strings
+    QString arena_;
+
+    /// Start offsets of the strings in the arena, followed by the arena size
+    QVector<int> offsets_ = QVector<int>( 1, 0 );
+
+public:
+    /**
+     * @brief Append a string
+     *
+     * @param string String to append
+     */
+    void append( const QString& string );
+
+    /**
+     * @brief Get a string as a reference into the arena
+     *
+     * @param row Row number
+     *
+     * @return String reference, valid as long as the column is not modified
+     */
+    QStringRef at( int row ) const;
+
+    /**
+     * @brief Get a string as a copy
+     *
+     * @param row Row number
+     *
+     * @return String
+     */
+    QString value( int row ) const;
+
+    /**
+     * @brief Reserve space
+     *
+     * @param rows       Expected number of rows
+     * @param characters Expected total number of characters
+     */
+    void reserve( int rows, int characters = 0 );
+
+    /**
+     * @brief Remove all strings
+     */
+    void clear();
+
+    /**
+     * @brief Get the number of strings
+     *
+     * @return Number of strings
+     */
+    int size() const;
+};
+
+/**
+ * @brief Columnar issue container
+ *
+ * Stores issues as a struct of arrays: each field is kept in its own contiguous vector, indexed by
+ * row. Scanning a single field (e.g. filtering by status or summing estimated hours) therefore only
+ * touches the memory of that field.
+ *
+ * Item names are stored once per ID in name dictionaries; subjects and descriptions are stored in
+ * string arenas. Custom fields are not part of the table.
+ */
+struct QTREDMINESHARED_EXPORT IssueTable
+{
+    /// Value of time and date columns for invalid times and dates
+    static const qint64 NULL_TIME = std::numeric_limits<qint64>::min();
+
+    /// @name ID columns
+    /// @{
+
+    QVector<int> ids;           ///< Issue IDs
+    QVector<int> parentIds;     ///< Parent issue IDs
+    QVector<int> assignedToIds; ///< Assigned to user IDs
+    QVector<int> authorIds;     ///< Author IDs
+    QVector<int> categoryIds;   ///< Category IDs
+    QVector<int> priorityIds;   ///< Priority IDs
+    QVector<int> projectIds;    ///< Project IDs
+    QVector<int> statusIds;     ///< Status IDs
+    QVector<int> trackerIds;    ///< Tracker IDs
+    QVector<int> versionIds;    ///< Version IDs
+
+    /// @}
+
+    /// @name Value columns
+    /// @{
+
+    QVector<qint64> createdOn;      ///< Creation times in milliseconds since epoch or \c NULL_TIME
+    QVector<qint64> updatedOn;      ///< Update times in milliseconds since epoch or \c NULL_TIME
+    QVector<qint64> startDates;     ///< Start dates as Julian days or \c NULL_TIME
+    QVector<qint64> dueDates;       ///< Due dates as Julian days or \c NULL_TIME
+    QVector<double> doneRatios;     ///< Done ratios
+    QVector<double> estimatedHours; ///< Estimated hours
+
+    StringColumn subjects;     ///< Subjects
+    StringColumn descriptions; ///< Descriptions
+
+    /// @}
+
+    /// @name Name dictionaries
+    /// @{
+
+    QHash<int, QString> categoryNames; ///< Category names by ID
+    QHash<int, QString> priorityNames; ///< Priority names by ID
+    QHash<int, QString> projectNames;  ///< Project names by ID
+    QHash<int, QString> statusNames;   ///< Status names by ID
+    QHash<int, QString> trackerNames;  ///< Tracker names by ID
+    QHash<int, QString> userNames;     ///< User names by ID (authors and assignees)
+    QHash<int, QString> versionNames;  ///< Version names by ID
+
+    /// @}
+
+    /**
+     * @brief Append an issue
+     *
+     * @param issue Issue to append
+     */
+    void append( const Issue& issue );
+
+    /**
+     * @brief Append an issue directly from its Redmine JSON representation
+     *
+     * @param obj JSON object of the issue
+     */
+    void append( const QJsonObject& obj );
+
+    /**
+     * @brief Assemble the issue of a row
+     *
+     * @param row Row number
+     *
+     * @return Issue without custom fields
+     */
+    Issue issue( int row ) const;
+
+    /**
+     * @brief Reserve space in all columns
+     *
+     * @param rows Expected number of rows
+     */
+    void reserve( int rows );
+
+    /**
+     * @brief Remove all rows and names
+     */
+    void clear();
+
+    /**
+     * @brief Get the number of rows
+     *
+     * @return Number of rows
+     */
+    int size() const;
+};
+
+/**
+ * Typedef for an issue table callback function
+ *
+ * @param IssueTable Columnar issue container
+ * @param RedmineError Redmine error code
+ * @param QStringList Errors that Redmine returned
+ */
+using IssueTableCb = std::function<void(IssueTable, RedmineError, QStringList)>;
+
+} // qtredmine
+
+Q_DECLARE_METATYPE( qtredmine::IssueTable )
+
+#endif // ISSUETABLE_H
@@ -0,0 +1,154 @@
+#ifndef ISSUETEXTINDEX_H
+#define ISSUETEXTINDEX_H
+
+#include "qtredmine_global.h"
+
+#include "SimpleRedmineTypes.h"
+
+#include <QHash>
+#include <QMap>
+#include <QObject>
+#include <QPointer>
+#include <QStringList>
+#include <QVector>
+
+namespace qtredmine {
+
+class IssueStore;
+
+/**
+ * @brief In-memory inverted full-text index over issue subjects and descriptions
+ *
+ * Subjects and descriptions are split into tokens, i.e. runs of letters and digits, which are
+ * case-folded. Each field keeps a sorted token dictionary mapping every token to the sorted IDs of
+ * the issues containing it:
+ *
+ * - A query term matches all tokens it is a prefix of, so that results can be shown while typing.
+ * - A query matches the issues containing all of its terms, in any of the searched fields.
+ * - Inserting, replacing or removing an issue only touches the postings of its own tokens.
+ *
+ * An index attached to an IssueStore follows it: issues inserted into or removed from the store are
+ * inserted into or removed from the index. With SimpleRedmineClient::setIssueStore(), the index is
+ * thereby fed by the issue retrievers.
+ */
+class QTREDMINESHARED_EXPORT IssueTextIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// Indexed fields
+    enum Field
+    {
+        SUBJECT     = 0x01,
+        DESCRIPTION = 0x02,
+        ALL_FIELDS  = SUBJECT | DESCRIPTION,
+    };
+    Q_ENUM( Field )
+
+    /// Minimum number of characters of an indexed token
+    static const int MIN_TOKEN_LENGTH = 2;
+
+private:
+    /// Number of indexed fields
+    static const int FIELD_COUNT = 2;
+
+    /// Token dictionaries by field, mapping each token to the sorted IDs of the issues containing it
+    QMap<QString, QVector<int>> postings_[FIELD_COUNT];
+
+    /// Distinct tokens of each indexed issue by field, for removing it again
+    QHash<int, QStringList> tokens_[FIELD_COUNT];
+
+    /// Issue store followed by the index
+    QPointer<IssueStore> store_;
+
+    /// Remove an issue from the postings without touching its tokens
+    void removePostings( int field, int id, const QStringList& tokens );
+
+    /// Collect the sorted IDs of the issues containing a token with the given prefix
+    QVector<int> match( const QString& prefix, int fields ) const;
+
+    /// Index the issues of the store with the given IDs
+    void insertFromStore( QVector<int> ids );
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param store  Issue store to follow; its issues are indexed immediately (default: none)
+     * @param parent Parent QObject (default: nullptr)
+     */
+    explicit IssueTextIndex( IssueStore* store = nullptr, QObject* parent = nullptr );
+
+    /**
+     * @brief Split a text into case-folded tokens
+     *
+     * @param text Text
+     * @param minLength Minimum number of characters of a token (default: \c MIN_TOKEN_LENGTH)
+     *
+     * @return Tokens in order of appearance, including duplicates
+     */
+    static QStringList tokenize( const QString& text, int minLength = MIN_TOKEN_LENGTH );
+
+    /// @name Modification
+    /// @{
+
+    /**
+     * @brief Insert or replace an issue
+     *
+     * @param issue Issue; must have an ID
+     */
+    void insert( const Issue& issue );
+
+    /**
+     * @brief Insert or replace issues
+     *
+     * Postings are sorted once per batch rather than once per issue.
+     *
+     * @param issues Issues; issues without an ID are ignored
+     */
+    void insert( const Issues& issues );
+
+    /**
+     * @brief Remove an issue
+     *
+     * @param id Issue ID
+     */
+    void remove( int id );
+
+    /**
+     * @brief Remove all issues
+     */
+    void clear();
+
+    /// @}
+
+    /// @name Lookup
+    /// @{
+
+    /// @return Number of indexed issues
+    int size() const;
+
+    /// @return Number of distinct tokens of a field
+    int tokenCount( Field field ) const;
+
+    /**
+     * @brief Search issues
+     *
+     * Every term of the query is matched as a prefix, e.g. <tt>log fail</tt> matches an issue with the
+     * subject "Login failure".
+     *
+     * @param query  Search terms
+     * @param limit  Maximum number of results; 0 for all (default: 0)
+     * @param fields Fields to search, see Field (default: ALL_FIELDS)
+     *
+     * @return IDs of the matching issues, most recent (highest ID) first; empty if the query has no
+     *         terms
+     */
+    QVector<int> search( const QString& query, int limit = 0, int fields = ALL_FIELDS ) const;
+
+    /// @}
+};
+
+} // qtredmine
+
+#endif // ISSUETEXTINDEX_H
@@ -0,0 +1,180 @@
+#ifndef ISSUEVIEW_H
+#define ISSUEVIEW_H
+
+#include "qtredmine_global.h"
+
+#include "SimpleRedmineTypes.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+#include <functional>
+
+namespace qtredmine {
+
+/**
+ * @brief Lazy view on an issue inside a raw Redmine reply
+ *
+ * An issue view keeps a reference to the unparsed reply data of a page and the byte range of one
+ * issue record within it. Fields are only decoded when they are accessed for the first time; the
+ * decoded values of the most commonly used fields are kept for subsequent accesses.
+ *
+ * All views of a page share the same implicitly shared page data.
+ */
+class QTREDMINESHARED_EXPORT IssueView
+{
+private:
+    /// Raw page data
+    QByteArray data_;
+
+    /// Offset of the first byte of the issue record
+    int begin_ = 0;
+
+    /// Offset after the last byte of the issue record
+    int end_ = 0;
+
+    /// Flags of the decoded fields
+    enum Decoded
+    {
+        DECODED_ID        = 0x01,
+        DECODED_SUBJECT   = 0x02,
+        DECODED_STATUS    = 0x04,
+        DECODED_UPDATEDON = 0x08,
+    };
+
+    /// Fields that have already been decoded
+    mutable int decoded_ = 0;
+
+    /// Decoded ID
+    mutable int id_ = NULL_ID;
+
+    /// Decoded subject
+    mutable QString subject_;
+
+    /// Decoded status
+    mutable Item status_;
+
+    /// Decoded update time
+    mutable Timestamp updatedOn_;
+
+    /// Locate the raw JSON value of a top-level issue field within the page data, without copying it
+    bool findField( const char* key, const char** begin, const char** end ) const;
+
+public:
+    /**
+     * @brief Constructor for an invalid view
+     */
+    IssueView() = default;
+
+    /**
+     * @brief Constructor
+     *
+     * @param data  Raw page data
+     * @param begin Offset of the first byte of the issue record
+     * @param end   Offset after the last byte of the issue record
+     */
+    IssueView( const QByteArray& data, int begin, int end );
+
+    /**
+     * @brief Check whether the view refers to an issue record
+     *
+     * @return true if the view is valid, false otherwise
+     */
+    bool isValid() const;
+
+    /// @name Lazily decoded fields
+    /// @{
+
+    /// @return Issue ID
+    int id() const;
+
+    /// @return Subject
+    QString subject() const;
+
+    /// @return Status
+    Item status() const;
+
+    /// @return Update time
+    Timestamp updatedOn() const;
+
+    /// @return Description
+    QString description() const;
+
+    /// @return Project
+    Item project() const;
+
+    /// @return Tracker
+    Item tracker() const;
+
+    /// @return Assigned to user
+    Item assignedTo() const;
+
+    /// @}
+
+    /**
+     * @brief Get the raw JSON data of a top-level issue field
+     *
+     * @param key JSON key of the field, e.g. \c subject
+     *
+     * @return Copy of the raw JSON value or an empty byte array if the field does not exist
+     */
+    QByteArray rawField( const char* key ) const;
+
+    /**
+     * @brief Get the raw JSON data of the issue record
+     *
+     * @return Raw JSON object
+     */
+    QByteArray json() const;
+
+    /**
+     * @brief Decode all fields of the issue
+     *
+     * @param table Custom field table of the Redmine server, see SimpleRedmineClient::customFieldTable();
+     *              nullptr for the default table (default: nullptr)
+     *
+     * @return Fully decoded issue
+     */
+    Issue toIssue( CustomFieldTable* table = nullptr ) const;
+
+    /**
+     * @brief Create views for all issue records in a raw Redmine reply
+     *
+     * @param data       Raw page data
+     * @param totalCount If not \c nullptr, receives the \c total_count of the reply or \c -1
+     *
+     * @return Views of the issue records in the order they appear on the page
+     */
+    static QVector<IssueView> fromPage( const QByteArray& data, int* totalCount = nullptr );
+};
+
+/// Issue view vector
+using IssueViews = QVector<IssueView>;
+
+/**
+ * Typedef for an issue views callback function
+ *
+ * @param IssueViews Vector of lazy issue views
+ * @param RedmineError Redmine error code
+ * @param QStringList Errors that Redmine returned
+ */
+using IssueViewsCb = std::function<void(IssueViews, RedmineError, QStringList)>;
+
+} // qtredmine
+
+/**
+ * @brief QDebug stream operator for issue views
+ * @return QDebug object
+ */
+inline QDebug
+operator<<( QDebug debug, const qtredmine::IssueView& data )
+{
+    QDebugStateSaver saver( debug );
+    debug.nospace() << "IssueView(" << data.id() << ")";
+    return debug;
+}
+
+Q_DECLARE_METATYPE( qtredmine::IssueView )
+
+#endif // ISSUEVIEW_H
@@ -0,0 +1,94 @@
+#ifndef JSONWRITER_H
+#define JSONWRITER_H
+
+#include "qtredmine_global.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+namespace qtredmine {
+
+/**
+ * @brief Compact JSON writer
+ *
+ * Writes JSON directly into a byte array, without building a QJsonObject tree first and without
+ * any indentation. Commas between members and array elements are inserted automatically.
+ *
+ * @code
+ * JsonWriter writer;
+ * writer.beginObject();
+ * writer.key( "issue" ).beginObject();
+ * writer.key( "status_id" ).value( 5 );
+ * writer.endObject();
+ * writer.endObject();
+ * writer.data(); // {"issue":{"status_id":5}}
+ * @endcode
+ *
+ * The writer does not validate the structure; keys are expected to be plain ASCII.
+ */
+class QTREDMINESHARED_EXPORT JsonWriter
+{
+private:
+    /// Written JSON
+    QByteArray data_;
+
+    /// For every open object or array, whether it is still empty
+    QVector<bool> empty_;
+
+    /// A key has just been written, so the next value must not be preceded by a comma
+    bool afterKey_ = false;
+
+    /// Insert a comma if the current object or array already has a member
+    void separate();
+
+    /// Append an escaped string including its quotes
+    void appendString( const QString& string );
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param reserve Number of bytes to reserve for the JSON output
+     */
+    explicit JsonWriter( int reserve = 256 );
+
+    /// @name Structure
+    /// @{
+
+    JsonWriter& beginObject(); ///< Open an object
+    JsonWriter& endObject();   ///< Close the current object
+    JsonWriter& beginArray();  ///< Open an array
+    JsonWriter& endArray();    ///< Close the current array
+
+    /**
+     * @brief Write an object key
+     *
+     * @param key Plain ASCII key; it is not escaped
+     */
+    JsonWriter& key( const char* key );
+
+    /// @}
+
+    /// @name Values
+    /// @{
+
+    JsonWriter& value( bool value );           ///< Write a boolean
+    JsonWriter& value( int value );            ///< Write an integer
+    JsonWriter& value( double value );         ///< Write a number; NaN and infinity are written as null
+    JsonWriter& value( const QString& value ); ///< Write a string
+    JsonWriter& null();                        ///< Write null
+
+    /// @}
+
+    /**
+     * @brief Get the written JSON
+     *
+     * @return Compact JSON
+     */
+    const QByteArray& data() const { return data_; }
+};
+
+} // qtredmine
+
+#endif // JSONWRITER_H
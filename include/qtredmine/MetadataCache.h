@@ -0,0 +1,229 @@
+#ifndef METADATACACHE_H
+#define METADATACACHE_H
+
+#include "qtredmine_global.h"
+
+#include "SimpleRedmineTypes.h"
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+
+#include <functional>
+
+namespace qtredmine {
+
+class SimpleRedmineClient;
+struct SnapshotMetadata;
+
+/**
+ * @brief Cache for rarely changing Redmine metadata
+ *
+ * Issue statuses, trackers, issue priorities, time entry activities and custom field definitions
+ * change perhaps once a month, but are needed for almost every view. The cache keeps them in memory:
+ *
+ * - Requests for loaded metadata are answered immediately from memory.
+ * - Requests for metadata older than the time to live are answered from memory as well, and a
+ *   refresh is started in the background.
+ * - Concurrent requests for metadata that is not yet loaded share a single Redmine request.
+ * - All loaded metadata is refreshed periodically in the background.
+ *
+ * The changed() signal is emitted when a refresh finds modified metadata.
+ */
+class QTREDMINESHARED_EXPORT MetadataCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// Kinds of cached metadata
+    enum Kind
+    {
+        ISSUE_STATUSES,
+        TRACKERS,
+        ISSUE_PRIORITIES,
+        TIME_ENTRY_ACTIVITIES,
+        CUSTOM_FIELDS,
+    };
+    Q_ENUM( Kind )
+
+private:
+    /// Cache entry of one kind of metadata
+    template<typename T>
+    struct Entry
+    {
+        /// Callback type of the entry
+        using Cb = std::function<void(QVector<T>, RedmineError, QStringList)>;
+
+        QVector<T>    items;      ///< Cached items
+        QElapsedTimer loadedAt;   ///< Time of the last successful load; invalid if never loaded
+        bool          loading;    ///< A request is in flight
+        bool          stale;      ///< Marked as stale by invalidate()
+        QVector<Cb>   waiting;    ///< Callbacks waiting for the first load
+        std::function<void(Cb)> loader; ///< Function requesting the items from Redmine
+
+        Entry() : loading( false ), stale( false ) {}
+    };
+
+    /// Redmine client
+    SimpleRedmineClient* redmine_;
+
+    /// Time to live in milliseconds
+    int ttl_;
+
+    /// Timer for the periodic background refresh
+    QTimer refreshTimer_;
+
+    /// @name Cache entries
+    /// @{
+
+    Entry<IssueStatus> issueStatuses_;
+    Entry<Tracker>     trackers_;
+    Entry<Enumeration> issuePriorities_;
+    Entry<Enumeration> timeEntryActivities_;
+    Entry<CustomField> customFields_;
+
+    /// @}
+
+    /// Answer a request from an entry, loading it if necessary
+    template<typename T>
+    void get( Entry<T>& entry, Kind kind, typename Entry<T>::Cb callback );
+
+    /// Load an entry unless a request is already in flight
+    template<typename T>
+    void load( Entry<T>& entry, Kind kind );
+
+    /// Fill an entry that has neither been loaded nor requested with restored items
+    template<typename T>
+    void restore( Entry<T>& entry, const QVector<T>& items );
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param redmine Redmine client used to load the metadata
+     * @param ttl     Time to live in milliseconds (default: one hour)
+     * @param parent  Parent QObject (default: nullptr)
+     */
+    explicit MetadataCache( SimpleRedmineClient* redmine, int ttl = 3600 * 1000, QObject* parent = nullptr );
+
+    /**
+     * @brief Set the time to live
+     *
+     * Also sets the interval of the periodic background refresh.
+     *
+     * @param ttl Time to live in milliseconds
+     */
+    void setTtl( int ttl );
+
+    /// @return Time to live in milliseconds
+    int ttl() const;
+
+    /// @name Cached metadata
+    /// @{
+
+    /**
+     * @brief Get the issue statuses
+     *
+     * @param callback Callback function with an issue status vector; called immediately if cached
+     */
+    void issueStatuses( IssueStatusesCb callback );
+
+    /**
+     * @brief Get the trackers
+     *
+     * @param callback Callback function with a tracker vector; called immediately if cached
+     */
+    void trackers( TrackersCb callback );
+
+    /**
+     * @brief Get the issue priorities
+     *
+     * @param callback Callback function with an enumeration vector; called immediately if cached
+     */
+    void issuePriorities( EnumerationsCb callback );
+
+    /**
+     * @brief Get the time entry activities
+     *
+     * @param callback Callback function with an enumeration vector; called immediately if cached
+     */
+    void timeEntryActivities( EnumerationsCb callback );
+
+    /**
+     * @brief Get the custom field definitions
+     *
+     * @param callback Callback function with a custom field vector; called immediately if cached
+     */
+    void customFields( CustomFieldsCb callback );
+
+    /// @}
+
+    /// @name Cache control
+    /// @{
+
+    /**
+     * @brief Check whether a kind of metadata has been loaded
+     *
+     * @param kind Kind of metadata
+     *
+     * @return true if loaded, false otherwise
+     */
+    bool isLoaded( Kind kind ) const;
+
+    /**
+     * @brief Reload a kind of metadata from Redmine in the background
+     *
+     * @param kind Kind of metadata
+     */
+    void refresh( Kind kind );
+
+    /**
+     * @brief Reload all loaded metadata from Redmine in the background
+     */
+    void refreshAll();
+
+    /**
+     * @brief Mark all metadata as stale
+     *
+     * Cached metadata is still returned, but the next request triggers a refresh.
+     */
+    void invalidate();
+
+    /// @}
+
+    /// @name Persistence
+    /// @{
+
+    /**
+     * @brief Get the loaded metadata for an IssueSnapshot
+     *
+     * @return Loaded metadata; empty for kinds that have not been loaded. The synchronisation cursor
+     *         is not set.
+     */
+    SnapshotMetadata snapshot() const;
+
+    /**
+     * @brief Restore metadata saved with an IssueSnapshot
+     *
+     * Kinds that have neither been loaded nor requested yet are filled with the restored items and
+     * marked as stale, so that they are answered immediately and refreshed from Redmine on the first
+     * request.
+     *
+     * @param metadata Metadata, e.g. from IssueSnapshot::metadata()
+     */
+    void restore( const SnapshotMetadata& metadata );
+
+    /// @}
+
+signals:
+    /**
+     * @brief Signal that a refresh found modified metadata
+     *
+     * @param kind Kind of the modified metadata
+     */
+    void changed( MetadataCache::Kind kind );
+};
+
+} // qtredmine
+
+#endif // METADATACACHE_H
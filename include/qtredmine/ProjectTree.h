@@ -0,0 +1,178 @@
+#ifndef PROJECTTREE_H
+#define PROJECTTREE_H
+
+#include "qtredmine_global.h"
+
+#include "SimpleRedmineTypes.h"
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QVector>
+
+namespace qtredmine {
+
+/**
+ * @brief Project hierarchy cache
+ *
+ * Keeps projects with their parent/child relations by Project::parent. The projects are laid out
+ * in depth-first order, children sorted by name, so that the descendants of every project form a
+ * contiguous range:
+ *
+ * - descendants() takes time proportional to the size of the subtree, ancestors() proportional to
+ *   the depth of the project.
+ * - filter() returns a precomputed issue filter for a project and its subprojects.
+ *
+ * Projects change rarely, so the layout and the filters are rebuilt after every modification. A
+ * project whose parent is not cached is a root.
+ *
+ * The cache can be fed automatically by SimpleRedmineClient::setProjectTree(); it should then be
+ * filled once with all projects, e.g. with RedmineOptions::getAllItems.
+ */
+class QTREDMINESHARED_EXPORT ProjectTree : public QObject
+{
+    Q_OBJECT
+
+private:
+    /// Node of the hierarchy
+    struct Node
+    {
+        Project      project;      ///< Project
+        QVector<int> children;     ///< IDs of the children, sorted by name
+        int          begin = 0;    ///< Position of the project in \c order_
+        int          end = 0;      ///< Position after the last descendant in \c order_
+        QString      filter;       ///< Issue filter for the subtree
+    };
+
+    /// Nodes by project ID
+    QHash<int, Node> nodes_;
+
+    /// Project IDs in depth-first order
+    QVector<int> order_;
+
+    /// IDs of the root projects, sorted by name
+    QVector<int> roots_;
+
+    /// Rebuild the children, the depth-first order and the filters
+    void rebuild();
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param parent Parent QObject (default: nullptr)
+     */
+    explicit ProjectTree( QObject* parent = nullptr );
+
+    /// @name Modification
+    /// @{
+
+    /**
+     * @brief Insert or replace a project
+     *
+     * @param project Project; must have an ID
+     */
+    void insert( const Project& project );
+
+    /**
+     * @brief Insert or replace projects
+     *
+     * The hierarchy is rebuilt once for all projects.
+     *
+     * @param projects Projects; projects without an ID are ignored
+     */
+    void insert( const Projects& projects );
+
+    /**
+     * @brief Remove a project
+     *
+     * Children of the project become roots.
+     *
+     * @param id Project ID
+     */
+    void remove( int id );
+
+    /**
+     * @brief Remove all projects
+     */
+    void clear();
+
+    /// @}
+
+    /// @name Lookup
+    /// @{
+
+    /// @return Number of cached projects
+    int size() const;
+
+    /**
+     * @brief Find a project by ID
+     *
+     * @param id Project ID
+     *
+     * @return Pointer to the cached project, or nullptr if not found
+     */
+    const Project* find( int id ) const;
+
+    /**
+     * @brief Get the parent of a project
+     *
+     * @param id Project ID
+     *
+     * @return Parent project ID, or \c NULL_ID for root and unknown projects
+     */
+    int parent( int id ) const;
+
+    /**
+     * @brief Get the root projects
+     *
+     * @return IDs of the projects without a cached parent, sorted by name
+     */
+    QVector<int> roots() const;
+
+    /**
+     * @brief Get the children of a project
+     *
+     * @param id Project ID
+     *
+     * @return IDs of the children, sorted by name
+     */
+    QVector<int> children( int id ) const;
+
+    /**
+     * @brief Get the descendants of a project
+     *
+     * @param id Project ID
+     *
+     * @return IDs of the descendants in depth-first order, children sorted by name
+     */
+    QVector<int> descendants( int id ) const;
+
+    /**
+     * @brief Get the ancestors of a project
+     *
+     * @param id Project ID
+     *
+     * @return IDs of the ancestors, nearest first
+     */
+    QVector<int> ancestors( int id ) const;
+
+    /**
+     * @brief Get the issue filter for a project and its subprojects
+     *
+     * The filter names the subprojects explicitly, e.g. <tt>project_id=1&subproject_id=4|7</tt>, or
+     * excludes them with <tt>subproject_id=!*</tt> for a project without subprojects, so that the
+     * result does not depend on the Redmine setting for subproject issues.
+     *
+     * @param id Project ID
+     *
+     * @return Issue query parameters; empty for unknown projects
+     */
+    QString filter( int id ) const;
+
+    /// @}
+};
+
+} // qtredmine
+
+#endif // PROJECTTREE_H
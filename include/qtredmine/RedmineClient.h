@@ -41,6 +41,9 @@ public:
     /// Typedef for a JSON callback function
     using JsonCb = std::function<void(QNetworkReply*, QJsonDocument*)>;
 
+    /// Typedef for a raw callback function that receives the unparsed reply data
+    using RawCb = std::function<void(QNetworkReply*, QByteArray*)>;
+
 public:
     /**
      * @brief Constructor for an unconfigured Redmine connection
@@ -105,6 +108,9 @@ public:
     /**
      * @brief Set the Redmine base URL
      *
+     * When switching from another server, item names no longer referenced anywhere are removed from
+     * StringPool::itemNames().
+     *
      * @param url Redmine base URL
      */
     void setUrl( const QString& url );
@@ -169,6 +175,19 @@ public:
                     const int id = NULL_ID,
                     const QString& parameters = "" );
 
+    /**
+     * @brief Create or update issue in Redmine
+     *
+     * @param data Serialised JSON data to store in Redmine, sent as is
+     * @param callback Callback function with a QJsonDocument object
+     * @param id Issue ID to update; if set to \c NULL_ID, create a new issue
+     * @param parameters  Additional issue parameters
+     */
+    void sendIssue( const QByteArray& data,
+                    JsonCb callback = nullptr,
+                    const int id = NULL_ID,
+                    const QString& parameters = "" );
+
     /**
      * @brief Create or update issue category in Redmine
      *
@@ -234,6 +253,19 @@ public:
                         const int id = NULL_ID,
                         const QString& parameters = "" );
 
+    /**
+     * @brief Create or update time entry in Redmine
+     *
+     * @param data Serialised JSON data to store in Redmine, sent as is
+     * @param callback Callback function with a QJsonDocument object
+     * @param id Time entry ID to update; if set to \c NULL_ID, create a new time entry
+     * @param parameters  Additional time entry parameters
+     */
+    void sendTimeEntry( const QByteArray& data,
+                        JsonCb callback = nullptr,
+                        const int id = NULL_ID,
+                        const QString& parameters = "" );
+
     /**
      * @brief Create or update time entry activity in Redmine
      *
@@ -319,6 +351,15 @@ public:
     void retrieveIssues( JsonCb callback,
                          const QString& parameters = "" );
 
+    /**
+     * @brief Retrieve issues from Redmine without parsing the reply
+     *
+     * @param callback Callback function with the raw reply data
+     * @param parameters  Additional issue parameters
+     */
+    void retrieveRawIssues( RawCb callback,
+                            const QString& parameters = "" );
+
     /**
      * @brief Retrieve issue categories from Redmine
      *
@@ -489,6 +530,27 @@ protected:
                                 const QString& queryParams = "",
                                 const QByteArray& postData = "" );
 
+    /**
+     * @brief Send a request to Redmine and pass the unparsed reply to the callback
+     *
+     * Works like sendRequest(), but the reply data is not parsed into a QJsonDocument. This allows
+     * callers to decode only the parts of the reply they need.
+     *
+     * @param resource    The resource specific part of the Redmine REST URL
+     * @param callback    Callback function for the raw result of the request
+     * @param mode        HTTP operation mode
+     * @param queryParams Query parameters that are appended to the Redmine REST URL
+     * @param postData    Data that will be sent by POST and PUT operations
+     *
+     * @return The network reply for this request
+     */
+    QNetworkReply* sendRawRequest( const QString& resource,
+                                   RawCb callback,
+                                   const QNetworkAccessManager::Operation mode
+                                       = QNetworkAccessManager::GetOperation,
+                                   const QString& queryParams = "",
+                                   const QByteArray& postData = "" );
+
     /**
      * @brief Create or update enumeration in Redmine
      *
@@ -539,6 +601,9 @@ private:
      */
     QMap<QNetworkReply*, JsonCb> callbacks_;
 
+    /// Mapping from network reply to raw callback function
+    QMap<QNetworkReply*, RawCb> rawCallbacks_;
+
     /// Determines whether SSL data (e.g. certificate validity) should be checked
     bool checkSsl_ = true;
 
@@ -558,6 +623,21 @@ private:
      */
     void init();
 
+    /**
+     * @brief Build the network request and start the network action
+     *
+     * @param resource    The resource specific part of the Redmine REST URL
+     * @param mode        HTTP operation mode
+     * @param queryParams Query parameters that are appended to the Redmine REST URL
+     * @param postData    Data that will be sent by POST and PUT operations
+     *
+     * @return The network reply for this request
+     */
+    QNetworkReply* startRequest( const QString& resource,
+                                 const QNetworkAccessManager::Operation mode,
+                                 const QString& queryParams,
+                                 const QByteArray& postData );
+
 private slots:
     /**
      * @brief Handle SSL errors
@@ -3,15 +3,27 @@
 
 #include "qtredmine_global.h"
 
+#include "IssueTable.h"
+#include "IssueView.h"
 #include "RedmineClient.h"
 #include "SimpleRedmineTypes.h"
 
+#include <QBitArray>
+#include <QElapsedTimer>
+#include <QHash>
 #include <QObject>
 #include <QString>
 #include <QTime>
 
 namespace qtredmine {
 
+class CustomFieldTable;
+class IssueSnapshot;
+class IssueStore;
+class MetadataCache;
+class ProjectTree;
+class SqliteMirror;
+
 /**
  * @brief Simple Redmine connection class
  *
@@ -30,12 +42,99 @@ private:
     /// Maximum number of resources to fetch at once
     int limit_ = 100;
 
+    /// Maximum number of pages requested at the same time
+    int pageWindow_ = 4;
+
     /// Current connection status to Redmine
     QNetworkAccessManager::NetworkAccessibility connected_ = QNetworkAccessManager::UnknownAccessibility;
 
     /// Currently checking the connection
     bool checkingConnection_;
 
+    /// Metadata cache; created on first use
+    MetadataCache* metadataCache_ = nullptr;
+
+    /// Issue store fed by the issue retrievers
+    IssueStore* issueStore_ = nullptr;
+
+    /// Snapshot restored by loadSnapshot(); its issues are decoded into the issue store on first access
+    IssueSnapshot* snapshot_ = nullptr;
+
+    /// Rows of the loaded snapshot whose issues have been removed from the issue store
+    QBitArray snapshotRemoved_;
+
+    /// Get an issue from the issue store, decoding it from the loaded snapshot if it is not stored yet
+    const Issue* storedIssue( int id );
+
+    /// Close the loaded snapshot, after decoding its remaining issues into the issue store if requested;
+    /// returns the number of issues inserted
+    int closeSnapshot( bool decode );
+
+    /// SQLite mirror fed by the issue, time entry and project retrievers; kept without
+    /// QTREDMINE_SQLITE as well, so that the class layout does not depend on the build switch
+    SqliteMirror* sqliteMirror_ = nullptr;
+
+    /// Project hierarchy cache fed by the project retrievers
+    ProjectTree* projectTree_ = nullptr;
+
+    /// Largest issue update time seen by syncIssues(), by query parameters
+    QHash<QString, Timestamp> syncCursors_;
+
+    /// Issue query remembered by the query cache
+    struct CachedQuery
+    {
+        QVector<int>  ids;           ///< IDs of the returned issues
+        QElapsedTimer loadedAt;      ///< Time of the last successful retrieval
+        quint64       lastUsed = 0;  ///< Value of \c queryClock_ at the last use
+    };
+
+    /// Issue queries by key, for answering them from the issue store
+    QHash<QString, CachedQuery> queryCache_;
+
+    /// Counter ordering the uses of the cached queries
+    quint64 queryClock_ = 0;
+
+    /// Maximum number of cached queries
+    int queryCacheCapacity_ = 64;
+
+    /// Time in milliseconds after which cached queries are not answered without Redmine
+    int queryCacheTtl_ = 5 * 60 * 1000;
+
+    /// Time of the last retrieval of an issue by retrieveIssue() or retrieveIssues(), by issue ID
+    QHash<int, QElapsedTimer> issueLoadedAt_;
+
+    /// Answer reads from the local cache while Redmine is not accessible
+    bool offlineReads_ = false;
+
+    /// Check whether reads have to be answered from the local cache
+    bool isOffline() const;
+
+    /// Call back with RedmineError::ERR_NETWORK and return true if reads are offline
+    template<typename T>
+    bool failOffline( const std::function<void(T, RedmineError, QStringList)>& callback );
+
+    /// Get the key of an issue query in the query cache
+    static QString queryKey( const RedmineOptions& options );
+
+    /// Get the stored issues of a query that has been run before; returns false if any is missing or
+    /// if \c fresh is set and the query has expired
+    bool cachedIssues( const QString& key, Issues* issues, bool fresh );
+
+    /// Remember the issue IDs of a query, evicting the least recently used query if the cache is full
+    void cacheQuery( const QString& key, const QVector<int>& ids );
+
+    /// Forget the least recently used queries until at most the given number is left
+    void evictQueries( int size );
+
+    /// Queue complete resources for the SQLite mirror, if one is set
+    template<typename T>
+    void writeThrough( const QVector<T>& items );
+
+    /// Wrap a collection callback so that complete results are written into the SQLite mirror first
+    template<typename T>
+    std::function<void(QVector<T>, RedmineError, QStringList)>
+    mirrored( std::function<void(QVector<T>, RedmineError, QStringList)> callback, const RedmineOptions& options );
+
 public:
     /**
      * @brief Constructor for an unconfigured Redmine connection
@@ -77,6 +176,11 @@ public:
                          bool checkSsl   = true,
                          QObject* parent = nullptr );
 
+    /**
+     * @brief Destructor, closing a loaded snapshot
+     */
+    ~SimpleRedmineClient();
+
     /**
      * @brief Initialise the Redmine client
      */
@@ -96,6 +200,220 @@ public:
      */
     void reconnect();
 
+    /**
+     * @brief Get the connection status determined by the last connection check
+     *
+     * @return Connection status
+     */
+    QNetworkAccessManager::NetworkAccessibility connectionStatus() const;
+
+    /**
+     * @brief Get the custom field table of the Redmine server of this client
+     *
+     * Custom field values parsed by this client refer to this table, and retrieveCustomFields()
+     * completes its definitions.
+     *
+     * @return Custom field table for the current Redmine base URL
+     */
+    CustomFieldTable* customFieldTable() const;
+
+    /**
+     * @brief Get the metadata cache of this client
+     *
+     * The cache is created on first use and owned by the client.
+     *
+     * @return Metadata cache for issue statuses, trackers, priorities, activities and custom fields
+     */
+    MetadataCache* metadataCache();
+
+    /**
+     * @brief Set the issue store fed by the issue retrievers
+     *
+     * Issues retrieved by retrieveIssue() and retrieveIssues() are inserted into the store before the
+     * callback is called. Results decoded with a parse profile other than ParseProfile::FULL are not
+     * inserted, since they lack fields.
+     *
+     * The issues of a snapshot loaded into the previous store are decoded into it first.
+     *
+     * @param store Issue store, or nullptr to stop feeding a store; not owned by the client
+     */
+    void setIssueStore( IssueStore* store );
+
+    /**
+     * @brief Get the issue store fed by the issue retrievers
+     *
+     * @return Issue store, or nullptr if none is set
+     */
+    IssueStore* issueStore() const;
+
+#ifdef QTREDMINE_SQLITE
+    /**
+     * @brief Set the SQLite mirror fed by the retrievers
+     *
+     * Issues, time entries and projects retrieved by retrieveIssues(), syncIssues(),
+     * retrieveTimeEntries() and retrieveProjects() are queued for the mirror with
+     * SqliteMirror::enqueue() before the callback is called; the mirror writes them in chunks from
+     * the event loop. Results decoded with a parse profile other than ParseProfile::FULL are not
+     * written.
+     *
+     * Issues and time entries created with sendIssueData() and sendTimeEntryData() are written
+     * through as returned by Redmine. Updated issues are written through if they are in the issue
+     * store. Updated time entries are not, since Redmine does not return them; their rows are only
+     * refreshed by the next retrieveTimeEntries().
+     *
+     * Only available if the library has been built with <tt>CONFIG+=qtredmine_sqlite</tt>.
+     *
+     * @param mirror SQLite mirror, or nullptr to stop feeding a mirror; not owned by the client
+     */
+    void setSqliteMirror( SqliteMirror* mirror );
+
+    /**
+     * @brief Get the SQLite mirror fed by the retrievers
+     *
+     * @return SQLite mirror, or nullptr if none is set
+     */
+    SqliteMirror* sqliteMirror() const;
+#endif
+
+    /**
+     * @brief Set the project hierarchy cache fed by the project retrievers
+     *
+     * Projects retrieved by retrieveProjects() are inserted into the cache before the callback is
+     * called. Results decoded with a ParseProfile::CUSTOM profile that skips the name or the parent
+     * are not inserted.
+     *
+     * @param tree Project hierarchy cache, or nullptr to stop feeding a cache; not owned by the client
+     */
+    void setProjectTree( ProjectTree* tree );
+
+    /**
+     * @brief Get the project hierarchy cache fed by the project retrievers
+     *
+     * @return Project hierarchy cache, or nullptr if none is set
+     */
+    ProjectTree* projectTree() const;
+
+    /**
+     * @brief Enable or disable offline reads
+     *
+     * While offline reads are enabled and Redmine is not accessible, the following retrievers do not
+     * send requests. They answer from a local cache with RedmineError::NO_ERR_CACHED instead, or fail
+     * at once with RedmineError::ERR_NETWORK if the data is not cached:
+     *
+     * - retrieveIssue() and retrieveIssues() answer from the issue store. Queries can only be answered
+     *   if they have been run before.
+     * - retrieveIssueStatuses() and retrieveTrackers() without parameters answer from the metadata
+     *   cache, if it has loaded or restored them.
+     * - retrieveProject() and retrieveProjects() without parameters answer from the project tree.
+     *
+     * The other retrievers, including syncIssues(), retrieveIssueViews() and retrieveIssueTable(),
+     * have no cache to answer from and fail at once with RedmineError::ERR_NETWORK. The
+     * MetadataCache keeps its previous data in that case. Writes are not affected; use a WriteQueue
+     * to defer them. Use isSuccess() to accept both RedmineError::NO_ERR and
+     * RedmineError::NO_ERR_CACHED.
+     *
+     * @param enabled true to enable offline reads, false to disable them
+     */
+    void setOfflineReads( bool enabled );
+
+    /// @return true if offline reads are enabled, false otherwise
+    bool offlineReads() const;
+
+    /**
+     * @brief Set the maximum number of issue queries remembered by retrieveIssues()
+     *
+     * If the cache is full, the least recently used query is forgotten. The issues themselves are
+     * kept by the issue store.
+     *
+     * @param capacity Maximum number of queries (default: 64)
+     */
+    void setQueryCacheCapacity( int capacity );
+
+    /// @return Maximum number of issue queries remembered by retrieveIssues()
+    int queryCacheCapacity() const;
+
+    /**
+     * @brief Set the time after which remembered issue queries expire
+     *
+     * Expired queries are not answered at once with CachePolicy::STALE_WHILE_REVALIDATE. Offline
+     * reads still answer them, flagged with RedmineError::NO_ERR_CACHED. The same applies to single
+     * issues answered by retrieveIssue().
+     *
+     * @param ttl Time to live in milliseconds (default: five minutes)
+     */
+    void setQueryCacheTtl( int ttl );
+
+    /// @return Time to live of remembered issue queries in milliseconds
+    int queryCacheTtl() const;
+
+    /**
+     * @brief Get the cursor of the incremental issue synchronisation
+     *
+     * @param parameters Query parameters the cursor belongs to
+     *
+     * @return Largest update time seen by syncIssues(), or an invalid timestamp if none
+     */
+    Timestamp syncCursor( QString parameters = "" ) const;
+
+    /**
+     * @brief Set the cursor of the incremental issue synchronisation
+     *
+     * Used to restore a cursor saved together with the issues, or to force a full synchronisation by
+     * setting an invalid timestamp.
+     *
+     * @param cursor Largest update time of the stored issues
+     * @param parameters Query parameters the cursor belongs to
+     */
+    void setSyncCursor( Timestamp cursor, QString parameters = "" );
+
+    /**
+     * @brief Save the issue store to an IssueSnapshot file
+     *
+     * Besides the issues, the snapshot holds the definitions of the custom field table, the metadata
+     * loaded by the metadata cache and the synchronisation cursor of the given query parameters.
+     *
+     * The issues of a loaded snapshot that have not been decoded yet are decoded into the issue store
+     * first and the loaded snapshot is closed, so that its file can be replaced.
+     *
+     * @param path       Path of the snapshot file
+     * @param parameters Query parameters of the synchronisation cursor to save
+     *
+     * @return true on success, false if no issue store is set or the file could not be written
+     */
+    bool saveSnapshot( const QString& path, QString parameters = "" );
+
+    /**
+     * @brief Restore the issue store from an IssueSnapshot file
+     *
+     * The snapshot stays mapped, and its issues are only decoded into the issue store when they are
+     * read through the client: by retrieveIssue(), by cached queries of retrieveIssues() and when
+     * syncIssues() fetches them again. Issues in the issue store take precedence, except for those
+     * that are older than in the snapshot, which are replaced right away. Call decodeSnapshot() before
+     * querying the issue store directly. The custom field values of the decoded issues refer to the
+     * custom field table of this client.
+     *
+     * Definitions missing from the custom field table are added, the metadata cache is filled with the
+     * saved metadata, see MetadataCache::restore(), and the synchronisation cursor of the given query
+     * parameters is restored, so that the next syncIssues() only fetches the changes since the
+     * snapshot. A previously loaded snapshot is decoded and closed first.
+     *
+     * @param path       Path of the snapshot file
+     * @param parameters Query parameters the saved synchronisation cursor belongs to
+     *
+     * @return true on success, false if no issue store is set or the file is not a valid snapshot
+     */
+    bool loadSnapshot( const QString& path, QString parameters = "" );
+
+    /**
+     * @brief Decode all remaining issues of the loaded snapshot into the issue store
+     *
+     * Needed before the issue store is queried directly, e.g. with IssueStore::byProject(). The
+     * snapshot is closed afterwards.
+     *
+     * @return Number of issues inserted into the issue store
+     */
+    int decodeSnapshot();
+
     /// @name Redmine data creators and updaters
     /// @{
 
@@ -112,6 +430,22 @@ public:
                     int id = NULL_ID,
                     QString parameters = "" );
 
+    /**
+     * @brief Update an issue in Redmine, sending only the modified fields
+     *
+     * Only the fields of \c item that differ from \c original are sent. If no field differs, no
+     * request is sent and the callback is called immediately.
+     *
+     * @param item Modified issue; its ID determines the issue to update
+     * @param original Issue as last retrieved from Redmine
+     * @param callback Success callback function
+     * @param parameters Additional issue parameters
+     */
+    void updateIssue( Issue item,
+                      Issue original,
+                      SuccessCb callback,
+                      QString parameters = "" );
+
     /**
      * @brief Create or update issue priority in Redmine
      *
@@ -151,6 +485,45 @@ public:
                       int id = NULL_ID,
                       QString parameters = "" );
 
+    /**
+     * @brief Send an issue request body to Redmine
+     *
+     * On success, the issue store is updated: with the issue returned by Redmine if the reply
+     * contains one, otherwise by applying the written fields to the stored issue.
+     *
+     * Fails with RedmineError::ERR_UNREACHABLE if Redmine did not reply, and with
+     * RedmineError::ERR_NETWORK if it replied with an error status.
+     *
+     * @param data Serialised issue, e.g. from requestBody() or patchBody()
+     * @param callback Success callback function
+     * @param id Issue ID to update; if set to \c NULL_ID, create a new issue
+     * @param parameters Additional issue parameters
+     * @param apply Function applying the written fields to a stored issue (default: none)
+     */
+    void sendIssueData( QByteArray data,
+                        SuccessCb callback,
+                        int id = NULL_ID,
+                        QString parameters = "",
+                        std::function<void(Issue&)> apply = nullptr );
+
+    /**
+     * @brief Send a time entry request body to Redmine
+     *
+     * On success, the \c timeEntrySaved signal is emitted. Errors are reported like by
+     * sendIssueData().
+     *
+     * @param data Serialised time entry, e.g. from requestBody()
+     * @param callback Success callback function
+     * @param id Time entry ID to update; if set to \c NULL_ID, create a new time entry
+     * @param parameters Additional time entry parameters
+     * @param written Time entry that has been serialised, reported for updates (default: none)
+     */
+    void sendTimeEntryData( QByteArray data,
+                            SuccessCb callback,
+                            int id = NULL_ID,
+                            QString parameters = "",
+                            TimeEntry written = TimeEntry() );
+
     /**
      * @brief Create or update time entry in Redmine
      *
@@ -208,6 +581,21 @@ public:
     /// @name Redmine data retrievers
     /// @{
 
+    /**
+     * @brief Retrieve the data needed at startup at once
+     *
+     * Requests the current user, the projects, trackers, issue statuses, issue priorities and time
+     * entry activities concurrently instead of one after another, so a cold start costs about one
+     * round trip instead of six. The callback is called once, after all replies have arrived.
+     *
+     * The metadata is requested through the metadata cache, which is thereby filled as well.
+     *
+     * @param callback Callback function with the startup data
+     * @param projectOptions Options for retrieving the projects (default: all projects)
+     */
+    void bootstrap( BootstrapCb callback,
+                    RedmineOptions projectOptions = RedmineOptions("", true) );
+
     /**
      * @brief Retrieve custom fields from Redmine
      *
@@ -228,15 +616,62 @@ public:
                         int issueId,
                         QString parameters = "" );
 
+    /**
+     * @brief Retrieve an issue from Redmine
+     *
+     * With CachePolicy::STALE_WHILE_REVALIDATE and a stored issue that retrieveIssue() or
+     * retrieveIssues() has retrieved within the time set by setQueryCacheTtl(), the callback is called
+     * at once with the stored issue, and a second time only if Redmine returns a different issue.
+     * Issues stored otherwise, e.g. by syncIssues() or from a snapshot, are not answered at once,
+     * since their age is not known.
+     *
+     * @param callback Callback function with an issue object
+     * @param issueId Issue ID
+     * @param options Additional options
+     */
+    void retrieveIssue( IssueCb callback,
+                        int issueId,
+                        RedmineOptions options );
+
     /**
      * @brief Retrieve issues from Redmine
      *
+     * Fields skipped by the parse profile of the options are not decoded and left empty.
+     *
+     * With CachePolicy::STALE_WHILE_REVALIDATE, a query that has been run before is answered at once
+     * from the issue store; the callback is called a second time only if Redmine returns different
+     * issues. This requires an issue store and ParseProfile::FULL. Queries are remembered within
+     * the limits set by setQueryCacheCapacity() and setQueryCacheTtl().
+     *
      * @param callback Callback function with an issue vector
      * @param options Additional options
      */
     void retrieveIssues( IssuesCb callback,
                          RedmineOptions options = RedmineOptions() );
 
+    /**
+     * @brief Retrieve lazy issue views from Redmine
+     *
+     * The replies are not parsed up front. Each view decodes its fields on first access, so callers
+     * that only need a few fields of each issue do not pay for decoding the others.
+     *
+     * @param callback Callback function with an issue view vector
+     * @param options Additional options
+     */
+    void retrieveIssueViews( IssueViewsCb callback,
+                             RedmineOptions options = RedmineOptions() );
+
+    /**
+     * @brief Retrieve issues from Redmine into a columnar issue table
+     *
+     * The issues are parsed directly into the table columns without creating Issue objects.
+     *
+     * @param callback Callback function with an issue table
+     * @param options Additional options
+     */
+    void retrieveIssueTable( IssueTableCb callback,
+                             RedmineOptions options = RedmineOptions() );
+
     /**
      * @brief Retrieve issue categories for a project
      *
@@ -269,14 +704,27 @@ public:
     /**
      * @brief Retrieve memberships for a project
      *
+     * All pages are retrieved.
+     *
      * @param callback Callback function with an membership vector
      * @param projectId Project ID to get the memberships of
-     * @param options Additional options
+     * @param parameters Additional membership parameters
      */
     void retrieveMemberships( MembershipsCb callback,
                               int projectId,
                               QString parameters = "" );
 
+    /**
+     * @brief Retrieve memberships for a project
+     *
+     * @param callback Callback function with an membership vector
+     * @param projectId Project ID to get the memberships of
+     * @param options Additional options
+     */
+    void retrieveMemberships( MembershipsCb callback,
+                              int projectId,
+                              RedmineOptions options );
+
     /**
      * @brief Retrieve an project from Redmine
      *
@@ -291,21 +739,66 @@ public:
     /**
      * @brief Retrieve projects from Redmine
      *
+     * All pages are retrieved.
+     *
      * @param callback Callback function with a project vector
      * @param parameters Additional project parameters
      */
     void retrieveProjects( ProjectsCb callback,
                            QString parameters = "" );
 
+    /**
+     * @brief Retrieve projects from Redmine
+     *
+     * @param callback Callback function with a project vector
+     * @param options Additional options
+     */
+    void retrieveProjects( ProjectsCb callback,
+                           RedmineOptions options );
+
+    /**
+     * @brief Synchronise the issue store incrementally
+     *
+     * Only the issues updated since the largest update time seen by the previous synchronisation
+     * with the same parameters are transferred and merged into the issue store; the first
+     * synchronisation transfers all issues. Closed issues are included unless the parameters contain
+     * a \c status_id filter.
+     *
+     * The pages are requested one by one, sorted by update time and ID. If an issue is updated while
+     * the pages are transferred, another issue may be skipped; this is detected by comparing the
+     * transferred issues with the total count, and the cursor is then kept, so that the next
+     * synchronisation transfers the skipped issue (see SyncStatistics::complete).
+     *
+     * Issues deleted in Redmine are not detected, since Redmine does not report deletions.
+     *
+     * The \c issuesSynchronised signal is emitted after each successful synchronisation.
+     *
+     * @param callback Callback function with the synchronisation statistics
+     * @param parameters Additional issue parameters, e.g. a project filter
+     */
+    void syncIssues( SyncCb callback,
+                     QString parameters = "" );
+
     /**
      * @brief Retrieve time entries from Redmine
      *
+     * All pages are retrieved.
+     *
      * @param callback Callback function with a time entries vector
      * @param parameters Additional time entry parameters
      */
     void retrieveTimeEntries( TimeEntriesCb callback,
                               QString parameters = "" );
 
+    /**
+     * @brief Retrieve time entries from Redmine
+     *
+     * @param callback Callback function with a time entries vector
+     * @param options Additional options
+     */
+    void retrieveTimeEntries( TimeEntriesCb callback,
+                              RedmineOptions options );
+
     /**
      * @brief Retrieve time entry activities from Redmine
      *
@@ -334,12 +827,23 @@ public:
     /**
      * @brief Retrieve users from Redmine
      *
+     * All pages are retrieved.
+     *
      * @param callback Callback function with a user vector
      * @param parameters Additional user parameters
      */
     void retrieveUsers( UsersCb callback,
                         QString parameters = "" );
 
+    /**
+     * @brief Retrieve users from Redmine
+     *
+     * @param callback Callback function with a user vector
+     * @param options Additional options
+     */
+    void retrieveUsers( UsersCb callback,
+                        RedmineOptions options );
+
     /**
      * @brief Retrieve versions for a project
      *
@@ -365,6 +869,44 @@ protected:
                                EnumerationsCb callback,
                                QString parameters = "" );
 
+    /**
+     * @brief Retrieve the pages of a paginated request from Redmine
+     *
+     * The first page is fetched to learn the total number of resources. If all items are requested,
+     * the remaining pages are then requested with at most \c window requests in flight, the
+     * next page being requested whenever a reply arrives. Pages are decoded in the order of the
+     * replies; if the total number is unknown, pages are requested one by one until a page is not
+     * full.
+     *
+     * @param fetch   Function requesting one page with the given callback and query parameters
+     * @param decode  Function decoding one page with the given index; returns the number of
+     *                resources on the page and sets the total number if the reply contains it
+     * @param done    Function called once, after all pages have been decoded or on the first error
+     * @param options Additional options
+     * @param window  Maximum number of pages requested at the same time, usually \c pageWindow_
+     */
+    template<typename Reply>
+    void retrievePages( std::function<void(std::function<void(QNetworkReply*, Reply*)>, QString)> fetch,
+                        std::function<int(int, Reply*, int*)> decode,
+                        std::function<void(RedmineError, QStringList)> done,
+                        RedmineOptions options, int window );
+
+    /**
+     * @brief Retrieve a paginated collection of resources from Redmine
+     *
+     * The pages are retrieved with retrievePages() and the results are assembled in page order.
+     *
+     * @param key JSON key of the resource array in the reply, e.g. \c projects
+     * @param fetch Function requesting one page with the given callback and query parameters
+     * @param callback Callback function with the resource vector
+     * @param options Additional options
+     */
+    template<typename T>
+    void retrieveCollection( const char* key,
+                             std::function<void(JsonCb, QString)> fetch,
+                             std::function<void(QVector<T>, RedmineError, QStringList)> callback,
+                             RedmineOptions options );
+
 public slots:
     /**
      * @brief Check whether the connection currently works
@@ -381,6 +923,22 @@ signals:
      * @param connected true if connection is available, false otherwise
      */
     void connectionChanged( QNetworkAccessManager::NetworkAccessibility connected );
+
+    /**
+     * @brief Signal that an incremental issue synchronisation has finished
+     *
+     * @param statistics Numbers of transferred and changed issues
+     */
+    void issuesSynchronised( SyncStatistics statistics );
+
+    /**
+     * @brief Signal that a time entry has been created or updated successfully
+     *
+     * Allows observers to update their lists without retrieving the time entries again.
+     *
+     * @param timeEntry Time entry as returned by Redmine, or as written if Redmine did not return it
+     */
+    void timeEntrySaved( TimeEntry timeEntry );
 };
 
 } // qtredmine
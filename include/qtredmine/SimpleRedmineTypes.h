@@ -1,23 +1,33 @@
 #ifndef SIMPLEREDMINETYPES_H
 #define SIMPLEREDMINETYPES_H
 
+#include "JsonWriter.h"
 #include "Logging.h"
 #include "RedmineClient.h"
+#include "Timestamp.h"
 
 #include <QDebug>
 #include <QDate>
 #include <QDateTime>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonValue>
 #include <QMetaType>
 #include <QNetworkAccessManager>
 #include <QString>
+#include <QStringList>
 #include <QTime>
 #include <QVector>
 #include <QtGlobal>
 
 #include <functional>
+#include <type_traits>
 
 namespace qtredmine {
 
+class CustomFieldTable;
+
 /// Redmine error codes
 enum class RedmineError {
     NO_ERR,
@@ -26,6 +36,36 @@ enum class RedmineError {
     ERR_NOT_SAVED,
     ERR_TIME_ENTRY_TOO_SHORT,
     ERR_TIMEOUT,
+    ERR_UNREACHABLE, ///< A write did not get an HTTP reply, e.g. connection refused; it may be retried
+    NO_ERR_CACHED,   ///< No error, but Redmine is not accessible and the data is taken from the local cache
+};
+
+/**
+ * @brief Check whether a Redmine error code reports success
+ *
+ * @param redmineError Redmine error code
+ *
+ * @return true for RedmineError::NO_ERR and RedmineError::NO_ERR_CACHED, false otherwise
+ */
+inline bool
+isSuccess( RedmineError redmineError )
+{
+    return redmineError == RedmineError::NO_ERR || redmineError == RedmineError::NO_ERR_CACHED;
+}
+
+/// Parse profiles selecting the fields that are decoded from Redmine replies
+enum class ParseProfile
+{
+    FULL,   ///< Decode all fields
+    LIST,   ///< Skip the large fields not needed in list views (description, custom fields)
+    CUSTOM, ///< Skip the fields listed in RedmineOptions::skippedFields
+};
+
+/// Cache policies selecting whether retrievers may answer from the issue store
+enum class CachePolicy
+{
+    NETWORK,                ///< Always wait for Redmine
+    STALE_WHILE_REVALIDATE, ///< Answer from the issue store at once, then again if Redmine returns different data
 };
 
 /// Redmine options
@@ -34,9 +74,16 @@ struct RedmineOptions
     QString parameters;
     bool getAllItems = false;
 
-    RedmineOptions( QString parameters = "", bool getAllItems = false )
+    ParseProfile profile = ParseProfile::FULL; ///< Fields to decode
+    QStringList skippedFields; ///< Member names of the fields skipped by ParseProfile::CUSTOM
+
+    CachePolicy cachePolicy = CachePolicy::NETWORK; ///< Whether cached issues may be returned
+
+    RedmineOptions( QString parameters = "", bool getAllItems = false,
+                    ParseProfile profile = ParseProfile::FULL )
         : parameters( parameters ),
-          getAllItems( getAllItems )
+          getAllItems( getAllItems ),
+          profile( profile )
     {}
 };
 
@@ -66,8 +113,8 @@ struct Item {
 /// Redmine resource
 struct RedmineResource
 {
-    QDateTime createdOn; ///< Created on
-    QDateTime updatedOn; ///< Updated on
+    Timestamp createdOn; ///< Created on
+    Timestamp updatedOn; ///< Updated on
     Item      user;      ///< Redmine user
 };
 
@@ -79,7 +126,7 @@ struct Enumeration : RedmineResource
 {
     int     id = NULL_ID;   ///< ID
     QString name;           ///< Project name
-    bool    isDefault;      ///< Default entry
+    bool    isDefault = false; ///< Default entry
 };
 
 /// @}
@@ -97,18 +144,18 @@ struct CustomField // no RedmineResource
     QVector<QString>     possibleValues; ///< Possible
     QString              defaultValue;   ///< Default value
 
-    QString type;   ///< Customised type
-    QString format; ///< Field format
-    QString regex;  ///< Regular expression
-    int minLength;  ///< Minimum length
-    int maxLength;  ///< Maximum length
-
-    bool allProjects; ///< Custom field may be used by all projects
-    bool isRequired;  ///< Custom field is required
-    bool isFilter;    ///< Custom field may be used as filter
-    bool searchable;  ///< Custom field is searchable
-    bool multiple;    ///< Custom field may contain multiple values
-    bool visible;     ///< Custom field is visible
+    QString type;       ///< Customised type
+    QString format;     ///< Field format
+    QString regex;      ///< Regular expression
+    int minLength = 0;  ///< Minimum length
+    int maxLength = 0;  ///< Maximum length
+
+    bool allProjects = false; ///< Custom field may be used by all projects
+    bool isRequired  = false; ///< Custom field is required
+    bool isFilter    = false; ///< Custom field may be used as filter
+    bool searchable  = false; ///< Custom field is searchable
+    bool multiple    = false; ///< Custom field may contain multiple values
+    bool visible     = false; ///< Custom field is visible
 
     Items projects; ///< Custom field is allowed in these projects
     Items trackers; ///< Custom field is allowed in these trackers
@@ -127,6 +174,70 @@ using CustomFields = QVector<CustomField>;
 /// @name Redmine data structures
 /// @{
 
+/**
+ * @brief Structure representing the value of a custom field in a Redmine resource
+ *
+ * Only the custom field ID and its value(s) are stored per resource. The definition of the custom
+ * field (name, format etc.) is shared by all resources of a Redmine server through its
+ * CustomFieldTable.
+ */
+struct QTREDMINESHARED_EXPORT CustomFieldValue
+{
+    int         id = NULL_ID; ///< Custom field ID
+    QString     value;        ///< First value
+    QStringList moreValues;   ///< Further values of multi-value custom fields
+
+    /// Table holding the definition; nullptr for the default table, see CustomFieldTable::instance()
+    const CustomFieldTable* table = nullptr;
+
+    /**
+     * @brief Get all values
+     *
+     * @return First value followed by the further values
+     */
+    QStringList values() const;
+
+    /**
+     * @brief Get the custom field definition from the custom field table
+     *
+     * @return Custom field definition; empty if the custom field is unknown
+     */
+    CustomField definition() const;
+
+    /**
+     * @brief Get the custom field name from the custom field table
+     *
+     * @return Custom field name
+     */
+    QString name() const;
+};
+
+/// @}
+
+/// @name Redmine data containers
+/// @{
+
+/// Custom field value vector
+using CustomFieldValues = QVector<CustomFieldValue>;
+
+/// @}
+
+/**
+ * @brief Convert custom field values into complete custom fields
+ *
+ * Issue::customFields and TimeEntry::customFields used to be CustomFields. This function provides
+ * the previous representation, with the name and the other definition data taken from the custom
+ * field table, for code that still uses it.
+ *
+ * @param values Custom field values
+ *
+ * @return Custom fields with their definitions and values
+ */
+QTREDMINESHARED_EXPORT CustomFields toCustomFields( const CustomFieldValues& values );
+
+/// @name Redmine data structures
+/// @{
+
 /// Structure representing a group
 struct Group : RedmineResource
 {
@@ -158,7 +269,7 @@ struct Issue : RedmineResource
     double       estimatedHours = 0; ///< Estimated hours
     QDate        startDate;      ///< Start date
 
-    CustomFields customFields;   ///< Custom fields vector
+    CustomFieldValues customFields; ///< Custom field values vector
 };
 
 /// Structure representing an issue category
@@ -175,8 +286,8 @@ struct IssueStatus : RedmineResource
 {
     int     id = NULL_ID;   ///< ID
     QString name;           ///< Issue status name
-    bool    isClosed;       ///< Closed status
-    bool    isDefault;      ///< Default entry
+    bool    isClosed = false;  ///< Closed status
+    bool    isDefault = false; ///< Default entry
 };
 
 /// Structure representing a membership
@@ -196,7 +307,7 @@ struct Project : RedmineResource
 
     QString   description; ///< Description
     QString   identifier;  ///< Internal identifier
-    bool      isPublic;    ///< Public project
+    bool      isPublic = false; ///< Public project
     QString   name;        ///< Project name
     Item      parent;      ///< Parent project
 
@@ -207,6 +318,7 @@ struct Project : RedmineResource
 /// Structure representing a time entry
 struct TimeEntry : RedmineResource
 {
+    int     id = NULL_ID; ///< ID
     Item    activity; ///< Activity
     QString comment;  ///< Additional comment
     double  hours = 0;///< Hours spent
@@ -214,7 +326,7 @@ struct TimeEntry : RedmineResource
     Item    project;  ///< Project (required if no issue was specified)
     QDate   spentOn;  ///< Date of the time spent
 
-    CustomFields customFields;   ///< Custom fields vector
+    CustomFieldValues customFields; ///< Custom field values vector
 };
 
 /// Structure representing a tracker
@@ -259,8 +371,8 @@ struct Version : RedmineResource
 {
     int     id = NULL_ID;   ///< ID
     QString name;           ///< Version name
-    VersionStatus status;   ///< Version open/close status
-    VersionSharing sharing; ///< Version sharing type
+    VersionStatus status = VersionStatus::open;     ///< Version open/close status
+    VersionSharing sharing = VersionSharing::none;  ///< Version sharing type
     QDate   dueDate;        ///< Due date
     QString description;    ///< Description
 };
@@ -308,6 +420,1072 @@ using Versions = QVector<Version>;
 
 /// @}
 
+/// @name Field descriptors
+/// @{
+
+/**
+ * @brief Compile-time field descriptor of a Redmine data structure
+ *
+ * Each specialisation lists all fields of a structure by calling a visitor for every field:
+ *
+ * @code
+ * visitor( name, readKey, writeKey, &Structure::member );
+ * @endcode
+ *
+ * - \c name is the name of the member,
+ * - \c readKey is the JSON key Redmine uses when returning the field,
+ * - \c writeKey is the JSON key Redmine expects when storing the field, or \c nullptr if the field
+ *   cannot be written.
+ *
+ * Parsers, writers, equality operators, hash functions and QDebug stream operators are generated from
+ * these descriptors. Since the visitors are function objects and the members are passed as member
+ * pointers, the generated code is fully inlined and equivalent to hand-written code.
+ *
+ * Furthermore, each specialisation provides the Redmine resource name of the structure, e.g. \c issue.
+ */
+template<typename T>
+struct Fields;
+
+template<>
+struct Fields<Item>
+{
+    static const char* resource() { return nullptr; }
+
+    template<typename V>
+    static void visit( V& v )
+    {
+        v( "id",   "id",   nullptr, &Item::id );
+        v( "name", "name", nullptr, &Item::name );
+    }
+};
+
+template<>
+struct Fields<RedmineResource>
+{
+    static const char* resource() { return nullptr; }
+
+    template<typename V>
+    static void visit( V& v )
+    {
+        v( "createdOn", "created_on", nullptr, &RedmineResource::createdOn );
+        v( "updatedOn", "updated_on", nullptr, &RedmineResource::updatedOn );
+        v( "user",      "user",       nullptr, &RedmineResource::user );
+    }
+};
+
+template<>
+struct Fields<CustomField>
+{
+    static const char* resource() { return "custom_field"; }
+
+    template<typename V>
+    static void visit( V& v )
+    {
+        v( "id",             "id",              nullptr, &CustomField::id );
+        v( "name",           "name",            nullptr, &CustomField::name );
+        v( "values",         nullptr,           nullptr, &CustomField::values );
+        v( "possibleValues", "possible_values", nullptr, &CustomField::possibleValues );
+        v( "defaultValue",   "default_value",   nullptr, &CustomField::defaultValue );
+        v( "type",           "customized_type", nullptr, &CustomField::type );
+        v( "format",         "field_format",    nullptr, &CustomField::format );
+        v( "regex",          "regex",           nullptr, &CustomField::regex );
+        v( "minLength",      "min_length",      nullptr, &CustomField::minLength );
+        v( "maxLength",      "max_length",      nullptr, &CustomField::maxLength );
+        v( "allProjects",    "is_for_all",      nullptr, &CustomField::allProjects );
+        v( "isRequired",     "is_required",     nullptr, &CustomField::isRequired );
+        v( "isFilter",       "is_filter",       nullptr, &CustomField::isFilter );
+        v( "searchable",     "searchable",      nullptr, &CustomField::searchable );
+        v( "multiple",       "multiple",        nullptr, &CustomField::multiple );
+        v( "visible",        "visible",         nullptr, &CustomField::visible );
+        v( "projects",       "projects",        nullptr, &CustomField::projects );
+        v( "trackers",       "trackers",        nullptr, &CustomField::trackers );
+    }
+};
+
+template<>
+struct Fields<CustomFieldValue>
+{
+    static const char* resource() { return nullptr; }
+
+    template<typename V>
+    static void visit( V& v )
+    {
+        v( "id",         "id",    "id",    &CustomFieldValue::id );
+        v( "value",      "value", "value", &CustomFieldValue::value );
+        v( "moreValues", nullptr, nullptr, &CustomFieldValue::moreValues );
+    }
+};
+
+template<>
+struct Fields<Enumeration>
+{
+    static const char* resource() { return "enumeration"; }
+
+    template<typename V>
+    static void visit( V& v )
+    {
+        v( "id",        "id",         nullptr,      &Enumeration::id );
+        v( "name",      "name",       "name",       &Enumeration::name );
+        v( "isDefault", "is_default", "is_default", &Enumeration::isDefault );
+
+        Fields<RedmineResource>::visit( v );
+    }
+};
+
+template<>
+struct Fields<Group>
+{
+    static const char* resource() { return "group"; }
+
+    template<typename V>
+    static void visit( V& v )
+    {
+        v( "id",      "id",    nullptr, &Group::id );
+        v( "name",    "name",  "name",  &Group::name );
+        v( "members", "users", nullptr, &Group::members );
+
+        Fields<RedmineResource>::visit( v );
+    }
+};
+
+template<>
+struct Fields<Issue>
+{
+    static const char* resource() { return "issue"; }
+
+    template<typename V>
+    static void visit( V& v )
+    {
+        v( "id",             "id",              nullptr,            &Issue::id );
+        v( "parentId",       "parent",          "parent_issue_id",  &Issue::parentId );
+        v( "description",    "description",     "description",      &Issue::description );
+        v( "doneRatio",      "done_ratio",      nullptr,            &Issue::doneRatio );
+        v( "subject",        "subject",         "subject",          &Issue::subject );
+        v( "assignedTo",     "assigned_to",     "assigned_to_id",   &Issue::assignedTo );
+        v( "author",         "author",          nullptr,            &Issue::author );
+        v( "category",       "category",        "category_id",      &Issue::category );
+        v( "priority",       "priority",        "priority_id",      &Issue::priority );
+        v( "project",        "project",         "project_id",       &Issue::project );
+        v( "status",         "status",          "status_id",        &Issue::status );
+        v( "tracker",        "tracker",         "tracker_id",       &Issue::tracker );
+        v( "version",        "fixed_version",   "fixed_version_id", &Issue::version );
+        v( "dueDate",        "due_date",        "due_date",         &Issue::dueDate );
+        v( "estimatedHours", "estimated_hours", "estimated_hours",  &Issue::estimatedHours );
+        v( "startDate",      "start_date",      "start_date",       &Issue::startDate );
+        v( "customFields",   "custom_fields",   "custom_fields",    &Issue::customFields );
+
+        Fields<RedmineResource>::visit( v );
+    }
+};
+
+template<>
+struct Fields<IssueCategory>
+{
+    static const char* resource() { return "issue_category"; }
+
+    template<typename V>
+    static void visit( V& v )
+    {
+        v( "id",         "id",          nullptr,          &IssueCategory::id );
+        v( "name",       "name",        "name",           &IssueCategory::name );
+        v( "project",    "project",     nullptr,          &IssueCategory::project );
+        v( "assignedTo", "assigned_to", "assigned_to_id", &IssueCategory::assignedTo );
+    }
+};
+
+template<>
+struct Fields<IssueStatus>
+{
+    static const char* resource() { return "issue_status"; }
+
+    template<typename V>
+    static void visit( V& v )
+    {
+        v( "id",        "id",         nullptr,      &IssueStatus::id );
+        v( "name",      "name",       "name",       &IssueStatus::name );
+        v( "isClosed",  "is_closed",  "is_closed",  &IssueStatus::isClosed );
+        v( "isDefault", "is_default", "is_default", &IssueStatus::isDefault );
+
+        Fields<RedmineResource>::visit( v );
+    }
+};
+
+template<>
+struct Fields<Membership>
+{
+    static const char* resource() { return "membership"; }
+
+    template<typename V>
+    static void visit( V& v )
+    {
+        // Membership::user hides RedmineResource::user
+        v( "id",        "id",         nullptr,   &Membership::id );
+        v( "project",   "project",    nullptr,   &Membership::project );
+        v( "user",      "user",       "user_id", &Membership::user );
+        v( "group",     "group",      nullptr,   &Membership::group );
+        v( "roles",     "roles",      nullptr,   &Membership::roles );
+        v( "createdOn", "created_on", nullptr,   &RedmineResource::createdOn );
+        v( "updatedOn", "updated_on", nullptr,   &RedmineResource::updatedOn );
+    }
+};
+
+template<>
+struct Fields<Project>
+{
+    static const char* resource() { return "project"; }
+
+    template<typename V>
+    static void visit( V& v )
+    {
+        v( "id",          "id",               nullptr,       &Project::id );
+        v( "description", "description",      "description", &Project::description );
+        v( "identifier",  "identifier",       "identifier",  &Project::identifier );
+        v( "isPublic",    "is_public",        "is_public",   &Project::isPublic );
+        v( "name",        "name",             "name",        &Project::name );
+        v( "parent",      "parent",           "parent_id",   &Project::parent );
+        v( "trackers",    "trackers",         "tracker_ids", &Project::trackers );
+        v( "categories",  "issue_categories", nullptr,       &Project::categories );
+
+        Fields<RedmineResource>::visit( v );
+    }
+};
+
+template<>
+struct Fields<TimeEntry>
+{
+    static const char* resource() { return "time_entry"; }
+
+    template<typename V>
+    static void visit( V& v )
+    {
+        v( "id",           "id",            nullptr,         &TimeEntry::id );
+        v( "activity",     "activity",      "activity_id",   &TimeEntry::activity );
+        v( "comment",      "comments",      "comments",      &TimeEntry::comment );
+        v( "hours",        "hours",         "hours",         &TimeEntry::hours );
+        v( "issue",        "issue",         "issue_id",      &TimeEntry::issue );
+        v( "project",      "project",       "project_id",    &TimeEntry::project );
+        v( "spentOn",      "spent_on",      "spent_on",      &TimeEntry::spentOn );
+        v( "customFields", "custom_fields", "custom_fields", &TimeEntry::customFields );
+
+        Fields<RedmineResource>::visit( v );
+    }
+};
+
+template<>
+struct Fields<Tracker>
+{
+    static const char* resource() { return "tracker"; }
+
+    template<typename V>
+    static void visit( V& v )
+    {
+        v( "id",   "id",   nullptr, &Tracker::id );
+        v( "name", "name", "name",  &Tracker::name );
+
+        Fields<RedmineResource>::visit( v );
+    }
+};
+
+template<>
+struct Fields<User>
+{
+    static const char* resource() { return "user"; }
+
+    template<typename V>
+    static void visit( V& v )
+    {
+        v( "id",          "id",            nullptr,     &User::id );
+        v( "login",       "login",         "login",     &User::login );
+        v( "firstname",   "firstname",     "firstname", &User::firstname );
+        v( "lastname",    "lastname",      "lastname",  &User::lastname );
+        v( "mail",        "mail",          "mail",      &User::mail );
+        v( "lastLoginOn", "last_login_on", nullptr,     &User::lastLoginOn );
+
+        Fields<RedmineResource>::visit( v );
+    }
+};
+
+template<>
+struct Fields<Version>
+{
+    static const char* resource() { return "version"; }
+
+    template<typename V>
+    static void visit( V& v )
+    {
+        v( "id",          "id",          nullptr,       &Version::id );
+        v( "name",        "name",        "name",        &Version::name );
+        v( "status",      "status",      "status",      &Version::status );
+        v( "sharing",     "sharing",     "sharing",     &Version::sharing );
+        v( "dueDate",     "due_date",    "due_date",    &Version::dueDate );
+        v( "description", "description", "description", &Version::description );
+
+        Fields<RedmineResource>::visit( v );
+    }
+};
+
+/// @}
+
+/// @name Field values
+/// @{
+
+/**
+ * @brief Read a field value from JSON
+ *
+ * References to other resources, e.g. <tt>"parent": {"id": 1}</tt>, may be read into integer fields.
+ * Arrays replace the previous contents of the value.
+ *
+ * @param json  JSON value
+ * @param value Field value
+ */
+QTREDMINESHARED_EXPORT void readValue( const QJsonValue& json, bool& value );
+QTREDMINESHARED_EXPORT void readValue( const QJsonValue& json, int& value );              ///< @overload
+QTREDMINESHARED_EXPORT void readValue( const QJsonValue& json, double& value );           ///< @overload
+QTREDMINESHARED_EXPORT void readValue( const QJsonValue& json, QString& value );          ///< @overload
+QTREDMINESHARED_EXPORT void readValue( const QJsonValue& json, QStringList& value );      ///< @overload
+QTREDMINESHARED_EXPORT void readValue( const QJsonValue& json, QVector<QString>& value ); ///< @overload
+QTREDMINESHARED_EXPORT void readValue( const QJsonValue& json, QDate& value );            ///< @overload
+QTREDMINESHARED_EXPORT void readValue( const QJsonValue& json, QDateTime& value );        ///< @overload
+QTREDMINESHARED_EXPORT void readValue( const QJsonValue& json, Timestamp& value );        ///< @overload
+QTREDMINESHARED_EXPORT void readValue( const QJsonValue& json, Item& value );             ///< @overload
+QTREDMINESHARED_EXPORT void readValue( const QJsonValue& json, Items& value );            ///< @overload
+QTREDMINESHARED_EXPORT void readValue( const QJsonValue& json, VersionStatus& value );    ///< @overload
+QTREDMINESHARED_EXPORT void readValue( const QJsonValue& json, VersionSharing& value );   ///< @overload
+
+/**
+ * @brief Read custom field values from JSON
+ *
+ * The custom field definitions are added to the custom field table.
+ *
+ * @param json     JSON value
+ * @param value    Custom field values
+ * @param resource Resource type the custom fields belong to, e.g. \c issue
+ * @param table    Custom field table of the Redmine server; nullptr for the default table
+ */
+QTREDMINESHARED_EXPORT void readValue( const QJsonValue& json, CustomFieldValues& value, const char* resource,
+                                       CustomFieldTable* table = nullptr );
+
+/**
+ * @brief Convert a field value into JSON
+ *
+ * Items are written as their ID.
+ *
+ * @param value Field value
+ *
+ * @return JSON value
+ */
+QTREDMINESHARED_EXPORT QJsonValue writeValue( bool value );
+QTREDMINESHARED_EXPORT QJsonValue writeValue( int value );                      ///< @overload
+QTREDMINESHARED_EXPORT QJsonValue writeValue( double value );                   ///< @overload
+QTREDMINESHARED_EXPORT QJsonValue writeValue( const QString& value );           ///< @overload
+QTREDMINESHARED_EXPORT QJsonValue writeValue( const QStringList& value );       ///< @overload
+QTREDMINESHARED_EXPORT QJsonValue writeValue( const QVector<QString>& value );  ///< @overload
+QTREDMINESHARED_EXPORT QJsonValue writeValue( const QDate& value );             ///< @overload
+QTREDMINESHARED_EXPORT QJsonValue writeValue( const QDateTime& value );         ///< @overload
+QTREDMINESHARED_EXPORT QJsonValue writeValue( const Timestamp& value );         ///< @overload
+QTREDMINESHARED_EXPORT QJsonValue writeValue( const Item& value );              ///< @overload
+QTREDMINESHARED_EXPORT QJsonValue writeValue( const Items& value );             ///< @overload
+QTREDMINESHARED_EXPORT QJsonValue writeValue( const CustomFieldValues& value ); ///< @overload
+QTREDMINESHARED_EXPORT QJsonValue writeValue( VersionStatus value );            ///< @overload
+QTREDMINESHARED_EXPORT QJsonValue writeValue( VersionSharing value );           ///< @overload
+
+/**
+ * @brief Write a field value directly as compact JSON
+ *
+ * Produces the same JSON as the corresponding writeValue() overload returning a QJsonValue.
+ *
+ * @param writer JSON writer
+ * @param value  Field value
+ */
+QTREDMINESHARED_EXPORT void writeValue( JsonWriter& writer, bool value );
+QTREDMINESHARED_EXPORT void writeValue( JsonWriter& writer, int value );                      ///< @overload
+QTREDMINESHARED_EXPORT void writeValue( JsonWriter& writer, double value );                   ///< @overload
+QTREDMINESHARED_EXPORT void writeValue( JsonWriter& writer, const QString& value );           ///< @overload
+QTREDMINESHARED_EXPORT void writeValue( JsonWriter& writer, const QStringList& value );       ///< @overload
+QTREDMINESHARED_EXPORT void writeValue( JsonWriter& writer, const QVector<QString>& value );  ///< @overload
+QTREDMINESHARED_EXPORT void writeValue( JsonWriter& writer, const QDate& value );             ///< @overload
+QTREDMINESHARED_EXPORT void writeValue( JsonWriter& writer, const QDateTime& value );         ///< @overload
+QTREDMINESHARED_EXPORT void writeValue( JsonWriter& writer, const Timestamp& value );         ///< @overload
+QTREDMINESHARED_EXPORT void writeValue( JsonWriter& writer, const Item& value );              ///< @overload
+QTREDMINESHARED_EXPORT void writeValue( JsonWriter& writer, const Items& value );             ///< @overload
+QTREDMINESHARED_EXPORT void writeValue( JsonWriter& writer, const CustomFieldValues& value ); ///< @overload
+QTREDMINESHARED_EXPORT void writeValue( JsonWriter& writer, VersionStatus value );            ///< @overload
+QTREDMINESHARED_EXPORT void writeValue( JsonWriter& writer, VersionSharing value );           ///< @overload
+
+/**
+ * @brief Check whether a field value is set and should be written
+ *
+ * @param value Field value
+ *
+ * @return true if the value is set, false otherwise
+ */
+inline bool isSet( bool )                            { return true; }
+inline bool isSet( int value )                       { return value != NULL_ID; }       ///< @overload
+inline bool isSet( double value )                    { return value != 0; }             ///< @overload
+inline bool isSet( const QString& value )            { return !value.isEmpty(); }       ///< @overload
+inline bool isSet( const QStringList& value )        { return !value.isEmpty(); }       ///< @overload
+inline bool isSet( const QVector<QString>& value )   { return !value.isEmpty(); }       ///< @overload
+inline bool isSet( const QDate& value )              { return value.isValid(); }        ///< @overload
+inline bool isSet( const QDateTime& value )          { return value.isValid(); }        ///< @overload
+inline bool isSet( const Timestamp& value )          { return value.isValid(); }        ///< @overload
+inline bool isSet( const Item& value )               { return value.id != NULL_ID; }    ///< @overload
+inline bool isSet( const Items& value )              { return !value.isEmpty(); }       ///< @overload
+inline bool isSet( const CustomFieldValues& value )  { return !value.isEmpty(); }       ///< @overload
+inline bool isSet( VersionStatus )                   { return true; }                   ///< @overload
+inline bool isSet( VersionSharing )                  { return true; }                   ///< @overload
+
+/**
+ * @brief Combine a hash value into a seed
+ *
+ * @param seed Seed
+ * @param hash Hash value
+ *
+ * @return Combined hash value
+ */
+inline uint
+hashCombine( uint seed, uint hash )
+{
+    return seed ^ (hash + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+/**
+ * @brief Hash a field value
+ *
+ * @param value Field value
+ * @param seed  Seed
+ *
+ * @return Hash value
+ */
+template<typename V>
+inline uint
+hashValue( const V& value, uint seed )
+{
+    return qHash( value, seed );
+}
+
+inline uint hashValue( bool value, uint seed )             { return qHash( static_cast<int>(value), seed ); } ///< @overload
+inline uint hashValue( const Timestamp& value, uint seed ) { return qHash( value.toMSecsSinceEpoch(), seed ); } ///< @overload
+inline uint hashValue( VersionStatus value, uint seed )    { return qHash( static_cast<int>(value), seed ); } ///< @overload
+inline uint hashValue( VersionSharing value, uint seed )   { return qHash( static_cast<int>(value), seed ); } ///< @overload
+
+/// @overload
+template<typename V>
+inline uint
+hashValue( const QVector<V>& values, uint seed )
+{
+    for( const auto& value : values )
+        seed = hashCombine( seed, hashValue(value, 0) );
+
+    return seed;
+}
+
+/// @}
+
+/// @name Field visitors
+/// @{
+
+/// Visitor comparing all fields of two structures
+template<typename T>
+struct FieldComparator
+{
+    const T& a;         ///< First structure
+    const T& b;         ///< Second structure
+    bool equal = true;  ///< All fields visited so far are equal
+
+    FieldComparator( const T& a, const T& b ) : a( a ), b( b ) {}
+
+    template<typename M, typename C>
+    void operator()( const char*, const char*, const char*, M C::* member )
+    {
+        equal = equal && a.*member == b.*member;
+    }
+};
+
+/// Visitor hashing all fields of a structure
+template<typename T>
+struct FieldHasher
+{
+    const T& data; ///< Structure
+    uint seed;     ///< Hash value so far
+
+    FieldHasher( const T& data, uint seed ) : data( data ), seed( seed ) {}
+
+    template<typename M, typename C>
+    void operator()( const char*, const char*, const char*, M C::* member )
+    {
+        seed = hashCombine( seed, hashValue(data.*member, 0) );
+    }
+};
+
+/// Visitor reading all readable fields of a structure from a JSON object
+template<typename T>
+struct FieldReader
+{
+    T& data;                 ///< Structure
+    const QJsonObject& obj;  ///< JSON object
+    quint64 skip;            ///< Field mask of the fields to skip
+    CustomFieldTable* table; ///< Custom field table of the Redmine server; nullptr for the default table
+    int index = 0;           ///< Index of the current field
+
+    FieldReader( T& data, const QJsonObject& obj, quint64 skip = 0, CustomFieldTable* table = nullptr )
+        : data( data ), obj( obj ), skip( skip ), table( table ) {}
+
+    template<typename M, typename C>
+    void operator()( const char*, const char* key, const char*, M C::* member )
+    {
+        QJsonValue json;
+
+        if( value(key, json) )
+            readValue( json, data.*member );
+    }
+
+    template<typename C>
+    void operator()( const char*, const char* key, const char*, CustomFieldValues C::* member )
+    {
+        QJsonValue json;
+
+        if( value(key, json) )
+            readValue( json, data.*member, Fields<T>::resource(), table );
+    }
+
+    bool value( const char* key, QJsonValue& json )
+    {
+        if( skip & (Q_UINT64_C(1) << index++) )
+            return false;
+
+        if( !key )
+            return false;
+
+        // Looking up a Latin-1 key does not allocate a temporary QString
+        json = obj.value( QLatin1String(key) );
+
+        return !json.isUndefined() && !json.isNull();
+    }
+};
+
+/// Visitor building the field mask of a list of member names
+template<typename T>
+struct FieldMasker
+{
+    const QStringList& names; ///< Member names
+    quint64 mask = 0;         ///< Field mask
+    int index = 0;            ///< Index of the current field
+
+    FieldMasker( const QStringList& names ) : names( names ) {}
+
+    template<typename M, typename C>
+    void operator()( const char* name, const char*, const char*, M C::* )
+    {
+        if( names.contains(QString::fromLatin1(name)) )
+            mask |= Q_UINT64_C(1) << index;
+
+        ++index;
+    }
+};
+
+/// Visitor writing all writable and set fields of a structure into a JSON object
+template<typename T>
+struct FieldWriter
+{
+    const T& data;    ///< Structure
+    QJsonObject& obj; ///< JSON object
+
+    FieldWriter( const T& data, QJsonObject& obj ) : data( data ), obj( obj ) {}
+
+    template<typename M, typename C>
+    void operator()( const char*, const char*, const char* key, M C::* member )
+    {
+        if( key && isSet(data.*member) )
+            obj.insert( QString::fromLatin1(key), writeValue(data.*member) );
+    }
+};
+
+/// Visitor writing all writable and set fields of a structure as compact JSON
+template<typename T>
+struct FieldJsonWriter
+{
+    const T& data;      ///< Structure
+    JsonWriter& writer; ///< JSON writer
+
+    FieldJsonWriter( const T& data, JsonWriter& writer ) : data( data ), writer( writer ) {}
+
+    template<typename M, typename C>
+    void operator()( const char*, const char*, const char* key, M C::* member )
+    {
+        if( key && isSet(data.*member) )
+            writeValue( writer.key(key), data.*member );
+    }
+};
+
+/// Visitor writing all writable fields that differ from an original structure as compact JSON
+template<typename T>
+struct FieldPatchWriter
+{
+    const T& data;      ///< Modified structure
+    const T& original;  ///< Original structure
+    JsonWriter& writer; ///< JSON writer
+    int changes = 0;    ///< Number of fields written
+
+    FieldPatchWriter( const T& data, const T& original, JsonWriter& writer )
+        : data( data ), original( original ), writer( writer ) {}
+
+    template<typename M, typename C>
+    void operator()( const char*, const char*, const char* key, M C::* member )
+    {
+        if( !key || data.*member == original.*member )
+            return;
+
+        // Cleared fields are sent as null, except strings which are sent as empty strings
+        writer.key( key );
+
+        if( isSet(data.*member) || std::is_same<M, QString>::value )
+            writeValue( writer, data.*member );
+        else
+            writer.null();
+
+        ++changes;
+    }
+
+    template<typename C>
+    void operator()( const char*, const char*, const char* key, CustomFieldValues C::* member )
+    {
+        if( !key )
+            return;
+
+        // Only send the custom fields whose values changed
+        CustomFieldValues changed;
+
+        for( const auto& value : data.*member )
+        {
+            bool unchanged = false;
+
+            for( const auto& originalValue : original.*member )
+            {
+                if( originalValue.id == value.id )
+                {
+                    unchanged = originalValue == value;
+                    break;
+                }
+            }
+
+            if( !unchanged )
+                changed.push_back( value );
+        }
+
+        if( changed.isEmpty() )
+            return;
+
+        writeValue( writer.key(key), changed );
+        ++changes;
+    }
+};
+
+/// Visitor applying the written fields of a structure to another one, e.g. a cached copy
+template<typename T>
+struct FieldMerger
+{
+    T& data;             ///< Structure to update
+    const T& written;    ///< Structure that has been written
+    const T* original;   ///< Original structure of a patch; if null, all set fields were written
+
+    FieldMerger( T& data, const T& written, const T* original )
+        : data( data ), written( written ), original( original ) {}
+
+    /// Check whether a field has been written
+    template<typename M, typename C>
+    bool isWritten( M C::* member ) const
+    {
+        return original ? !(written.*member == original->*member) : isSet( written.*member );
+    }
+
+    template<typename M, typename C>
+    void operator()( const char*, const char*, const char* key, M C::* member )
+    {
+        if( key && isWritten(member) )
+            data.*member = written.*member;
+    }
+
+    template<typename C>
+    void operator()( const char*, const char*, const char* key, Item C::* member )
+    {
+        // Only the ID is written, so keep the cached name if the ID did not change
+        if( key && isWritten(member) && (data.*member).id != (written.*member).id )
+            data.*member = written.*member;
+    }
+
+    template<typename C>
+    void operator()( const char*, const char*, const char* key, CustomFieldValues C::* member )
+    {
+        if( !key )
+            return;
+
+        // Custom field values are written individually, so replace them by ID
+        for( const auto& value : written.*member )
+        {
+            if( original && (original->*member).contains(value) )
+                continue;
+
+            bool found = false;
+
+            for( auto& dataValue : data.*member )
+            {
+                if( dataValue.id == value.id )
+                {
+                    dataValue = value;
+                    found = true;
+                    break;
+                }
+            }
+
+            if( !found )
+                (data.*member).push_back( value );
+        }
+    }
+};
+
+/// Visitor writing all fields of a structure into a QDebug stream
+template<typename T>
+struct FieldDebugWriter
+{
+    const T& data;     ///< Structure
+    QDebug& debug;     ///< Debug stream
+    bool first = true; ///< No field has been written yet
+
+    FieldDebugWriter( const T& data, QDebug& debug ) : data( data ), debug( debug ) {}
+
+    template<typename M, typename C>
+    void operator()( const char* name, const char*, const char*, M C::* member )
+    {
+        debug << (first ? "(" : ", ") << name << "=" << data.*member;
+        first = false;
+    }
+};
+
+/// @}
+
+/// @name Generated functions
+/// @{
+
+/**
+ * @brief Compare all fields of two structures
+ *
+ * @return true if all fields are equal, false otherwise
+ */
+template<typename T>
+inline bool
+fieldsEqual( const T& a, const T& b )
+{
+    FieldComparator<T> comparator( a, b );
+    Fields<T>::visit( comparator );
+    return comparator.equal;
+}
+
+/**
+ * @brief Hash all fields of a structure
+ *
+ * @return Hash value
+ */
+template<typename T>
+inline uint
+hashFields( const T& data, uint seed = 0 )
+{
+    FieldHasher<T> hasher( data, seed );
+    Fields<T>::visit( hasher );
+    return hasher.seed;
+}
+
+/**
+ * @brief Read all fields of a structure from its Redmine JSON representation
+ *
+ * Fields missing in the JSON object keep their previous value.
+ *
+ * @param data Structure
+ * @param obj  JSON object
+ */
+template<typename T>
+inline void
+readFields( T& data, const QJsonObject& obj )
+{
+    FieldReader<T> reader( data, obj );
+    Fields<T>::visit( reader );
+}
+
+/**
+ * @brief Read the fields of a structure from its Redmine JSON representation, skipping some fields
+ *
+ * Skipped fields are not decoded at all and keep their previous value.
+ *
+ * @param data  Structure
+ * @param obj   JSON object
+ * @param skip  Field mask of the fields to skip, see fieldMask()
+ * @param table Custom field table of the Redmine server; nullptr for the default table
+ */
+template<typename T>
+inline void
+readFields( T& data, const QJsonObject& obj, quint64 skip, CustomFieldTable* table = nullptr )
+{
+    FieldReader<T> reader( data, obj, skip, table );
+    Fields<T>::visit( reader );
+}
+
+/**
+ * @brief Read the structures of a Redmine JSON array, skipping some fields
+ *
+ * The vector is resized to the size of the array and the structures are decoded in place, without
+ * copying them.
+ *
+ * @param items Structures
+ * @param array JSON array, e.g. the \c issues array of a reply
+ * @param skip  Field mask of the fields to skip, see fieldMask()
+ * @param table Custom field table of the Redmine server; nullptr for the default table
+ */
+template<typename T>
+inline void
+readItems( QVector<T>& items, const QJsonArray& array, quint64 skip, CustomFieldTable* table = nullptr )
+{
+    const int count = array.size();
+    items.resize( count );
+
+    for( int i = 0; i < count; ++i )
+        readFields( items[i], array.at(i).toObject(), skip, table );
+}
+
+/**
+ * @brief Get the field mask of a list of member names
+ *
+ * Bit \c i of the mask is set if the \c i-th field of the field descriptor is listed.
+ *
+ * @param names Member names, e.g. \c description
+ *
+ * @return Field mask
+ */
+template<typename T>
+inline quint64
+fieldMask( const QStringList& names )
+{
+    FieldMasker<T> masker( names );
+    Fields<T>::visit( masker );
+    return masker.mask;
+}
+
+/**
+ * @brief Get the field mask of the fields skipped by the parse profile of the options
+ *
+ * @param options Redmine options
+ *
+ * @return Field mask
+ */
+template<typename T>
+inline quint64
+skippedFields( const RedmineOptions& options )
+{
+    switch( options.profile )
+    {
+    case ParseProfile::FULL:   return 0;
+    case ParseProfile::LIST:   return fieldMask<T>( QStringList() << "description" << "customFields" );
+    case ParseProfile::CUSTOM: return fieldMask<T>( options.skippedFields );
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Write all writable and set fields of a structure into a JSON object
+ *
+ * @param data Structure
+ *
+ * @return JSON object with the Redmine representation of the structure
+ */
+template<typename T>
+inline QJsonObject
+writeFields( const T& data )
+{
+    QJsonObject obj;
+    FieldWriter<T> writer( data, obj );
+    Fields<T>::visit( writer );
+    return obj;
+}
+
+/**
+ * @brief Write all writable and set fields of a structure as compact JSON object
+ *
+ * @param data   Structure
+ * @param writer JSON writer
+ */
+template<typename T>
+inline void
+writeFields( const T& data, JsonWriter& writer )
+{
+    writer.beginObject();
+    FieldJsonWriter<T> fieldWriter( data, writer );
+    Fields<T>::visit( fieldWriter );
+    writer.endObject();
+}
+
+/**
+ * @brief Create the body of a create or update request for a structure
+ *
+ * The body is written directly as compact JSON, e.g. <tt>{"issue":{"subject":"..."}}</tt>, without
+ * building a QJsonDocument first.
+ *
+ * @param data Structure
+ *
+ * @return Request body
+ */
+template<typename T>
+inline QByteArray
+requestBody( const T& data )
+{
+    JsonWriter writer;
+    writer.beginObject();
+    writeFields( data, writer.key(Fields<T>::resource()) );
+    writer.endObject();
+    return writer.data();
+}
+
+/**
+ * @brief Create the body of an update request containing only the modified fields
+ *
+ * Compares all writable fields of \c data with \c original, e.g. the structure as retrieved from
+ * Redmine, and writes only those that differ. Fields that were cleared are sent as null, custom
+ * fields are sent only if their value changed.
+ *
+ * @param data     Modified structure
+ * @param original Original structure
+ * @param changes  If not null, receives the number of modified fields
+ *
+ * @return Request body, e.g. <tt>{"issue":{"status_id":5}}</tt>
+ */
+template<typename T>
+inline QByteArray
+patchBody( const T& data, const T& original, int* changes = nullptr )
+{
+    JsonWriter writer;
+    writer.beginObject();
+    writer.key( Fields<T>::resource() ).beginObject();
+
+    FieldPatchWriter<T> patchWriter( data, original, writer );
+    Fields<T>::visit( patchWriter );
+
+    writer.endObject();
+    writer.endObject();
+
+    if( changes )
+        *changes = patchWriter.changes;
+
+    return writer.data();
+}
+
+/**
+ * @brief Apply the writable and set fields of a written structure to another one
+ *
+ * Used to update a cached copy after a successful create or update request, without retrieving the
+ * structure again. References keep their cached names unless their ID changed.
+ *
+ * @param data    Structure to update
+ * @param written Structure that has been written with requestBody()
+ */
+template<typename T>
+inline void
+mergeFields( T& data, const T& written )
+{
+    FieldMerger<T> merger( data, written, nullptr );
+    Fields<T>::visit( merger );
+}
+
+/**
+ * @brief Apply the fields of a patch to another structure
+ *
+ * @param data     Structure to update
+ * @param written  Modified structure that has been written with patchBody()
+ * @param original Original structure passed to patchBody()
+ */
+template<typename T>
+inline void
+mergeFields( T& data, const T& written, const T& original )
+{
+    FieldMerger<T> merger( data, written, &original );
+    Fields<T>::visit( merger );
+}
+
+/**
+ * @brief Write all fields of a structure into a QDebug stream
+ *
+ * Like DEBUGFIELDS, this only writes output if \c DEBUG_OUTPUT is defined.
+ *
+ * @param debug Debug stream
+ * @param data  Structure
+ */
+template<typename T>
+inline void
+debugFields( QDebug& debug, const T& data )
+{
+#ifdef DEBUG_OUTPUT
+    QDebugStateSaver saver( debug );
+    debug.nospace();
+
+    FieldDebugWriter<T> writer( data, debug );
+    Fields<T>::visit( writer );
+
+    if( !writer.first )
+        debug << ")";
+#else
+    Q_UNUSED( debug );
+    Q_UNUSED( data );
+#endif
+}
+
+/// Define equality operators and a hash function for a structure with a field descriptor
+#define FIELD_OPERATORS(T) \
+    inline bool operator==( const T& a, const T& b ) { return fieldsEqual( a, b ); } \
+    inline bool operator!=( const T& a, const T& b ) { return !fieldsEqual( a, b ); } \
+    inline uint qHash( const T& data, uint seed = 0 ) { return hashFields( data, seed ); }
+
+FIELD_OPERATORS( Item )
+FIELD_OPERATORS( RedmineResource )
+FIELD_OPERATORS( CustomField )
+FIELD_OPERATORS( CustomFieldValue )
+FIELD_OPERATORS( Enumeration )
+FIELD_OPERATORS( Group )
+FIELD_OPERATORS( Issue )
+FIELD_OPERATORS( IssueCategory )
+FIELD_OPERATORS( IssueStatus )
+FIELD_OPERATORS( Membership )
+FIELD_OPERATORS( Project )
+FIELD_OPERATORS( TimeEntry )
+FIELD_OPERATORS( Tracker )
+FIELD_OPERATORS( User )
+FIELD_OPERATORS( Version )
+
+#undef FIELD_OPERATORS
+
+/// Data needed at startup, retrieved concurrently by SimpleRedmineClient::bootstrap()
+struct Bootstrap
+{
+    User          currentUser;         ///< Current user
+    Projects      projects;            ///< Projects
+    Trackers      trackers;            ///< Trackers
+    IssueStatuses issueStatuses;       ///< Issue statuses
+    Enumerations  issuePriorities;     ///< Issue priorities
+    Enumerations  timeEntryActivities; ///< Time entry activities
+
+    qint64  latency = 0; ///< Critical path latency in milliseconds, i.e. the time until the last reply arrived
+    QString slowest;     ///< Name of the request on the critical path, e.g. \c projects
+};
+
+/// Statistics of an incremental issue synchronisation by SimpleRedmineClient::syncIssues()
+struct SyncStatistics
+{
+    int       fetched = 0;      ///< Number of issues transferred
+    int       changed = 0;      ///< Number of new or modified issues in the store
+    bool      full = false;     ///< No cursor was set, so all issues were transferred
+    bool      complete = true;  ///< All matching issues were transferred; otherwise the cursor was kept
+    Timestamp cursor;           ///< Cursor for the next synchronisation
+    qint64    duration = 0;     ///< Duration in milliseconds
+};
+
+/// @}
+
 /// @name Callbacks
 /// @{
 
@@ -321,6 +1499,24 @@ using Versions = QVector<Version>;
  */
 using SuccessCb = std::function<void(bool, int, RedmineError, QStringList)>;
 
+/**
+ * Typedef for a bootstrap callback function
+ *
+ * @param Bootstrap Startup data
+ * @param RedmineError Redmine error code of the first failed request
+ * @param QStringList Errors that Redmine returned
+ */
+using BootstrapCb = std::function<void(Bootstrap, RedmineError, QStringList)>;
+
+/**
+ * Typedef for an issue synchronisation callback function
+ *
+ * @param SyncStatistics Synchronisation statistics
+ * @param RedmineError Redmine error code
+ * @param QStringList Errors that Redmine returned
+ */
+using SyncCb = std::function<void(SyncStatistics, RedmineError, QStringList)>;
+
 /**
  * Typedef for an custom fields callback function
  *
@@ -489,58 +1685,67 @@ operator<<( QDebug debug, const qtredmine::RedmineError& data )
         debug << "ERR_TIME_ENTRY_TOO_SHORT";
     else if( data == qtredmine::RedmineError::ERR_TIMEOUT )
         debug << "ERR_TIMEOUT";
+    else if( data == qtredmine::RedmineError::ERR_UNREACHABLE )
+        debug << "ERR_UNREACHABLE";
+    else if( data == qtredmine::RedmineError::NO_ERR_CACHED )
+        debug << "NO_ERR_CACHED";
     return debug;
 }
 
 /**
- * @brief QDebug stream operator for items
+ * @brief QDebug stream operator for version status
  * @return QDebug object
  */
 inline QDebug
-operator<<( QDebug debug, const qtredmine::Item& data )
+operator<<( QDebug debug, qtredmine::VersionStatus data )
 {
     QDebugStateSaver saver( debug );
-    DEBUGFIELDS(id)(name);
+    debug.noquote() << qtredmine::writeValue( data ).toString();
     return debug;
 }
 
 /**
- * @brief QDebug stream operator for custom fields
+ * @brief QDebug stream operator for version sharing
  * @return QDebug object
  */
 inline QDebug
-operator<<( QDebug debug, const qtredmine::CustomField& data )
+operator<<( QDebug debug, qtredmine::VersionSharing data )
 {
     QDebugStateSaver saver( debug );
-    DEBUGFIELDS(id)(name)(values)(possibleValues)(defaultValue)(type)(format)(regex)(minLength)(maxLength)
-            (allProjects)(isRequired)(isFilter)(searchable)(multiple)(visible)(projects)(trackers);
+    debug.noquote() << qtredmine::writeValue( data ).toString();
     return debug;
 }
 
-/**
- * @brief QDebug stream operator for issues
- * @return QDebug object
- */
-inline QDebug
-operator<<( QDebug debug, const qtredmine::Issue& data )
-{
-    QDebugStateSaver saver( debug );
-    DEBUGFIELDS(id)(parentId)(description)(doneRatio)(subject)(assignedTo)(author)(category)(priority)
-            (project)(status)(tracker)(version)(dueDate)(estimatedHours)(startDate)(customFields);
-    return debug;
-}
+/// Define a QDebug stream operator for a structure with a field descriptor
+#define FIELD_DEBUG_OPERATOR(T) \
+    inline QDebug operator<<( QDebug debug, const qtredmine::T& data ) \
+    { \
+        qtredmine::debugFields( debug, data ); \
+        return debug; \
+    }
 
-/**
- * @brief QDebug stream operator for memberships
- * @return QDebug object
- */
-inline QDebug
-operator<<( QDebug debug, const qtredmine::Membership& data )
-{
-    QDebugStateSaver saver( debug );
-    DEBUGFIELDS(id)(project)(user)(group)(roles);
-    return debug;
-}
+/// @name QDebug stream operators for Redmine data structures
+/// @{
+
+FIELD_DEBUG_OPERATOR( Item )
+FIELD_DEBUG_OPERATOR( RedmineResource )
+FIELD_DEBUG_OPERATOR( CustomField )
+FIELD_DEBUG_OPERATOR( CustomFieldValue )
+FIELD_DEBUG_OPERATOR( Enumeration )
+FIELD_DEBUG_OPERATOR( Group )
+FIELD_DEBUG_OPERATOR( Issue )
+FIELD_DEBUG_OPERATOR( IssueCategory )
+FIELD_DEBUG_OPERATOR( IssueStatus )
+FIELD_DEBUG_OPERATOR( Membership )
+FIELD_DEBUG_OPERATOR( Project )
+FIELD_DEBUG_OPERATOR( TimeEntry )
+FIELD_DEBUG_OPERATOR( Tracker )
+FIELD_DEBUG_OPERATOR( User )
+FIELD_DEBUG_OPERATOR( Version )
+
+/// @}
+
+#undef FIELD_DEBUG_OPERATOR
 
 /**
  * @brief QDebug stream operator for RedmineOptions
@@ -550,7 +1755,9 @@ inline QDebug
 operator<<( QDebug debug, const qtredmine::RedmineOptions& options )
 {
     QDebugStateSaver saver( debug );
-    debug.nospace() << "[" << options.parameters << ", " << options.getAllItems << "]";
+    debug.nospace() << "[" << options.parameters << ", " << options.getAllItems << ", "
+                    << static_cast<int>(options.profile) << ", " << options.skippedFields << ", "
+                    << static_cast<int>(options.cachePolicy) << "]";
 
     return debug;
 }
@@ -561,6 +1768,7 @@ Q_DECLARE_METATYPE( qtredmine::Item )
 Q_DECLARE_METATYPE( qtredmine::Enumeration )
 
 Q_DECLARE_METATYPE( qtredmine::CustomField )
+Q_DECLARE_METATYPE( qtredmine::CustomFieldValue )
 Q_DECLARE_METATYPE( qtredmine::Group )
 Q_DECLARE_METATYPE( qtredmine::Issue )
 Q_DECLARE_METATYPE( qtredmine::IssueCategory )
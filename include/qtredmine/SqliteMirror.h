@@ -0,0 +1,232 @@
+#ifndef SQLITEMIRROR_H
+#define SQLITEMIRROR_H
+
+#include "qtredmine_global.h"
+
+#include "SimpleRedmineTypes.h"
+
+#include <QObject>
+#include <QQueue>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+#include <QVariantList>
+
+#include <functional>
+
+namespace qtredmine {
+
+/**
+ * @brief Persistent SQLite replica of issues, time entries and projects
+ *
+ * The mirror keeps one table per resource (\c issues, \c issue_custom_fields, \c time_entries and
+ * \c projects) with one column per field. Items are stored as \c <item>_id and \c <item>_name
+ * columns, times as milliseconds since epoch and dates as ISO 8601 strings.
+ *
+ * If the SQLite library supports FTS5, the subjects and descriptions of the issues are indexed in
+ * the \c issues_fts table, which is kept up to date by triggers.
+ *
+ * Every write() stores its resources in a single transaction. enqueue() defers the writing to the
+ * event loop instead and writes CHUNK_SIZE resources per transaction, so that large results do not
+ * block the thread that retrieved them; queued resources become visible to issues(), search() and
+ * database() once written, or immediately after flush(). The mirror can be fed automatically by
+ * SimpleRedmineClient::setSqliteMirror(); reporting jobs can run their own queries through
+ * database().
+ *
+ * The mirror requires QtSql and is only built with <tt>CONFIG+=qtredmine_sqlite</tt>, which also
+ * defines \c QTREDMINE_SQLITE.
+ */
+class QTREDMINESHARED_EXPORT SqliteMirror : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// Version of the database schema; databases with another version are recreated
+    static const int SCHEMA_VERSION = 1;
+
+    /// Number of resources written per transaction by enqueue()
+    static const int CHUNK_SIZE = 500;
+
+private:
+    /// Queued write
+    struct PendingWrite
+    {
+        std::function<bool(int, int)> write;  ///< Write the resources in [begin, end) in one transaction
+        int                           size;   ///< Number of resources
+        int                           next;   ///< Position of the next resource to write
+    };
+    /// Name of the database connection
+    QString connectionName_;
+
+    /// Database has been opened and its schema created
+    bool open_ = false;
+
+    /// FTS5 index is available
+    bool fullTextSearch_ = false;
+
+    /// Writes queued by enqueue(), oldest first
+    QQueue<PendingWrite> pending_;
+
+    /// Write the next chunk of the oldest queued write and schedule the next one
+    void writeChunk();
+
+    /// Queue a write and schedule the first chunk
+    void enqueue( std::function<bool(int, int)> write, int size );
+
+    /// Write a range of resources in one transaction
+    bool write( const Issues& issues, int begin, int end );
+    bool write( const TimeEntries& timeEntries, int begin, int end );
+    bool write( const Projects& projects, int begin, int end );
+
+    /// Create the tables, indexes and triggers
+    bool createSchema();
+
+    /// Execute a statement, logging errors
+    bool exec( const QString& statement );
+
+    /// Read the issues of a query with the issue columns first
+    Issues readIssues( QSqlQuery& query ) const;
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * Opens or creates the database.
+     *
+     * @param path   Path of the database file
+     * @param parent Parent QObject (default: nullptr)
+     */
+    SqliteMirror( QString path, QObject* parent = nullptr );
+
+    /**
+     * @brief Destructor, closing the database
+     */
+    ~SqliteMirror();
+
+    /// @return true if the database could be opened, false otherwise
+    bool isOpen() const;
+
+    /// @return true if the FTS5 index is available, false otherwise
+    bool hasFullTextSearch() const;
+
+    /**
+     * @brief Get the database connection
+     *
+     * @return Database connection for custom queries
+     */
+    QSqlDatabase database() const;
+
+    /// @name Writing
+    /// @{
+
+    /**
+     * @brief Insert or replace issues
+     *
+     * Queued writes are completed first, so that they do not overwrite newer data.
+     *
+     * @param issues Issues; issues without an ID are skipped
+     *
+     * @return true on success, false if the transaction has been rolled back
+     */
+    bool write( const Issues& issues );
+
+    /**
+     * @brief Insert or replace time entries
+     *
+     * @param timeEntries Time entries; time entries without an ID are skipped
+     *
+     * @return true on success, false if the transaction has been rolled back
+     */
+    bool write( const TimeEntries& timeEntries );
+
+    /**
+     * @brief Insert or replace projects
+     *
+     * @param projects Projects; projects without an ID are skipped
+     *
+     * @return true on success, false if the transaction has been rolled back
+     */
+    bool write( const Projects& projects );
+
+    /**
+     * @brief Queue issues for writing
+     *
+     * The issues are written from the event loop, CHUNK_SIZE issues per transaction, after the
+     * writes queued before.
+     *
+     * @param issues Issues; issues without an ID are skipped
+     */
+    void enqueue( const Issues& issues );
+
+    /**
+     * @brief Queue time entries for writing
+     *
+     * @param timeEntries Time entries; time entries without an ID are skipped
+     *
+     * @sa enqueue(const Issues&)
+     */
+    void enqueue( const TimeEntries& timeEntries );
+
+    /**
+     * @brief Queue projects for writing
+     *
+     * @param projects Projects; projects without an ID are skipped
+     *
+     * @sa enqueue(const Issues&)
+     */
+    void enqueue( const Projects& projects );
+
+    /**
+     * @brief Write all queued resources now
+     *
+     * @return true on success, false if any chunk has been rolled back
+     */
+    bool flush();
+
+    /// @return true if queued resources have not been written yet, false otherwise
+    bool hasPendingWrites() const;
+
+    /**
+     * @brief Remove all data
+     *
+     * Queued writes are discarded.
+     *
+     * @return true on success, false otherwise
+     */
+    bool clear();
+
+    /// @}
+
+    /// @name Reading
+    /// @{
+
+    /**
+     * @brief Read issues
+     *
+     * @param condition SQL condition on the \c issues table, e.g. <tt>project_id = ?</tt>
+     *                  (default: all issues)
+     * @param values    Values bound to the placeholders of the condition
+     *
+     * @return Issues in ascending ID order
+     */
+    Issues issues( QString condition = "", QVariantList values = QVariantList() ) const;
+
+    /**
+     * @brief Search issues by subject and description
+     *
+     * Uses the FTS5 index if available, ranking the best matches first. Otherwise, issues whose
+     * subject or description contains \c text are returned in ascending ID order.
+     *
+     * @param text  FTS5 query, e.g. <tt>crash AND login*</tt>; plain text without the FTS5 index
+     * @param limit Maximum number of issues (default: 50)
+     *
+     * @return Matching issues
+     */
+    Issues search( QString text, int limit = 50 ) const;
+
+    /// @}
+};
+
+} // qtredmine
+
+#endif // SQLITEMIRROR_H
@@ -0,0 +1,76 @@
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include "qtredmine_global.h"
+
+#include <QMutex>
+#include <QSet>
+#include <QString>
+
+namespace qtredmine {
+
+/**
+ * @brief Pool of interned strings
+ *
+ * Large result sets contain the same few hundred status, tracker, project and user names over and
+ * over again. Interning them returns one implicitly shared QString for each distinct value, so that
+ * every further occurrence only costs a reference instead of a separate string allocation.
+ *
+ * The pool is thread-safe.
+ */
+class QTREDMINESHARED_EXPORT StringPool
+{
+private:
+    /// Interned strings
+    QSet<QString> strings_;
+
+    /// Mutex protecting the pool
+    mutable QMutex mutex_;
+
+public:
+    /**
+     * @brief Get the shared copy of a string
+     *
+     * If the string is not yet part of the pool, it is added.
+     *
+     * @param string String to intern
+     *
+     * @return Implicitly shared string equal to \c string
+     */
+    QString intern( const QString& string );
+
+    /**
+     * @brief Remove all strings from the pool
+     *
+     * Strings that were handed out before remain valid.
+     */
+    void clear();
+
+    /**
+     * @brief Remove the strings that are only referenced by the pool
+     *
+     * Strings still held elsewhere stay in the pool, so that later occurrences keep sharing them.
+     * Called when large amounts of parsed data are released, e.g. by IssueStore::clear().
+     *
+     * @return Number of removed strings
+     */
+    int trim();
+
+    /**
+     * @brief Get the number of distinct strings in the pool
+     *
+     * @return Number of strings
+     */
+    int size() const;
+
+    /**
+     * @brief Get the pool used for item names of parsed Redmine resources
+     *
+     * @return Global item name pool
+     */
+    static StringPool& itemNames();
+};
+
+} // qtredmine
+
+#endif // STRINGPOOL_H
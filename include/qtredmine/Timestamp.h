@@ -0,0 +1,132 @@
+#ifndef TIMESTAMP_H
+#define TIMESTAMP_H
+
+#include "qtredmine_global.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QMetaType>
+#include <QString>
+
+#include <limits>
+
+namespace qtredmine {
+
+/**
+ * @brief Compact timestamp
+ *
+ * Stores a point in time as milliseconds since the epoch (UTC) in a single 64-bit value. Unlike
+ * QDateTime, it never allocates, and it can be converted to a QDateTime when needed.
+ *
+ * Timestamps implicitly convert from and to QDateTime, so they can be used wherever a QDateTime
+ * has been used before.
+ */
+class QTREDMINESHARED_EXPORT Timestamp
+{
+private:
+    /// Value of invalid timestamps
+    static const qint64 INVALID = std::numeric_limits<qint64>::min();
+
+    /// Milliseconds since the epoch
+    qint64 msecs_ = INVALID;
+
+public:
+    /**
+     * @brief Constructor for an invalid timestamp
+     */
+    Timestamp() = default;
+
+    /**
+     * @brief Constructor from a QDateTime
+     *
+     * @param dateTime Date and time; an invalid QDateTime results in an invalid timestamp
+     */
+    Timestamp( const QDateTime& dateTime )
+        : msecs_( dateTime.isValid() ? dateTime.toMSecsSinceEpoch() : INVALID )
+    {}
+
+    /**
+     * @brief Create a timestamp from milliseconds since the epoch
+     *
+     * @param msecs Milliseconds since 1970-01-01T00:00:00Z
+     *
+     * @return Timestamp
+     */
+    static Timestamp fromMSecsSinceEpoch( qint64 msecs )
+    {
+        Timestamp timestamp;
+        timestamp.msecs_ = msecs;
+        return timestamp;
+    }
+
+    /**
+     * @brief Parse an ISO 8601 time string as returned by Redmine
+     *
+     * Strings in the form <tt>YYYY-MM-DDTHH:MM:SS[.fff][Z|+HH:MM|-HH:MM]</tt> are parsed without
+     * creating any temporary objects; all other strings are parsed using QDateTime.
+     *
+     * @param string Time string
+     *
+     * @return Timestamp, invalid if the string could not be parsed
+     */
+    static Timestamp fromString( const QString& string );
+
+    /// @return true if the timestamp is valid, false otherwise
+    bool isValid() const { return msecs_ != INVALID; }
+
+    /// @return true if the timestamp is invalid, false otherwise
+    bool isNull() const { return msecs_ == INVALID; }
+
+    /// @return Milliseconds since the epoch; only meaningful for valid timestamps
+    qint64 toMSecsSinceEpoch() const { return msecs_; }
+
+    /// @return Timestamp as UTC QDateTime; invalid if the timestamp is invalid
+    QDateTime toDateTime() const
+    {
+        return isValid() ? QDateTime::fromMSecsSinceEpoch( msecs_, Qt::UTC ) : QDateTime();
+    }
+
+    /// @return Timestamp as UTC string in the given format, like the QDateTime from toDateTime()
+    QString toString( Qt::DateFormat format = Qt::TextDate ) const
+    {
+        return toDateTime().toString( format );
+    }
+
+    /// @return Timestamp as UTC string in the given format, like the QDateTime from toDateTime()
+    QString toString( const QString& format ) const
+    {
+        return toDateTime().toString( format );
+    }
+
+    /// @return Timestamp as QDateTime
+    operator QDateTime() const { return toDateTime(); }
+
+    /// @name Comparison operators
+    /// @{
+
+    bool operator==( const Timestamp& other ) const { return msecs_ == other.msecs_; }
+    bool operator!=( const Timestamp& other ) const { return msecs_ != other.msecs_; }
+    bool operator<( const Timestamp& other ) const  { return msecs_ <  other.msecs_; }
+    bool operator<=( const Timestamp& other ) const { return msecs_ <= other.msecs_; }
+    bool operator>( const Timestamp& other ) const  { return msecs_ >  other.msecs_; }
+    bool operator>=( const Timestamp& other ) const { return msecs_ >= other.msecs_; }
+
+    /// @}
+};
+
+} // qtredmine
+
+/**
+ * @brief QDebug stream operator for timestamps
+ * @return QDebug object
+ */
+inline QDebug
+operator<<( QDebug debug, const qtredmine::Timestamp& data )
+{
+    return debug << data.toDateTime();
+}
+
+Q_DECLARE_TYPEINFO( qtredmine::Timestamp, Q_MOVABLE_TYPE );
+Q_DECLARE_METATYPE( qtredmine::Timestamp )
+
+#endif // TIMESTAMP_H
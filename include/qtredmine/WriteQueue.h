@@ -0,0 +1,238 @@
+#ifndef WRITEQUEUE_H
+#define WRITEQUEUE_H
+
+#include "qtredmine_global.h"
+
+#include "SimpleRedmineTypes.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QJsonObject>
+#include <QList>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+#include <functional>
+
+namespace qtredmine {
+
+class SimpleRedmineClient;
+
+/**
+ * @brief Durable queue for issue and time entry writes
+ *
+ * Writes are appended to a local log file before they are sent, so they survive both unreachable
+ * Redmine servers and restarts. The queue replays pending writes whenever the Redmine client reports
+ * an accessible connection:
+ *
+ * - Writes are started in the order they were enqueued.
+ * - Up to maxConcurrency() writes are in flight at once, but never two writes of the same issue or
+ *   time entry, so that later updates cannot overtake earlier ones.
+ * - If Redmine cannot be reached (RedmineError::ERR_UNREACHABLE, e.g. connection refused, host not
+ *   found or timeout), replay pauses and the write stays queued. Replay resumes when the connection
+ *   becomes accessible again, or after retryInterval() at the latest.
+ * - If Redmine replies with an error status, e.g. because of a validation error, the write is
+ *   removed from the queue and reported as failed.
+ *
+ * The log file is append-only: it contains one JSON record per line for every state change of a
+ * write, i.e. its enqueueing, each attempt to send it and its completion. It is compacted when the
+ * queue is opened and truncated whenever the queue runs empty. A write restored with attempts may
+ * have reached Redmine before the process ended and is sent again.
+ *
+ * Callbacks cannot be persisted; writes restored from the log file are only reported through the
+ * \c replayed signal. Issues written by restored writes are retrieved again to update the issue
+ * store, since the function applying the written fields cannot be persisted either.
+ */
+class QTREDMINESHARED_EXPORT WriteQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    /// Resources that can be written
+    enum Resource
+    {
+        ISSUE,
+        TIME_ENTRY,
+    };
+    Q_ENUM( Resource )
+
+private:
+    /// Queued write
+    struct Item
+    {
+        qint64     seq = 0;             ///< Sequence number
+        Resource   resource = ISSUE;    ///< Written resource
+        int        id = NULL_ID;        ///< ID of the resource to update; NULL_ID to create it
+        QString    parameters;          ///< Additional parameters
+        QByteArray data;                ///< Request body
+        SuccessCb  callback;            ///< Result callback; not persisted
+        std::function<void(Issue&)> apply; ///< Applies a written issue to the issue store; not persisted
+        int        attempts = 0;        ///< Number of times the write has been sent
+        bool       running = false;     ///< Currently sent
+    };
+
+    /// Redmine client
+    SimpleRedmineClient* redmine_;
+
+    /// Log file
+    QFile file_;
+
+    /// Pending writes in order
+    QList<Item> pending_;
+
+    /// Sequence number of the next write
+    qint64 nextSeq_ = 1;
+
+    /// Maximum number of writes in flight
+    int maxConcurrency_ = 4;
+
+    /// Number of writes in flight
+    int running_ = 0;
+
+    /// Replay is paused after a network error until the connection is accessible again
+    bool paused_ = false;
+
+    /// Timer retrying a paused replay, in case the connection status does not change
+    QTimer retryTimer_;
+
+    /// Read the log file and rewrite it with the pending writes only
+    void load();
+
+    /// Create the log file record of a write
+    static QJsonObject toRecord( const Item& item );
+
+    /// Create the log file record of a state change of a write
+    static QJsonObject toRecord( qint64 seq, const char* key, const QJsonValue& value );
+
+    /// Append a record to the log file
+    void append( const QJsonObject& record );
+
+    /// Enqueue a write
+    qint64 enqueue( Resource resource, QByteArray data, SuccessCb callback, int id, QString parameters,
+                    std::function<void(Issue&)> apply = nullptr );
+
+    /// Send a write
+    void start( Item& item );
+
+    /// Handle the result of a write
+    void finish( qint64 seq, bool success, int id, RedmineError redmineError, QStringList errors );
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * Opens the log file and restores the writes that were pending when it was last used.
+     *
+     * @param redmine Redmine client used to send the writes
+     * @param path    Path of the log file
+     * @param parent  Parent QObject (default: nullptr)
+     */
+    WriteQueue( SimpleRedmineClient* redmine, QString path, QObject* parent = nullptr );
+
+    /**
+     * @brief Check whether the log file could be opened
+     *
+     * If not, writes are still queued, but only in memory.
+     *
+     * @return true if the queue is durable, false otherwise
+     */
+    bool isDurable() const;
+
+    /// @return Number of pending writes
+    int size() const;
+
+    /// @return Maximum number of writes in flight
+    int maxConcurrency() const;
+
+    /**
+     * @brief Set the maximum number of writes in flight
+     *
+     * @param maxConcurrency Maximum number of concurrent requests; at least 1
+     */
+    void setMaxConcurrency( int maxConcurrency );
+
+    /// @return Interval in milliseconds after which a paused replay is retried
+    int retryInterval() const;
+
+    /**
+     * @brief Set the interval after which a paused replay is retried
+     *
+     * @param msecs Interval in milliseconds
+     */
+    void setRetryInterval( int msecs );
+
+    /**
+     * @brief Queue an issue to be created or updated
+     *
+     * @param item Issue
+     * @param callback Success callback function (default: none)
+     * @param id Issue ID to update; if set to \c NULL_ID, create a new issue
+     * @param parameters Additional issue parameters
+     *
+     * @return Sequence number of the write
+     */
+    qint64 sendIssue( Issue item,
+                      SuccessCb callback = nullptr,
+                      int id = NULL_ID,
+                      QString parameters = "" );
+
+    /**
+     * @brief Queue the modified fields of an issue to be updated
+     *
+     * @param item Modified issue; must have an ID
+     * @param original Issue as retrieved from Redmine
+     * @param callback Success callback function (default: none)
+     * @param parameters Additional issue parameters
+     *
+     * @return Sequence number of the write, or 0 if nothing has to be written
+     */
+    qint64 updateIssue( Issue item,
+                        Issue original,
+                        SuccessCb callback = nullptr,
+                        QString parameters = "" );
+
+    /**
+     * @brief Queue a time entry to be created or updated
+     *
+     * @param item Time entry
+     * @param callback Success callback function (default: none)
+     * @param id Time entry ID to update; if set to \c NULL_ID, create a new time entry
+     * @param parameters Additional time entry parameters
+     *
+     * @return Sequence number of the write
+     */
+    qint64 sendTimeEntry( TimeEntry item,
+                          SuccessCb callback = nullptr,
+                          int id = NULL_ID,
+                          QString parameters = "" );
+
+public slots:
+    /**
+     * @brief Send pending writes
+     *
+     * Called automatically when the Redmine client reports an accessible connection.
+     */
+    void replay();
+
+signals:
+    /**
+     * @brief Signal that a queued write has been completed
+     *
+     * @param seq Sequence number of the write
+     * @param success true if Redmine accepted the write, false if it replied with an error status
+     * @param id ID of the created or updated resource
+     * @param redmineError Redmine error code
+     * @param errors Errors that Redmine returned
+     */
+    void replayed( qint64 seq, bool success, int id, RedmineError redmineError, QStringList errors );
+
+    /**
+     * @brief Signal that all queued writes have been completed
+     */
+    void drained();
+};
+
+} // qtredmine
+
+#endif // WRITEQUEUE_H
@@ -12,19 +12,54 @@ INCLUDEPATH += $$PWD/include/qtredmine
 HEADERS += \
     include/qtredmine/qtredmine_global.h \
     include/qtredmine/Authenticator.h \
+    include/qtredmine/CustomFieldTable.h \
+    include/qtredmine/IssueFuzzyMatcher.h \
+    include/qtredmine/IssueHierarchy.h \
+    include/qtredmine/IssueSnapshot.h \
+    include/qtredmine/IssueStore.h \
+    include/qtredmine/IssueTable.h \
+    include/qtredmine/IssueTextIndex.h \
+    include/qtredmine/IssueView.h \
+    include/qtredmine/JsonWriter.h \
     include/qtredmine/KeyAuthenticator.h \
     include/qtredmine/Logging.h \
+    include/qtredmine/MetadataCache.h \
     include/qtredmine/PasswordAuthenticator.h \
+    include/qtredmine/ProjectTree.h \
     include/qtredmine/RedmineClient.h \
     include/qtredmine/SimpleRedmineClient.h \
     include/qtredmine/SimpleRedmineTypes.h \
+    include/qtredmine/StringPool.h \
+    include/qtredmine/Timestamp.h \
+    include/qtredmine/WriteQueue.h \
 
 SOURCES += \
+    CustomFieldTable.cpp \
+    IssueFuzzyMatcher.cpp \
+    IssueHierarchy.cpp \
+    IssueSnapshot.cpp \
+    IssueStore.cpp \
+    IssueTable.cpp \
+    IssueTextIndex.cpp \
+    IssueView.cpp \
+    JsonWriter.cpp \
     KeyAuthenticator.cpp \
     Logging.cpp \
+    MetadataCache.cpp \
     PasswordAuthenticator.cpp \
+    ProjectTree.cpp \
     RedmineClient.cpp \
     SimpleRedmineClient.cpp \
+    SimpleRedmineTypes.cpp \
+    StringPool.cpp \
+    Timestamp.cpp \
+    WriteQueue.cpp \
+
+# The SQLite mirror requires QtSql; enable it with "qmake CONFIG+=qtredmine_sqlite"
+qtredmine_sqlite {
+    HEADERS += include/qtredmine/SqliteMirror.h
+    SOURCES += SqliteMirror.cpp
+}
 
 DISTFILES += \
     .travis.yml \
@@ -0,0 +1,12 @@
+TARGET = tst_allocations
+
+include(../tests.pri)
+
+HEADERS += \
+    ../common/SyntheticIssues.h
+
+SOURCES += \
+    tst_allocations.cpp
+
+DISTFILES += \
+    issues.json
@@ -0,0 +1,196 @@
+#include "CustomFieldTable.h"
+#include "SimpleRedmineTypes.h"
+#include "SyntheticIssues.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtTest>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace qtredmine;
+
+namespace {
+
+/// Upper bound of the heap allocations per issue for decoding a page; a generous estimate, to be
+/// tightened once measured, so that regressions of the parse loop fail the test
+const double MAX_DECODE_ALLOCATIONS_PER_ISSUE = 100;
+
+/// Number of heap allocations while counting is enabled
+std::atomic<qint64> allocations( 0 );
+
+/// Counting is enabled
+std::atomic<bool> counting( false );
+
+void
+countAllocation()
+{
+    if( counting.load(std::memory_order_relaxed) )
+        allocations.fetch_add( 1, std::memory_order_relaxed );
+}
+
+// Count the allocations of a function call
+template<typename F>
+qint64
+countAllocations( F f )
+{
+    qint64 before = allocations.load();
+
+    counting = true;
+    f();
+    counting = false;
+
+    return allocations.load() - before;
+}
+
+} // namespace
+
+// Qt containers allocate with malloc(), so on glibc malloc() itself is counted; elsewhere only
+// operator new is
+#ifdef __GLIBC__
+extern "C" {
+
+void* __libc_malloc( size_t size );
+void* __libc_calloc( size_t count, size_t size );
+void* __libc_realloc( void* ptr, size_t size );
+
+void* malloc( size_t size )
+{
+    countAllocation();
+    return __libc_malloc( size );
+}
+
+void* calloc( size_t count, size_t size )
+{
+    countAllocation();
+    return __libc_calloc( count, size );
+}
+
+void* realloc( void* ptr, size_t size )
+{
+    countAllocation();
+    return __libc_realloc( ptr, size );
+}
+
+} // extern "C"
+#endif
+
+void*
+operator new( std::size_t size )
+{
+#ifndef __GLIBC__
+    countAllocation();
+#endif
+
+    if( void* ptr = std::malloc(size ? size : 1) )
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void
+operator delete( void* ptr ) noexcept
+{
+    std::free( ptr );
+}
+
+/**
+ * @brief Allocation count of the issue parse loop
+ *
+ * Decodes the canned page of issues in issues.json with readItems(), as the retrievers do, and reports
+ * the heap allocations per issue, separately for parsing the JSON document and for decoding the
+ * issues. Fails if decoding needs more than MAX_DECODE_ALLOCATIONS_PER_ISSUE allocations per issue.
+ *
+ * Also reports the size of an issue and the allocations for holding its creation and update times
+ * as Timestamp and as QDateTime, as RedmineResource did before.
+ */
+class TestAllocations : public QObject
+{
+    Q_OBJECT
+
+private:
+    QByteArray raw_;
+    CustomFieldTable table_;
+
+private slots:
+    void initTestCase();
+
+    void parsePage();
+    void timestamps();
+};
+
+void
+TestAllocations::initTestCase()
+{
+    QFile file( SRCDIR "issues.json" );
+    QVERIFY( file.open(QIODevice::ReadOnly) );
+
+    raw_ = file.readAll();
+
+    // The first page interns the item names and adds the custom field definitions; later pages find them
+    synthetic::decodeIssues( QJsonDocument::fromJson(raw_), 0, &table_ );
+}
+
+void
+TestAllocations::parsePage()
+{
+    QJsonDocument json;
+    Issues issues;
+
+    qint64 parse  = countAllocations( [&]{ json = QJsonDocument::fromJson( raw_ ); } );
+    qint64 decode = countAllocations( [&]{ issues = synthetic::decodeIssues( json, 0, &table_ ); } );
+
+    QCOMPARE( issues.size(), 25 );
+    QCOMPARE( issues.first().id, 4101 );
+
+    qInfo( "%d issues: %.1f allocations per issue for the JSON document, %.1f for decoding, %.1f in total",
+           issues.size(), double(parse) / issues.size(), double(decode) / issues.size(),
+           double(parse + decode) / issues.size() );
+
+    QVERIFY2( double(decode) / issues.size() <= MAX_DECODE_ALLOCATIONS_PER_ISSUE,
+              qPrintable(QString("%1 allocations per issue").arg(double(decode) / issues.size())) );
+}
+
+void
+TestAllocations::timestamps()
+{
+    const Issues issues = synthetic::decodeIssues( QJsonDocument::fromJson(raw_), 0, &table_ );
+
+    QVector<QDateTime> dateTimes;
+    dateTimes.reserve( 2 * issues.size() );
+
+    QVector<Timestamp> timestamps;
+    timestamps.reserve( 2 * issues.size() );
+
+    qint64 dateTimeAllocations = countAllocations( [&]
+    {
+        for( const auto& issue : issues )
+            dateTimes << issue.createdOn.toDateTime() << issue.updatedOn.toDateTime();
+    } );
+
+    qint64 timestampAllocations = countAllocations( [&]
+    {
+        for( const auto& issue : issues )
+            timestamps << issue.createdOn << issue.updatedOn;
+    } );
+
+    QVERIFY( dateTimes.first().isValid() );
+
+    // Issue with the two QDateTime members of RedmineResource before
+    const int sizeBefore = sizeof(Issue) - 2 * sizeof(Timestamp) + 2 * sizeof(QDateTime);
+
+    qInfo( "sizeof(Issue): %d bytes, %d bytes with QDateTime; sizeof(Timestamp): %d bytes, sizeof(QDateTime): %d bytes",
+           int(sizeof(Issue)), sizeBefore, int(sizeof(Timestamp)), int(sizeof(QDateTime)) );
+    qInfo( "Creation and update time: %.1f allocations per issue as QDateTime, %.1f as Timestamp",
+           double(dateTimeAllocations) / issues.size(), double(timestampAllocations) / issues.size() );
+
+    QCOMPARE( timestampAllocations, qint64(0) );
+}
+
+QTEST_GUILESS_MAIN( TestAllocations )
+
+#include "tst_allocations.moc"
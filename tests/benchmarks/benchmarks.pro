@@ -0,0 +1,19 @@
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    customfields \
+    fields \
+    issuefuzzymatcher \
+    issuesnapshot \
+    issuestore \
+    issuetable \
+    issuetextindex \
+    parseprofiles \
+    requestbody \
+    stringpool \
+    writequeue
+
+# The SQLite mirror is only part of the library built with CONFIG+=qtredmine_sqlite
+qtredmine_sqlite {
+  SUBDIRS += sqlitemirror
+}
@@ -0,0 +1,10 @@
+TARGET = tst_customfields
+
+include(../../tests.pri)
+
+HEADERS += \
+    ../../common/ProcessMemory.h \
+    ../../common/SyntheticIssues.h
+
+SOURCES += \
+    tst_customfields.cpp
@@ -0,0 +1,94 @@
+#include "CustomFieldTable.h"
+#include "ProcessMemory.h"
+#include "SyntheticIssues.h"
+
+#include <QtTest>
+
+using namespace qtredmine;
+
+namespace {
+
+/// Number of issues of the data set
+const int ISSUES = 50000;
+
+/// Number of custom fields per issue
+const int CUSTOM_FIELDS = 10;
+
+// Deep copy of a string, as decoded from a separate JSON document
+QString
+copy( const QString& string )
+{
+    return string.isNull() ? QString() : QString( string.constData(), string.size() );
+}
+
+} // namespace
+
+/**
+ * @brief Memory per issue with compact custom field values
+ *
+ * Decodes a synthetic data set of 50k issues with 10 custom fields each, whose values are stored as
+ * CustomFieldValue with the definitions in a CustomFieldTable. Then stores the same custom fields
+ * as per-record CustomField copies with their own name and value vector, as the parser did before.
+ * The growth of the resident memory is reported per issue for both.
+ */
+class TestCustomFields : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void residentMemory();
+};
+
+void
+TestCustomFields::residentMemory()
+{
+    if( process::residentBytes() < 0 )
+        QSKIP( "Resident memory is only measured on Linux" );
+
+    CustomFieldTable table;
+
+    qint64 start = process::residentBytes();
+    Issues issues = synthetic::issues( ISSUES, &table, CUSTOM_FIELDS );
+    qint64 compact = process::residentBytes();
+
+    QCOMPARE( issues.size(), ISSUES );
+    QCOMPARE( issues.first().customFields.size(), CUSTOM_FIELDS );
+
+    // Per-record copies of the definitions and values, as before the custom field table
+    QVector<CustomFields> records;
+    records.reserve( issues.size() );
+
+    for( const auto& issue : issues )
+    {
+        CustomFields customFields;
+
+        for( const auto& value : issue.customFields )
+        {
+            const CustomField definition = table.value( value.id );
+            QCOMPARE( definition.id, value.id );
+
+            CustomField customField;
+            customField.id       = value.id;
+            customField.name     = copy( definition.name );
+            customField.multiple = definition.multiple;
+            customField.values.push_back( copy(value.value) );
+
+            for( const auto& moreValue : value.moreValues )
+                customField.values.push_back( copy(moreValue) );
+
+            customFields.push_back( customField );
+        }
+
+        records.push_back( customFields );
+    }
+
+    qint64 copied = process::residentBytes();
+
+    qInfo( "%d issues with %d custom fields: %.0f bytes resident per issue with CustomFieldValue, "
+           "%.0f bytes more per issue for per-record CustomField copies",
+           ISSUES, CUSTOM_FIELDS, double(compact - start) / ISSUES, double(copied - compact) / ISSUES );
+}
+
+QTEST_GUILESS_MAIN( TestCustomFields )
+
+#include "tst_customfields.moc"
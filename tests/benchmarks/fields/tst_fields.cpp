@@ -0,0 +1,125 @@
+#include "CustomFieldTable.h"
+#include "HandWritten.h"
+#include "SyntheticIssues.h"
+
+#include <QtTest>
+
+using namespace qtredmine;
+
+namespace {
+
+/// Number of issues on the page
+const int ISSUES = 100;
+
+} // namespace
+
+/**
+ * @brief Generated parsers and writers against the hand-written code they replace
+ *
+ * Decodes and serialises the same page of 100 synthetic issues with readFields() and requestBody(),
+ * generated from Fields<Issue>, and with the hand-written code of SimpleRedmineClient before them. The
+ * JSON document is parsed once beforehand, as it is the same for both.
+ */
+class TestFields : public QObject
+{
+    Q_OBJECT
+
+private:
+    CustomFieldTable customFieldTable_;
+    QJsonArray array_;
+    Issues issues_;
+
+private slots:
+    void initTestCase();
+
+    void parse_data();
+    void parse();
+
+    void serialise_data();
+    void serialise();
+};
+
+void
+TestFields::initTestCase()
+{
+    QJsonDocument json = QJsonDocument::fromJson( synthetic::issuesPage(0, ISSUES, ISSUES) );
+    array_ = json.object().value( QLatin1String("issues") ).toArray();
+
+    // Add the custom field definitions, as for every page after the first
+    issues_ = synthetic::decodeIssues( json, 0, &customFieldTable_ );
+
+    // Both parsers read the same issue
+    Issue issue;
+    handwritten::parseIssue( issue, array_.first().toObject(), &customFieldTable_ );
+
+    QCOMPARE( issue.id, issues_.first().id );
+    QCOMPARE( issue.subject, issues_.first().subject );
+    QCOMPARE( issue.status.name, issues_.first().status.name );
+    QCOMPARE( issue.customFields.size(), issues_.first().customFields.size() );
+    QCOMPARE( issue.updatedOn.toDateTime(), issues_.first().updatedOn.toDateTime() );
+}
+
+void
+TestFields::parse_data()
+{
+    QTest::addColumn<bool>( "generated" );
+
+    QTest::newRow( "hand-written" ) << false;
+    QTest::newRow( "readFields" )   << true;
+}
+
+void
+TestFields::parse()
+{
+    QFETCH( bool, generated );
+
+    Issues issues;
+
+    QBENCHMARK
+    {
+        issues = Issues( array_.size() );
+
+        for( int i = 0; i < array_.size(); ++i )
+        {
+            if( generated )
+                readFields( issues[i], array_.at(i).toObject(), 0, &customFieldTable_ );
+            else
+                handwritten::parseIssue( issues[i], array_.at(i).toObject(), &customFieldTable_ );
+        }
+    }
+
+    QCOMPARE( issues.size(), ISSUES );
+}
+
+void
+TestFields::serialise_data()
+{
+    QTest::addColumn<bool>( "generated" );
+
+    QTest::newRow( "hand-written" ) << false;
+    QTest::newRow( "requestBody" )  << true;
+}
+
+void
+TestFields::serialise()
+{
+    QFETCH( bool, generated );
+
+    qint64 bytes = 0;
+
+    QBENCHMARK
+    {
+        bytes = 0;
+
+        // Compact documents, so that only the serialisation differs and not the payload
+        for( const auto& issue : issues_ )
+            bytes += generated ? requestBody( issue ).size()
+                               : handwritten::issueBody( issue, QJsonDocument::Compact ).size();
+    }
+
+    QVERIFY( bytes > 0 );
+}
+
+QTEST_GUILESS_MAIN( TestFields )
+
+#include "tst_fields.moc"
@@ -0,0 +1,9 @@
+TARGET = tst_issuefuzzymatcher
+
+include(../../tests.pri)
+
+HEADERS += \
+    ../../common/SyntheticIssues.h
+
+SOURCES += \
+    tst_issuefuzzymatcher.cpp
@@ -0,0 +1,165 @@
+#include "CustomFieldTable.h"
+#include "IssueFuzzyMatcher.h"
+#include "SyntheticIssues.h"
+
+#include <QtTest>
+
+using namespace qtredmine;
+
+namespace {
+
+/// Number of issues of the data set
+const int ISSUES = 100000;
+
+/// Number of sampled issues for the match quality
+const int SAMPLES = 100;
+
+// Mistype a text by swapping the second and third character of every word with four or more characters
+QString
+mistype( const QString& text )
+{
+    QStringList words = text.split( ' ' );
+
+    for( auto& word : words )
+    {
+        if( word.size() >= 4 )
+        {
+            QChar c = word.at( 1 );
+            word[1] = word.at( 2 );
+            word[2] = c;
+        }
+    }
+
+    return words.join( ' ' );
+}
+
+} // namespace
+
+/**
+ * @brief Latency and match quality of IssueFuzzyMatcher at 100k issues
+ *
+ * The match quality is the share of sampled issues found as the best match when their subject is
+ * typed with errors, compared with a case-insensitive substring search.
+ */
+class TestIssueFuzzyMatcher : public QObject
+{
+    Q_OBJECT
+
+private:
+    CustomFieldTable customFieldTable_;
+    Issues issues_;
+    IssueFuzzyMatcher matcher_;
+
+private slots:
+    void initTestCase();
+
+    void build();
+
+    void search_data();
+    void search();
+
+    void update();
+
+    void quality();
+};
+
+void
+TestIssueFuzzyMatcher::initTestCase()
+{
+    issues_ = synthetic::issues( ISSUES, &customFieldTable_ );
+    matcher_.insert( issues_ );
+
+    QCOMPARE( matcher_.size(), ISSUES );
+}
+
+void
+TestIssueFuzzyMatcher::build()
+{
+    QBENCHMARK_ONCE
+    {
+        IssueFuzzyMatcher matcher;
+        matcher.insert( issues_ );
+    }
+}
+
+void
+TestIssueFuzzyMatcher::search_data()
+{
+    QTest::addColumn<QString>( "query" );
+
+    QTest::newRow( "word" )          << "notification";
+    QTest::newRow( "mistyped word" ) << "notifcation";
+    QTest::newRow( "two words" )     << "password reset";
+    QTest::newRow( "issue ID" )      << "#4711";
+    QTest::newRow( "project" )       << "Project 17";
+}
+
+void
+TestIssueFuzzyMatcher::search()
+{
+    QFETCH( QString, query );
+
+    IssueFuzzyMatcher::Matches matches;
+
+    QBENCHMARK
+    {
+        matches = matcher_.search( query );
+    }
+
+    QVERIFY( !matches.isEmpty() );
+}
+
+void
+TestIssueFuzzyMatcher::update()
+{
+    Issue issue = issues_.at( ISSUES / 2 );
+    const QString subject = issue.subject;
+
+    bool toggle = false;
+
+    QBENCHMARK
+    {
+        toggle = !toggle;
+        issue.subject = toggle ? subject + " duplicate timeline" : subject;
+        matcher_.insert( issue );
+    }
+
+    matcher_.insert( issues_.at(ISSUES / 2) );
+}
+
+void
+TestIssueFuzzyMatcher::quality()
+{
+    int fuzzyHits = 0;
+    int substringHits = 0;
+
+    for( int i = 0; i < SAMPLES; ++i )
+    {
+        const Issue& issue = issues_.at( i * (ISSUES / SAMPLES) );
+        const QString query = mistype( issue.subject );
+
+        // Issues with the same subject are equally good matches
+        IssueFuzzyMatcher::Matches matches = matcher_.search( query, 1 );
+
+        if( !matches.isEmpty() && issues_.at(matches.first().id - 1).subject == issue.subject )
+            ++fuzzyHits;
+
+        for( const auto& candidate : issues_ )
+        {
+            if( candidate.subject.contains(query, Qt::CaseInsensitive) )
+            {
+                substringHits += candidate.subject == issue.subject;
+                break;
+            }
+        }
+    }
+
+    qInfo( "Mistyped subjects found as best match: %d of %d with the fuzzy matcher, %d of %d with substring search",
+           fuzzyHits, SAMPLES, substringHits, SAMPLES );
+
+    QVERIFY( fuzzyHits > substringHits );
+}
+
+QTEST_GUILESS_MAIN( TestIssueFuzzyMatcher )
+
+#include "tst_issuefuzzymatcher.moc"
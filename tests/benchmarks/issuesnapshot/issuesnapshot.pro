@@ -0,0 +1,9 @@
+TARGET = tst_issuesnapshot
+
+include(../../tests.pri)
+
+HEADERS += \
+    ../../common/SyntheticIssues.h
+
+SOURCES += \
+    tst_issuesnapshot.cpp
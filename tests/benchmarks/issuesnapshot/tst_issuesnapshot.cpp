@@ -0,0 +1,122 @@
+#include "CustomFieldTable.h"
+#include "IssueSnapshot.h"
+#include "SyntheticIssues.h"
+
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include <QtTest>
+
+using namespace qtredmine;
+
+namespace {
+
+/// Number of issues of the data set
+const int ISSUES = 50000;
+
+/// Issues per page of the JSON replies
+const int LIMIT = 100;
+
+} // namespace
+
+/**
+ * @brief Restoring issues from an IssueSnapshot against decoding the JSON replies
+ *
+ * Writes 50k synthetic issues into a snapshot file, then compares opening the snapshot and decoding
+ * a single issue or all issues with parsing and decoding the same issues from their JSON pages with
+ * synthetic::decodeIssues().
+ */
+class TestIssueSnapshot : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir dir_;
+    QString path_;
+    CustomFieldTable customFieldTable_;
+    QVector<QByteArray> pages_;
+
+private slots:
+    void initTestCase();
+
+    void openAndIssue();
+    void openAndIssues();
+    void decodeJson();
+};
+
+void
+TestIssueSnapshot::initTestCase()
+{
+    QVERIFY( dir_.isValid() );
+    path_ = dir_.path() + "/issues.snapshot";
+
+    qint64 jsonBytes = 0;
+
+    for( int offset = 0; offset < ISSUES; offset += LIMIT )
+    {
+        pages_.push_back( synthetic::issuesPage(offset, LIMIT, ISSUES) );
+        jsonBytes += pages_.last().size();
+    }
+
+    Issues issues = synthetic::issues( ISSUES, &customFieldTable_ );
+
+    SnapshotMetadata metadata;
+    metadata.customFields = customFieldTable_.values();
+
+    QVERIFY( IssueSnapshot::write(path_, issues, metadata) );
+
+    qInfo( "%d issues: %.1f MiB snapshot, %.1f MiB JSON", ISSUES, QFileInfo( path_ ).size() / 1048576.0,
+           jsonBytes / 1048576.0 );
+}
+
+void
+TestIssueSnapshot::openAndIssue()
+{
+    Issue issue;
+
+    QBENCHMARK
+    {
+        IssueSnapshot snapshot;
+        QVERIFY( snapshot.open(path_) );
+
+        issue = snapshot.issue( snapshot.indexOf(ISSUES / 2), &customFieldTable_ );
+    }
+
+    QCOMPARE( issue.id, ISSUES / 2 );
+}
+
+void
+TestIssueSnapshot::openAndIssues()
+{
+    Issues issues;
+
+    QBENCHMARK
+    {
+        IssueSnapshot snapshot;
+        QVERIFY( snapshot.open(path_) );
+
+        issues = snapshot.issues( &customFieldTable_ );
+    }
+
+    QCOMPARE( issues.size(), ISSUES );
+}
+
+void
+TestIssueSnapshot::decodeJson()
+{
+    Issues issues;
+
+    QBENCHMARK
+    {
+        issues.clear();
+        issues.reserve( ISSUES );
+
+        for( const auto& page : pages_ )
+            issues += synthetic::decodeIssues( QJsonDocument::fromJson(page), 0, &customFieldTable_ );
+    }
+
+    QCOMPARE( issues.size(), ISSUES );
+}
+
+QTEST_GUILESS_MAIN( TestIssueSnapshot )
+
+#include "tst_issuesnapshot.moc"
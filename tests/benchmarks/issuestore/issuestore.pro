@@ -0,0 +1,9 @@
+TARGET = tst_issuestore
+
+include(../../tests.pri)
+
+HEADERS += \
+    ../../common/SyntheticIssues.h
+
+SOURCES += \
+    tst_issuestore.cpp
@@ -0,0 +1,140 @@
+#include "CustomFieldTable.h"
+#include "IssueStore.h"
+#include "SyntheticIssues.h"
+
+#include <QtTest>
+
+using namespace qtredmine;
+
+namespace {
+
+/// Number of issues of the data set
+const int ISSUES = 100000;
+
+} // namespace
+
+/**
+ * @brief IssueStore lookups against linear scans of an Issues vector
+ *
+ * Both hold the same 100k synthetic issues, as Example::cacheIssues() keeps them. Lookups by ID and
+ * by project are run on the store and as linear scans.
+ */
+class TestIssueStore : public QObject
+{
+    Q_OBJECT
+
+private:
+    CustomFieldTable customFieldTable_;
+    Issues issues_;
+    IssueStore store_;
+
+private slots:
+    void initTestCase();
+
+    void insert();
+
+    void findIssues();
+    void findStore();
+
+    void byProjectIssues();
+    void byProjectStore();
+};
+
+void
+TestIssueStore::initTestCase()
+{
+    issues_ = synthetic::issues( ISSUES, &customFieldTable_ );
+    store_.insert( issues_ );
+
+    QCOMPARE( store_.size(), ISSUES );
+}
+
+void
+TestIssueStore::insert()
+{
+    QBENCHMARK
+    {
+        IssueStore store;
+        store.insert( issues_ );
+    }
+}
+
+void
+TestIssueStore::findIssues()
+{
+    int found = 0;
+
+    QBENCHMARK
+    {
+        found = 0;
+
+        for( int id = 1; id <= ISSUES; id += ISSUES / 100 )
+        {
+            for( const auto& issue : issues_ )
+            {
+                if( issue.id == id )
+                {
+                    ++found;
+                    break;
+                }
+            }
+        }
+    }
+
+    QCOMPARE( found, 100 );
+}
+
+void
+TestIssueStore::findStore()
+{
+    int found = 0;
+
+    QBENCHMARK
+    {
+        found = 0;
+
+        for( int id = 1; id <= ISSUES; id += ISSUES / 100 )
+            found += store_.find( id ) != nullptr;
+    }
+
+    QCOMPARE( found, 100 );
+}
+
+void
+TestIssueStore::byProjectIssues()
+{
+    double hours = 0;
+
+    QBENCHMARK
+    {
+        hours = 0;
+
+        for( const auto& issue : issues_ )
+        {
+            if( issue.project.id == 1 )
+                hours += issue.estimatedHours;
+        }
+    }
+
+    QVERIFY( hours > 0 );
+}
+
+void
+TestIssueStore::byProjectStore()
+{
+    double hours = 0;
+
+    QBENCHMARK
+    {
+        hours = 0;
+
+        for( const auto& issue : store_.byProject(1) )
+            hours += issue.estimatedHours;
+    }
+
+    QVERIFY( hours > 0 );
+}
+
+QTEST_GUILESS_MAIN( TestIssueStore )
+
+#include "tst_issuestore.moc"
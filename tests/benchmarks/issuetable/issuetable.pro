@@ -0,0 +1,9 @@
+TARGET = tst_issuetable
+
+include(../../tests.pri)
+
+HEADERS += \
+    ../../common/SyntheticIssues.h
+
+SOURCES += \
+    tst_issuetable.cpp
@@ -0,0 +1,128 @@
+#include "CustomFieldTable.h"
+#include "IssueTable.h"
+#include "SyntheticIssues.h"
+
+#include <QHash>
+#include <QtTest>
+
+using namespace qtredmine;
+
+namespace {
+
+/// Number of issues of the data set
+const int ISSUES = 100000;
+
+} // namespace
+
+/**
+ * @brief Scans over the columnar IssueTable against the QVector<Issue> layout
+ *
+ * Both layouts hold the same 100k synthetic issues. The group-by benchmarks sum the estimated hours
+ * per status, the filter benchmarks count the open issues of a project with a high done ratio.
+ */
+class TestIssueTable : public QObject
+{
+    Q_OBJECT
+
+private:
+    CustomFieldTable customFieldTable_;
+    Issues issues_;
+    IssueTable table_;
+
+private slots:
+    void initTestCase();
+
+    void groupByIssues();
+    void groupByTable();
+
+    void filterIssues();
+    void filterTable();
+};
+
+void
+TestIssueTable::initTestCase()
+{
+    issues_ = synthetic::issues( ISSUES, &customFieldTable_ );
+
+    table_.reserve( issues_.size() );
+
+    for( const auto& issue : issues_ )
+        table_.append( issue );
+
+    QCOMPARE( table_.size(), ISSUES );
+}
+
+void
+TestIssueTable::groupByIssues()
+{
+    QHash<int, double> hours;
+
+    QBENCHMARK
+    {
+        hours.clear();
+
+        for( const auto& issue : issues_ )
+            hours[issue.status.id] += issue.estimatedHours;
+    }
+
+    QCOMPARE( hours.size(), int(sizeof(synthetic::STATUSES) / sizeof(synthetic::STATUSES[0])) );
+}
+
+void
+TestIssueTable::groupByTable()
+{
+    QHash<int, double> hours;
+
+    QBENCHMARK
+    {
+        hours.clear();
+
+        const int* statusIds = table_.statusIds.constData();
+        const double* estimatedHours = table_.estimatedHours.constData();
+
+        for( int row = 0; row < table_.size(); ++row )
+            hours[statusIds[row]] += estimatedHours[row];
+    }
+
+    QCOMPARE( hours.size(), int(sizeof(synthetic::STATUSES) / sizeof(synthetic::STATUSES[0])) );
+}
+
+void
+TestIssueTable::filterIssues()
+{
+    int count = 0;
+
+    QBENCHMARK
+    {
+        count = 0;
+
+        for( const auto& issue : issues_ )
+            count += issue.project.id == 1 && issue.status.id <= 2 && issue.doneRatio >= 50;
+    }
+
+    QVERIFY( count > 0 );
+}
+
+void
+TestIssueTable::filterTable()
+{
+    int count = 0;
+
+    QBENCHMARK
+    {
+        count = 0;
+
+        const int* projectIds = table_.projectIds.constData();
+        const int* statusIds = table_.statusIds.constData();
+        const double* doneRatios = table_.doneRatios.constData();
+
+        for( int row = 0; row < table_.size(); ++row )
+            count += projectIds[row] == 1 && statusIds[row] <= 2 && doneRatios[row] >= 50;
+    }
+
+    QVERIFY( count > 0 );
+}
+
+QTEST_GUILESS_MAIN( TestIssueTable )
+
+#include "tst_issuetable.moc"
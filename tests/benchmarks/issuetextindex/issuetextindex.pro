@@ -0,0 +1,9 @@
+TARGET = tst_issuetextindex
+
+include(../../tests.pri)
+
+HEADERS += \
+    ../../common/SyntheticIssues.h
+
+SOURCES += \
+    tst_issuetextindex.cpp
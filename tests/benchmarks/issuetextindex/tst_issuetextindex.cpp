@@ -0,0 +1,143 @@
+#include "CustomFieldTable.h"
+#include "IssueTextIndex.h"
+#include "SyntheticIssues.h"
+
+#include <QtTest>
+
+using namespace qtredmine;
+
+namespace {
+
+/// Number of issues of the data set
+const int ISSUES = 100000;
+
+} // namespace
+
+/**
+ * @brief Query and update latency of IssueTextIndex at 100k issues
+ *
+ * Typical quick-open queries are run against the index and, for comparison, as the linear
+ * QString::contains() scan over the subjects that the index replaces.
+ */
+class TestIssueTextIndex : public QObject
+{
+    Q_OBJECT
+
+private:
+    CustomFieldTable customFieldTable_;
+    Issues issues_;
+    IssueTextIndex index_;
+
+private slots:
+    void initTestCase();
+
+    void build();
+
+    void search_data();
+    void search();
+
+    void scan_data();
+    void scan();
+
+    void update();
+};
+
+void
+TestIssueTextIndex::initTestCase()
+{
+    issues_ = synthetic::issues( ISSUES, &customFieldTable_ );
+    index_.insert( issues_ );
+
+    QCOMPARE( index_.size(), ISSUES );
+}
+
+void
+TestIssueTextIndex::build()
+{
+    QBENCHMARK_ONCE
+    {
+        IssueTextIndex index;
+        index.insert( issues_ );
+    }
+}
+
+void
+TestIssueTextIndex::search_data()
+{
+    QTest::addColumn<QString>( "query" );
+    QTest::addColumn<int>( "fields" );
+
+    QTest::newRow( "one term, subject" )     << "crash" << int( IssueTextIndex::SUBJECT );
+    QTest::newRow( "prefix, subject" )       << "notif" << int( IssueTextIndex::SUBJECT );
+    QTest::newRow( "two terms, subject" )    << "login fail" << int( IssueTextIndex::SUBJECT );
+    QTest::newRow( "two terms, all fields" ) << "export wrong" << int( IssueTextIndex::ALL_FIELDS );
+}
+
+void
+TestIssueTextIndex::search()
+{
+    QFETCH( QString, query );
+    QFETCH( int, fields );
+
+    QVector<int> ids;
+
+    QBENCHMARK
+    {
+        ids = index_.search( query, 50, fields );
+    }
+
+    QVERIFY( !ids.isEmpty() );
+}
+
+void
+TestIssueTextIndex::scan_data()
+{
+    QTest::addColumn<QString>( "query" );
+
+    QTest::newRow( "one term, subject" ) << "crash";
+    QTest::newRow( "prefix, subject" )   << "notif";
+}
+
+void
+TestIssueTextIndex::scan()
+{
+    QFETCH( QString, query );
+
+    QVector<int> ids;
+
+    QBENCHMARK
+    {
+        ids.clear();
+
+        // Latest issues first, like the index
+        for( int i = issues_.size() - 1; i >= 0 && ids.size() < 50; --i )
+        {
+            if( issues_.at(i).subject.contains(query, Qt::CaseInsensitive) )
+                ids.push_back( issues_.at(i).id );
+        }
+    }
+
+    QVERIFY( !ids.isEmpty() );
+}
+
+void
+TestIssueTextIndex::update()
+{
+    Issue issue = issues_.at( ISSUES / 2 );
+    const QString subject = issue.subject;
+
+    bool toggle = false;
+
+    QBENCHMARK
+    {
+        toggle = !toggle;
+        issue.subject = toggle ? subject + " duplicate timeline" : subject;
+        index_.insert( issue );
+    }
+
+    index_.insert( issues_.at(ISSUES / 2) );
+}
+
+QTEST_GUILESS_MAIN( TestIssueTextIndex )
+
+#include "tst_issuetextindex.moc"
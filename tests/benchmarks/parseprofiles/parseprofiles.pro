@@ -0,0 +1,9 @@
+TARGET = tst_parseprofiles
+
+include(../../tests.pri)
+
+HEADERS += \
+    ../../common/SyntheticIssues.h
+
+SOURCES += \
+    tst_parseprofiles.cpp
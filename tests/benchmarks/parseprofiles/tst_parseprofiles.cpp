@@ -0,0 +1,70 @@
+#include "CustomFieldTable.h"
+#include "SyntheticIssues.h"
+
+#include <QtTest>
+
+using namespace qtredmine;
+
+/**
+ * @brief Parse time per parse profile
+ *
+ * Decodes a page of 100 synthetic issues with every parse profile. The JSON document is parsed once
+ * beforehand, as it is the same for all profiles.
+ */
+class TestParseProfiles : public QObject
+{
+    Q_OBJECT
+
+private:
+    CustomFieldTable customFieldTable_;
+    QJsonDocument json_;
+
+private slots:
+    void initTestCase();
+
+    void decode_data();
+    void decode();
+};
+
+void
+TestParseProfiles::initTestCase()
+{
+    json_ = QJsonDocument::fromJson( synthetic::issuesPage(0, 100, 100) );
+
+    // Add the custom field definitions, as for every page after the first
+    synthetic::decodeIssues( json_, 0, &customFieldTable_ );
+}
+
+void
+TestParseProfiles::decode_data()
+{
+    QTest::addColumn<quint64>( "skip" );
+
+    RedmineOptions custom;
+    custom.profile       = ParseProfile::CUSTOM;
+    custom.skippedFields = QStringList() << "description" << "customFields" << "author" << "category"
+                                         << "startDate" << "dueDate" << "createdOn";
+
+    QTest::newRow( "FULL" )   << skippedFields<Issue>( RedmineOptions("", false, ParseProfile::FULL) );
+    QTest::newRow( "LIST" )   << skippedFields<Issue>( RedmineOptions("", false, ParseProfile::LIST) );
+    QTest::newRow( "CUSTOM" ) << skippedFields<Issue>( custom );
+}
+
+void
+TestParseProfiles::decode()
+{
+    QFETCH( quint64, skip );
+
+    Issues issues;
+
+    QBENCHMARK
+    {
+        issues = synthetic::decodeIssues( json_, skip, &customFieldTable_ );
+    }
+
+    QCOMPARE( issues.size(), 100 );
+}
+
+QTEST_GUILESS_MAIN( TestParseProfiles )
+
+#include "tst_parseprofiles.moc"
@@ -0,0 +1,10 @@
+TARGET = tst_requestbody
+
+include(../../tests.pri)
+
+HEADERS += \
+    ../../common/HandWritten.h \
+    ../../common/SyntheticIssues.h
+
+SOURCES += \
+    tst_requestbody.cpp
@@ -0,0 +1,187 @@
+#include "HandWritten.h"
+#include "SyntheticIssues.h"
+
+#include <QtTest>
+
+using namespace qtredmine;
+
+namespace {
+
+/// Number of time entries of a bulk booking
+const int TIME_ENTRIES = 1000;
+
+/// Number of edited issues
+const int ISSUES = 1000;
+
+/// Typical single-field edits of an issue
+enum Edit
+{
+    EDIT_STATUS,       ///< Move to the next status
+    EDIT_ASSIGNEE,     ///< Reassign to another user
+    EDIT_DONE_RATIO,   ///< Raise the done ratio
+    EDIT_SUBJECT,      ///< Reword the subject
+    EDIT_CUSTOM_FIELD, ///< Change the customer custom field
+};
+
+// Apply an edit to an issue
+void
+applyEdit( Issue& issue, int edit )
+{
+    switch( edit )
+    {
+    case EDIT_STATUS:       issue.status.id = issue.status.id % synthetic::count( synthetic::STATUSES ) + 1; break;
+    case EDIT_ASSIGNEE:     issue.assignedTo.id = issue.assignedTo.id % synthetic::USERS + 1; break;
+    case EDIT_DONE_RATIO:   issue.doneRatio = issue.doneRatio < 100 ? issue.doneRatio + 10 : 0; break;
+    case EDIT_SUBJECT:      issue.subject += " again"; break;
+    case EDIT_CUSTOM_FIELD: issue.customFields.first().value += " Ltd"; break;
+    }
+}
+
+/// Ways of building a request body
+enum Writer
+{
+    DOCUMENT_INDENTED, ///< QJsonDocument, indented as RedmineClient sent it
+    DOCUMENT_COMPACT,  ///< QJsonDocument, compact
+    JSON_WRITER,       ///< requestBody()
+};
+
+// Build the request body of a time entry
+QByteArray
+timeEntryBody( const TimeEntry& timeEntry, int writer )
+{
+    switch( writer )
+    {
+    case DOCUMENT_INDENTED: return handwritten::timeEntryBody( timeEntry, QJsonDocument::Indented );
+    case DOCUMENT_COMPACT:  return handwritten::timeEntryBody( timeEntry, QJsonDocument::Compact );
+    default:                return requestBody( timeEntry );
+    }
+}
+
+} // namespace
+
+/**
+ * @brief Payload and CPU time of request bodies
+ *
+ * Builds the bodies of 1000 time entries with requestBody() and through a QJsonDocument, as
+ * SimpleRedmineClient::sendTimeEntry() did before. For updates, compares the size of patchBody() with
+ * requestBody() for single-field edits of 1000 synthetic issues.
+ */
+class TestRequestBody : public QObject
+{
+    Q_OBJECT
+
+private:
+    TimeEntries timeEntries_;
+    Issues issues_;
+
+private slots:
+    void initTestCase();
+
+    void timeEntryPayload();
+
+    void issuePatch_data();
+    void issuePatch();
+
+    void timeEntry_data();
+    void timeEntry();
+};
+
+void
+TestRequestBody::initTestCase()
+{
+    timeEntries_ = synthetic::timeEntries( TIME_ENTRIES );
+    issues_ = synthetic::issues( ISSUES );
+}
+
+void
+TestRequestBody::timeEntryPayload()
+{
+    qint64 bytes[3] = {};
+
+    for( const auto& timeEntry : timeEntries_ )
+    {
+        for( int writer = DOCUMENT_INDENTED; writer <= JSON_WRITER; ++writer )
+            bytes[writer] += timeEntryBody( timeEntry, writer ).size();
+    }
+
+    // Both writers produce the same document
+    QCOMPARE( QJsonDocument::fromJson(requestBody(timeEntries_.first())),
+              QJsonDocument::fromJson(timeEntryBody(timeEntries_.first(), DOCUMENT_COMPACT)) );
+
+    qInfo( "%d time entries: %lld bytes with QJsonDocument (indented), %lld bytes compact, %lld bytes with requestBody(), "
+           "%.1f%% less than before",
+           TIME_ENTRIES, bytes[DOCUMENT_INDENTED], bytes[DOCUMENT_COMPACT], bytes[JSON_WRITER],
+           100.0 * (bytes[DOCUMENT_INDENTED] - bytes[JSON_WRITER]) / bytes[DOCUMENT_INDENTED] );
+
+    QVERIFY( bytes[JSON_WRITER] < bytes[DOCUMENT_INDENTED] );
+}
+
+void
+TestRequestBody::issuePatch_data()
+{
+    QTest::addColumn<int>( "edit" );
+
+    QTest::newRow( "status" )       << int( EDIT_STATUS );
+    QTest::newRow( "assignee" )     << int( EDIT_ASSIGNEE );
+    QTest::newRow( "done ratio" )   << int( EDIT_DONE_RATIO );
+    QTest::newRow( "subject" )      << int( EDIT_SUBJECT );
+    QTest::newRow( "custom field" ) << int( EDIT_CUSTOM_FIELD );
+}
+
+void
+TestRequestBody::issuePatch()
+{
+    QFETCH( int, edit );
+
+    qint64 fullBytes = 0;
+    qint64 patchBytes = 0;
+
+    for( const auto& original : issues_ )
+    {
+        Issue issue = original;
+        applyEdit( issue, edit );
+
+        int changes = 0;
+        patchBytes += patchBody( issue, original, &changes ).size();
+        fullBytes += requestBody( issue ).size();
+
+        QCOMPARE( changes, 1 );
+    }
+
+    qInfo( "%d issues: %lld bytes with requestBody(), %lld bytes with patchBody(), %.1f%% less",
+           ISSUES, fullBytes, patchBytes, 100.0 * (fullBytes - patchBytes) / fullBytes );
+
+    QVERIFY( patchBytes < fullBytes );
+}
+
+void
+TestRequestBody::timeEntry_data()
+{
+    QTest::addColumn<int>( "writer" );
+
+    QTest::newRow( "QJsonDocument indented" ) << int( DOCUMENT_INDENTED );
+    QTest::newRow( "QJsonDocument compact" )  << int( DOCUMENT_COMPACT );
+    QTest::newRow( "requestBody" )            << int( JSON_WRITER );
+}
+
+void
+TestRequestBody::timeEntry()
+{
+    QFETCH( int, writer );
+
+    qint64 bytes = 0;
+
+    QBENCHMARK
+    {
+        bytes = 0;
+
+        for( const auto& timeEntry : timeEntries_ )
+            bytes += timeEntryBody( timeEntry, writer ).size();
+    }
+
+    QVERIFY( bytes > 0 );
+}
+
+QTEST_GUILESS_MAIN( TestRequestBody )
+
+#include "tst_requestbody.moc"
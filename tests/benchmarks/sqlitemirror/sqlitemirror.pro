@@ -0,0 +1,9 @@
+TARGET = tst_sqlitemirror
+
+include(../../tests.pri)
+
+HEADERS += \
+    ../../common/SyntheticIssues.h
+
+SOURCES += \
+    tst_sqlitemirror.cpp
@@ -0,0 +1,106 @@
+#include "CustomFieldTable.h"
+#include "SqliteMirror.h"
+#include "SyntheticIssues.h"
+
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <QtTest>
+
+using namespace qtredmine;
+
+/**
+ * @brief Bulk-load throughput of the SQLite mirror
+ *
+ * Loads synthetic issues into an empty mirror, once in a single transaction with write() and once in
+ * chunks with enqueue() and flush(), and reports the issues written per second. The FTS5 index is
+ * maintained while loading, so its cost is included.
+ */
+class TestSqliteMirror : public QObject
+{
+    Q_OBJECT
+
+private:
+    CustomFieldTable customFieldTable_;
+    QTemporaryDir dir_;
+
+private slots:
+    void initTestCase();
+
+    void bulkLoad_data();
+    void bulkLoad();
+
+    void search();
+};
+
+void
+TestSqliteMirror::initTestCase()
+{
+    QVERIFY( dir_.isValid() );
+}
+
+void
+TestSqliteMirror::bulkLoad_data()
+{
+    QTest::addColumn<int>( "count" );
+    QTest::addColumn<bool>( "chunked" );
+
+    QTest::newRow( "10k write" )    << 10000 << false;
+    QTest::newRow( "10k enqueue" )  << 10000 << true;
+    QTest::newRow( "100k write" )   << 100000 << false;
+    QTest::newRow( "100k enqueue" ) << 100000 << true;
+}
+
+void
+TestSqliteMirror::bulkLoad()
+{
+    QFETCH( int, count );
+    QFETCH( bool, chunked );
+
+    Issues issues = synthetic::issues( count, &customFieldTable_ );
+
+    SqliteMirror mirror( dir_.path() + QString("/%1.sqlite").arg(QTest::currentDataTag()) );
+    QVERIFY( mirror.isOpen() );
+
+    QElapsedTimer timer;
+    timer.start();
+
+    if( chunked )
+    {
+        mirror.enqueue( issues );
+        QVERIFY( mirror.flush() );
+    }
+    else
+    {
+        QVERIFY( mirror.write(issues) );
+    }
+
+    qint64 elapsed = qMax<qint64>( timer.elapsed(), 1 );
+
+    qInfo( "%s: %d issues in %lld ms, %.0f issues/s (FTS5 %s)", QTest::currentDataTag(), count, elapsed,
+           count * 1000.0 / elapsed, mirror.hasFullTextSearch() ? "on" : "off" );
+
+    QCOMPARE( mirror.issues().size(), count );
+}
+
+void
+TestSqliteMirror::search()
+{
+    SqliteMirror mirror( dir_.path() + "/search.sqlite" );
+    QVERIFY( mirror.write(synthetic::issues(100000, &customFieldTable_)) );
+
+    // Without the FTS5 index, the text is searched as a plain substring
+    const QString text = mirror.hasFullTextSearch() ? "crash AND login*" : "crash";
+
+    Issues issues;
+
+    QBENCHMARK
+    {
+        issues = mirror.search( text );
+    }
+
+    QVERIFY( !issues.isEmpty() );
+}
+
+QTEST_GUILESS_MAIN( TestSqliteMirror )
+
+#include "tst_sqlitemirror.moc"
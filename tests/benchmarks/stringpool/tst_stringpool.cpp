@@ -0,0 +1,111 @@
+#include "CustomFieldTable.h"
+#include "ProcessMemory.h"
+#include "StringPool.h"
+#include "SyntheticIssues.h"
+
+#include <QtTest>
+
+using namespace qtredmine;
+
+namespace {
+
+/// Number of issues of the data set
+const int ISSUES = 50000;
+
+/// Items of an issue
+Item Issue::* const ITEMS[] = {
+    &Issue::assignedTo,
+    &Issue::author,
+    &Issue::category,
+    &Issue::priority,
+    &Issue::project,
+    &Issue::status,
+    &Issue::tracker,
+    &Issue::version,
+    &Issue::user,
+};
+
+} // namespace
+
+/**
+ * @brief Memory saved by interning item names
+ *
+ * Decodes a synthetic data set of 50k issues, whose item names are interned by the parser, then gives
+ * every item name its own copy as the parser did before interning. The growth of the resident memory
+ * is the memory saved by the pool.
+ */
+class TestStringPool : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void residentMemory();
+    void parse();
+    void trim();
+};
+
+void
+TestStringPool::residentMemory()
+{
+    if( process::residentBytes() < 0 )
+        QSKIP( "Resident memory is only measured on Linux" );
+
+    CustomFieldTable table;
+
+    qint64 start = process::residentBytes();
+    Issues issues = synthetic::issues( ISSUES, &table );
+    qint64 interned = process::residentBytes();
+
+    QCOMPARE( issues.size(), ISSUES );
+
+    // Separate copies of the names, as before interning
+    for( auto& issue : issues )
+    {
+        for( auto item : ITEMS )
+        {
+            QString& name = ( issue.*item ).name;
+
+            if( !name.isEmpty() )
+                name = QString( name.constData(), name.size() );
+        }
+    }
+
+    qint64 copied = process::residentBytes();
+
+    qInfo( "%d issues: %.1f MiB resident with interned item names (%d pooled names), "
+           "%.1f MiB more with separate copies",
+           ISSUES, (interned - start) / 1048576.0, StringPool::itemNames().size(),
+           (copied - interned) / 1048576.0 );
+}
+
+void
+TestStringPool::parse()
+{
+    CustomFieldTable table;
+    const QJsonDocument json = QJsonDocument::fromJson( synthetic::issuesPage(0, 100, 100) );
+
+    QBENCHMARK
+    {
+        synthetic::decodeIssues( json, 0, &table );
+    }
+}
+
+void
+TestStringPool::trim()
+{
+    StringPool pool;
+
+    QString kept = pool.intern( QString("Kept %1").arg(1) );
+    pool.intern( QString("Released %1").arg(2) );
+
+    QCOMPARE( pool.size(), 2 );
+    QCOMPARE( pool.trim(), 1 );
+    QCOMPARE( pool.size(), 1 );
+
+    // The remaining string is still shared
+    QVERIFY( pool.intern(QString("Kept %1").arg(1)).constData() == kept.constData() );
+}
+
+QTEST_GUILESS_MAIN( TestStringPool )
+
+#include "tst_stringpool.moc"
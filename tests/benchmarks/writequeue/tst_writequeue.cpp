@@ -0,0 +1,206 @@
+#include "SimpleRedmineClient.h"
+#include "WriteQueue.h"
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QSignalSpy>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTemporaryDir>
+#include <QtTest>
+
+using namespace qtredmine;
+
+namespace {
+
+/// Number of queued writes
+const int WRITES = 200;
+
+/**
+ * @brief Minimal Redmine stand-in on a local port
+ *
+ * Answers issue creations with 201 and the new issue ID, updates with 204 and any other request
+ * with an empty issue list, on persistent connections.
+ */
+class RedmineStub : public QTcpServer
+{
+private:
+    /// Unprocessed request bytes by connection
+    QHash<QTcpSocket*, QByteArray> buffers_;
+
+    /// ID of the next created issue
+    int nextId_ = 1;
+
+    // Reply to a request
+    QByteArray reply( const QByteArray& method )
+    {
+        if( method == "PUT" )
+            return "HTTP/1.1 204 No Content\r\nContent-Length: 0\r\n\r\n";
+
+        QByteArray status = "200 OK";
+        QByteArray body = "{\"issues\":[],\"total_count\":0}";
+
+        if( method == "POST" )
+        {
+            status = "201 Created";
+            body = "{\"issue\":{\"id\":" + QByteArray::number( nextId_++ ) + "}}";
+        }
+
+        return "HTTP/1.1 " + status + "\r\nContent-Type: application/json\r\nContent-Length: "
+               + QByteArray::number( body.size() ) + "\r\n\r\n" + body;
+    }
+
+    // Answer all complete requests of a connection
+    void read( QTcpSocket* socket )
+    {
+        QByteArray& buffer = buffers_[socket];
+        buffer += socket->readAll();
+
+        for( ;; )
+        {
+            int end = buffer.indexOf( "\r\n\r\n" );
+            if( end < 0 )
+                break;
+
+            QByteArray head = buffer.left( end );
+            int length = 0;
+
+            for( const auto& line : head.split('\n') )
+            {
+                if( line.toLower().startsWith("content-length:") )
+                    length = line.mid( 15 ).trimmed().toInt();
+            }
+
+            if( buffer.size() < end + 4 + length )
+                break;
+
+            buffer.remove( 0, end + 4 + length );
+            socket->write( reply(head.left(head.indexOf(' '))) );
+        }
+    }
+
+public:
+    RedmineStub()
+    {
+        connect( this, &QTcpServer::newConnection, [this]()
+        {
+            while( QTcpSocket* socket = nextPendingConnection() )
+            {
+                connect( socket, &QTcpSocket::readyRead, [this, socket](){ read( socket ); } );
+                connect( socket, &QTcpSocket::disconnected, [this, socket]()
+                {
+                    buffers_.remove( socket );
+                    socket->deleteLater();
+                } );
+            }
+        } );
+    }
+};
+
+} // namespace
+
+/**
+ * @brief Drain time of the write queue per number of concurrent writes
+ *
+ * Queues 200 writes, alternating issue creations and updates of distinct issues, while the local
+ * Redmine stand-in does not accept connections yet, so that the refused writes pause the replay. Then
+ * starts the stand-in and measures the time until the queue is drained. QNetworkAccessManager opens
+ * at most six connections per host, which limits the effect of higher concurrency.
+ */
+class TestWriteQueue : public QObject
+{
+    Q_OBJECT
+
+private:
+    QTemporaryDir dir_;
+
+    /// Port of the Redmine stand-in
+    quint16 port_ = 0;
+
+private slots:
+    void initTestCase();
+
+    void drain_data();
+    void drain();
+};
+
+void
+TestWriteQueue::initTestCase()
+{
+    QVERIFY( dir_.isValid() );
+
+    // Find a free port; nothing listens on it until the writes are queued
+    QTcpServer server;
+    QVERIFY( server.listen(QHostAddress::LocalHost) );
+    port_ = server.serverPort();
+}
+
+void
+TestWriteQueue::drain_data()
+{
+    QTest::addColumn<int>( "maxConcurrency" );
+
+    QTest::newRow( "1" ) << 1;
+    QTest::newRow( "2" ) << 2;
+    QTest::newRow( "4" ) << 4;
+    QTest::newRow( "8" ) << 8;
+}
+
+void
+TestWriteQueue::drain()
+{
+    QFETCH( int, maxConcurrency );
+
+    SimpleRedmineClient redmine( QString("http://127.0.0.1:%1").arg(port_), "0123456789abcdef" );
+
+    WriteQueue queue( &redmine, dir_.path() + QString("/writes-%1.log").arg(maxConcurrency) );
+    queue.setMaxConcurrency( maxConcurrency );
+    queue.setRetryInterval( 100 );
+
+    for( int i = 0; i < WRITES; ++i )
+    {
+        Issue issue;
+        issue.project.id = 1;
+        issue.tracker.id = 1;
+        issue.subject    = QString( "Issue %1" ).arg( i );
+
+        if( i % 2 )
+        {
+            issue.id = i;
+
+            Issue original = issue;
+            issue.status.id = 2;
+
+            queue.updateIssue( issue, original );
+        }
+        else
+            queue.sendIssue( issue );
+    }
+
+    // Let the refused connections pause the replay
+    QTest::qWait( 500 );
+    QCOMPARE( queue.size(), WRITES );
+
+    RedmineStub stub;
+    QVERIFY( stub.listen(QHostAddress::LocalHost, port_) );
+
+    QSignalSpy drained( &queue, &WriteQueue::drained );
+    QElapsedTimer timer;
+    timer.start();
+
+    queue.replay();
+
+    QVERIFY( drained.wait(60 * 1000) );
+
+    qint64 elapsed = timer.elapsed();
+    QTest::setBenchmarkResult( elapsed, QTest::WalltimeMilliseconds );
+
+    qInfo( "%d writes with at most %d in flight: %lld ms, %.0f writes/s", WRITES, maxConcurrency, elapsed,
+           elapsed ? 1000.0 * WRITES / elapsed : 0.0 );
+
+    QCOMPARE( queue.size(), 0 );
+}
+
+QTEST_GUILESS_MAIN( TestWriteQueue )
+
+#include "tst_writequeue.moc"
@@ -0,0 +1,6 @@
+TARGET = tst_writequeue
+
+include(../../tests.pri)
+
+SOURCES += \
+    tst_writequeue.cpp
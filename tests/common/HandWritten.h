@@ -0,0 +1,233 @@
+#ifndef HANDWRITTEN_H
+#define HANDWRITTEN_H
+
+#include "CustomFieldTable.h"
+#include "SimpleRedmineTypes.h"
+
+#include <QByteArray>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+/**
+ * @brief Hand-written serialisation code replaced by the field descriptors
+ *
+ * The code of SimpleRedmineClient before the parsers and writers were generated from
+ * qtredmine::Fields, adapted to the current types only where they changed. The benchmarks compare
+ * the library against it.
+ */
+namespace handwritten {
+
+/**
+ * @brief Build the body of a time entry request through a JSON document
+ *
+ * @param item   Time entry
+ * @param format Document format; RedmineClient sent indented documents
+ *
+ * @return Request body
+ */
+inline QByteArray
+timeEntryBody( const qtredmine::TimeEntry& item, QJsonDocument::JsonFormat format = QJsonDocument::Indented )
+{
+    QJsonObject attr;
+
+    attr["hours"] = item.hours;
+
+    if( item.activity.id != qtredmine::NULL_ID )
+        attr["activity_id"] = item.activity.id;
+
+    if( !item.comment.isEmpty() )
+        attr["comments"] = item.comment;
+
+    if( item.issue.id != qtredmine::NULL_ID )
+        attr["issue_id"] = item.issue.id;
+
+    if( item.project.id != qtredmine::NULL_ID )
+        attr["project_id"] = item.project.id;
+
+    if( item.spentOn.isValid() )
+        attr["spent_on"] = item.spentOn.toString( Qt::ISODate );
+
+    if( item.customFields.size() )
+    {
+        QJsonArray customFields;
+
+        for( const auto& customField : item.customFields )
+        {
+            QJsonObject cf;
+            cf["id"] = customField.id;
+            cf["value"] = customField.value;
+            customFields.append( cf );
+        }
+
+        attr["custom_fields"] = customFields;
+    }
+
+    QJsonObject data;
+    data["time_entry"] = attr;
+
+    QJsonDocument json;
+    json.setObject( data );
+
+    return json.toJson( format );
+}
+
+/// Fill an item from a JSON object
+inline void
+fillItem( qtredmine::Item& item, const QJsonObject& obj, const QString& key )
+{
+    QJsonObject itemObj = obj.value( key ).toObject();
+
+    if( !itemObj.isEmpty() )
+    {
+        item.id   = itemObj.value("id").toInt();
+        item.name = itemObj.value("name").toString();
+    }
+}
+
+/**
+ * @brief Parse an issue field by field
+ *
+ * @param issue Issue
+ * @param obj   JSON object of the issue
+ * @param table Custom field table receiving the custom field definitions
+ */
+inline void
+parseIssue( qtredmine::Issue& issue, const QJsonObject& obj, qtredmine::CustomFieldTable* table )
+{
+    // Simple fields
+    issue.id          = obj.value("id").toInt();
+    issue.description = obj.value("description").toString();
+    issue.doneRatio   = obj.value("done_ratio").toInt();
+    issue.subject     = obj.value("subject").toString();
+
+    QJsonObject parent = obj.value("parent").toObject();
+    if( !parent.isEmpty() )
+        issue.parentId = parent.value("id").toInt();
+
+    fillItem( issue.assignedTo, obj, "assigned_to" );
+    fillItem( issue.author,     obj, "author" );
+    fillItem( issue.category,   obj, "category" );
+    fillItem( issue.priority,   obj, "priority" );
+    fillItem( issue.project,    obj, "project" );
+    fillItem( issue.status,     obj, "status" );
+    fillItem( issue.tracker,    obj, "tracker" );
+    fillItem( issue.version,    obj, "fixed_version" );
+
+    // Dates and times
+    issue.dueDate        = obj.value("due_date").toVariant().toDate();
+    issue.estimatedHours = obj.value("estimated_hours").toDouble();
+    issue.startDate      = obj.value("start_date").toVariant().toDate();
+
+    // Custom fields, stored as values with their definition in the table
+    for( const auto& cf : obj.value("custom_fields").toArray() )
+    {
+        QJsonObject cfObj = cf.toObject();
+
+        qtredmine::CustomFieldValue customField;
+        customField.id    = cfObj.value("id").toInt();
+        customField.table = table;
+
+        if( cfObj.value("value").isString() )
+            customField.value = cfObj.value("value").toString();
+        else if( cfObj.value("value").isArray() )
+        {
+            for( const auto& v : cfObj.value("value").toArray() )
+            {
+                if( customField.value.isNull() )
+                    customField.value = v.toString();
+                else
+                    customField.moreValues.push_back( v.toString() );
+            }
+        }
+
+        table->insertIfMissing( customField.id, cfObj.value("name").toString(), "issue", cfObj.value("multiple").toBool() );
+
+        issue.customFields.push_back( customField );
+    }
+
+    issue.createdOn = obj.value("created_on").toVariant().toDateTime();
+    issue.updatedOn = obj.value("updated_on").toVariant().toDateTime();
+
+    fillItem( issue.user, obj, "user" );
+}
+
+/**
+ * @brief Build the body of an issue request through a JSON document
+ *
+ * @param item   Issue
+ * @param format Document format; RedmineClient sent indented documents
+ *
+ * @return Request body
+ */
+inline QByteArray
+issueBody( const qtredmine::Issue& item, QJsonDocument::JsonFormat format = QJsonDocument::Indented )
+{
+    QJsonObject attr;
+
+    if( item.project.id != qtredmine::NULL_ID )
+        attr["project_id"] = item.project.id;
+
+    if( item.tracker.id != qtredmine::NULL_ID )
+        attr["tracker_id"] = item.tracker.id;
+
+    if( item.status.id != qtredmine::NULL_ID )
+        attr["status_id"] = item.status.id;
+
+    if( item.priority.id != qtredmine::NULL_ID )
+        attr["priority_id"] = item.priority.id;
+
+    if( !item.subject.isEmpty() )
+        attr["subject"] = item.subject;
+
+    if( !item.description.isEmpty() )
+        attr["description"] = item.description;
+
+    if( item.category.id != qtredmine::NULL_ID )
+        attr["category_id"] = item.category.id;
+
+    if( item.version.id != qtredmine::NULL_ID )
+        attr["fixed_version_id"] = item.version.id;
+
+    if( item.assignedTo.id != qtredmine::NULL_ID )
+        attr["assigned_to_id"] = item.assignedTo.id;
+
+    if( item.parentId != qtredmine::NULL_ID )
+        attr["parent_issue_id"] = item.parentId;
+
+    if( item.startDate.isValid() )
+        attr["start_date"] = item.startDate.toString( "yyyy-MM-dd" );
+
+    if( item.dueDate.isValid() )
+        attr["due_date"] = item.dueDate.toString( "yyyy-MM-dd" );
+
+    if( item.customFields.size() )
+    {
+        QJsonArray customFields;
+
+        for( const auto& customField : item.customFields )
+        {
+            QJsonObject cf;
+            cf["id"] = customField.id;
+            cf["value"] = customField.value;
+            customFields.append( cf );
+        }
+
+        attr["custom_fields"] = customFields;
+    }
+
+    if( item.estimatedHours )
+        attr["estimated_hours"] = item.estimatedHours;
+
+    QJsonObject data;
+    data["issue"] = attr;
+
+    QJsonDocument json;
+    json.setObject( data );
+
+    return json.toJson( format );
+}
+
+} // handwritten
+
+#endif // HANDWRITTEN_H
@@ -0,0 +1,44 @@
+#ifndef PROCESSMEMORY_H
+#define PROCESSMEMORY_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Memory usage of the test process
+ */
+namespace process {
+
+/**
+ * @brief Get the resident memory of the process
+ *
+ * @return Resident memory in bytes, or -1 if unknown; only known on Linux
+ */
+inline qint64
+residentBytes()
+{
+#ifdef Q_OS_LINUX
+    QFile file( "/proc/self/statm" );
+
+    if( !file.open(QIODevice::ReadOnly) )
+        return -1;
+
+    QList<QByteArray> fields = file.readAll().split( ' ' );
+
+    if( fields.size() < 2 )
+        return -1;
+
+    return fields.at( 1 ).toLongLong() * sysconf( _SC_PAGESIZE );
+#else
+    return -1;
+#endif
+}
+
+} // process
+
+#endif // PROCESSMEMORY_H
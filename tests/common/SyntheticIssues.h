@@ -0,0 +1,286 @@
+#ifndef SYNTHETICISSUES_H
+#define SYNTHETICISSUES_H
+
+#include "CustomFieldTable.h"
+#include "SimpleRedmineTypes.h"
+
+#include <QByteArray>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+
+/**
+ * @brief Synthetic Redmine data for tests and benchmarks
+ *
+ * The generated issues resemble a mid-sized Redmine instance: a few hundred users, some dozen
+ * projects, versions and categories, and a handful of statuses, trackers and priorities. Subjects and
+ * descriptions are built from a small vocabulary. The data only depends on the issue IDs, so every
+ * run sees the same issues.
+ */
+namespace synthetic {
+
+/// Number of distinct users
+const int USERS = 300;
+
+/// Number of distinct projects
+const int PROJECTS = 50;
+
+/// Number of distinct versions
+const int VERSIONS = 40;
+
+/// Number of distinct categories
+const int CATEGORIES = 20;
+
+/// Status, tracker and priority names
+const char* const STATUSES[]   = { "New", "In Progress", "Resolved", "Feedback", "Closed", "Rejected" };
+const char* const TRACKERS[]   = { "Bug", "Feature", "Support", "Task" };
+const char* const PRIORITIES[] = { "Low", "Normal", "High", "Urgent", "Immediate" };
+
+/// Vocabulary of subjects and descriptions
+const char* const WORDS[] = {
+    "login", "fails", "after", "password", "reset", "report", "export", "shows", "wrong", "totals",
+    "timeline", "crash", "when", "opening", "attachment", "slow", "search", "results", "missing",
+    "translation", "update", "dependency", "invoice", "layout", "broken", "mobile", "view", "email",
+    "notification", "duplicate", "import", "calendar", "permission", "denied", "dashboard", "widget",
+};
+
+/// Deterministic pseudo-random numbers, seeded per issue
+class Random
+{
+private:
+    quint32 state_;
+
+public:
+    explicit Random( quint32 seed ) : state_( seed * 2654435761u + 1 ) {}
+
+    /// @return Number in [0, n)
+    int next( int n )
+    {
+        state_ = state_ * 1664525u + 1013904223u;
+        return static_cast<int>( (state_ >> 8) % static_cast<quint32>(n) );
+    }
+};
+
+template<typename T, int N>
+int count( T (&)[N] ) { return N; }
+
+/// Item as returned by Redmine
+inline QJsonObject
+item( int id, const QString& name )
+{
+    QJsonObject obj;
+    obj.insert( "id", id );
+    obj.insert( "name", name );
+    return obj;
+}
+
+/// Text of some words from the vocabulary
+inline QString
+text( Random& random, int words )
+{
+    QStringList list;
+
+    for( int i = 0; i < words; ++i )
+        list << WORDS[random.next( count(WORDS) )];
+
+    return list.join( ' ' );
+}
+
+/**
+ * @brief Generate an issue as returned by Redmine
+ *
+ * The issue has a customer and a tags custom field; further custom fields with short values are
+ * added up to the given number.
+ *
+ * @param id           Issue ID
+ * @param customFields Number of custom fields, at least 2
+ *
+ * @return JSON object of the issue
+ */
+inline QJsonObject
+issueJson( int id, int customFields = 2 )
+{
+    Random random( id );
+
+    int status   = random.next( count(STATUSES) );
+    int tracker  = random.next( count(TRACKERS) );
+    int priority = random.next( count(PRIORITIES) );
+    int project  = random.next( PROJECTS ) + 1;
+    int author   = random.next( USERS ) + 1;
+    int assignee = random.next( USERS ) + 1;
+
+    QJsonObject obj;
+    obj.insert( "id", id );
+    obj.insert( "project", item(project, QString("Project %1").arg(project)) );
+    obj.insert( "tracker", item(tracker + 1, TRACKERS[tracker]) );
+    obj.insert( "status", item(status + 1, STATUSES[status]) );
+    obj.insert( "priority", item(priority + 1, PRIORITIES[priority]) );
+    obj.insert( "author", item(author, QString("User %1").arg(author)) );
+    obj.insert( "assigned_to", item(assignee, QString("User %1").arg(assignee)) );
+
+    if( random.next(2) )
+    {
+        int category = random.next( CATEGORIES ) + 1;
+        obj.insert( "category", item(category, QString("Category %1").arg(category)) );
+    }
+
+    if( random.next(3) )
+    {
+        int version = random.next( VERSIONS ) + 1;
+        obj.insert( "fixed_version", item(version, QString("Version %1").arg(version)) );
+    }
+
+    if( id > 10 && !random.next(5) )
+    {
+        QJsonObject parent;
+        parent.insert( "id", id - 1 - random.next(10) );
+        obj.insert( "parent", parent );
+    }
+
+    obj.insert( "subject", text(random, 4 + random.next(6)) );
+    obj.insert( "description", text(random, 20 + random.next(60)) );
+    obj.insert( "start_date", QString("2024-%1-%2").arg(1 + random.next(12), 2, 10, QChar('0')).arg(1 + random.next(28), 2, 10, QChar('0')) );
+    obj.insert( "done_ratio", 10 * random.next(11) );
+    obj.insert( "estimated_hours", 0.5 * random.next(40) );
+
+    QJsonArray customFieldArray;
+
+    QJsonObject customer;
+    customer.insert( "id", 1 );
+    customer.insert( "name", "Customer" );
+    customer.insert( "value", QString("Customer %1").arg(random.next(30)) );
+    customFieldArray.append( customer );
+
+    QJsonObject tags;
+    tags.insert( "id", 2 );
+    tags.insert( "name", "Tags" );
+    tags.insert( "multiple", true );
+    tags.insert( "value", QJsonArray() << WORDS[random.next(count(WORDS))] << WORDS[random.next(count(WORDS))] );
+    customFieldArray.append( tags );
+
+    // The values of further fields do not use the random numbers, so that the other fields stay the same
+    for( int i = 3; i <= customFields; ++i )
+    {
+        QJsonObject field;
+        field.insert( "id", 10 + i );
+        field.insert( "name", QString("Field %1").arg(i) );
+        field.insert( "value", QString("Value %1").arg((id + i) % 50) );
+        customFieldArray.append( field );
+    }
+
+    obj.insert( "custom_fields", customFieldArray );
+    obj.insert( "created_on", QString("2024-01-%1T10:00:00Z").arg(1 + random.next(28), 2, 10, QChar('0')) );
+    obj.insert( "updated_on", QString("2024-06-%1T%2:00:00Z").arg(1 + random.next(28), 2, 10, QChar('0'))
+                                                               .arg(random.next(24), 2, 10, QChar('0')) );
+
+    return obj;
+}
+
+/**
+ * @brief Generate a page of issues as returned by Redmine
+ *
+ * @param offset       Offset of the page; the issue IDs start at <tt>offset + 1</tt>
+ * @param limit        Number of issues on the page
+ * @param total        Total number of issues
+ * @param customFields Number of custom fields per issue, see issueJson()
+ *
+ * @return Reply body
+ */
+inline QByteArray
+issuesPage( int offset, int limit, int total, int customFields = 2 )
+{
+    QJsonArray array;
+
+    for( int id = offset + 1; id <= offset + limit && id <= total; ++id )
+        array.append( issueJson(id, customFields) );
+
+    QJsonObject obj;
+    obj.insert( "issues", array );
+    obj.insert( "total_count", total );
+    obj.insert( "offset", offset );
+    obj.insert( "limit", limit );
+
+    return QJsonDocument( obj ).toJson( QJsonDocument::Compact );
+}
+
+/**
+ * @brief Decode a page of issues like SimpleRedmineClient::retrieveIssues()
+ *
+ * @param json  JSON document of the reply
+ * @param skip  Field mask of the fields to skip, see qtredmine::skippedFields()
+ * @param table Custom field table
+ *
+ * @return Issues
+ */
+inline qtredmine::Issues
+decodeIssues( const QJsonDocument& json, quint64 skip = 0, qtredmine::CustomFieldTable* table = nullptr )
+{
+    qtredmine::Issues issues;
+    qtredmine::readItems( issues, json.object().value(QLatin1String("issues")).toArray(), skip, table );
+
+    return issues;
+}
+
+/**
+ * @brief Generate and decode issues
+ *
+ * @param total        Number of issues, with IDs from 1 to \c total
+ * @param table        Custom field table
+ * @param customFields Number of custom fields per issue, see issueJson()
+ *
+ * @return Issues
+ */
+inline qtredmine::Issues
+issues( int total, qtredmine::CustomFieldTable* table = nullptr, int customFields = 2 )
+{
+    const int limit = 100;
+
+    qtredmine::Issues issues;
+    issues.reserve( total );
+
+    for( int offset = 0; offset < total; offset += limit )
+        issues += decodeIssues( QJsonDocument::fromJson(issuesPage(offset, limit, total, customFields)), 0, table );
+
+    return issues;
+}
+
+/**
+ * @brief Generate time entries as an application would book them
+ *
+ * @param count Number of time entries
+ *
+ * @return Time entries without ID, each on an issue with an activity, a comment and a custom field
+ */
+inline qtredmine::TimeEntries
+timeEntries( int count )
+{
+    qtredmine::TimeEntries timeEntries;
+    timeEntries.reserve( count );
+
+    for( int i = 0; i < count; ++i )
+    {
+        Random random( i );
+
+        qtredmine::TimeEntry timeEntry;
+        timeEntry.activity.id = 8 + random.next( 4 );
+        timeEntry.comment     = text( random, 2 + random.next(6) );
+        timeEntry.hours       = 0.25 * ( 1 + random.next(32) );
+        timeEntry.issue.id    = 1 + random.next( 100000 );
+        timeEntry.spentOn     = QDate( 2024, 1, 1 ).addDays( random.next(365) );
+
+        qtredmine::CustomFieldValue billable;
+        billable.id    = 3;
+        billable.value = random.next( 2 ) ? "1" : "0";
+        timeEntry.customFields.push_back( billable );
+
+        timeEntries.push_back( timeEntry );
+    }
+
+    return timeEntries;
+}
+
+} // synthetic
+
+#endif // SYNTHETICISSUES_H
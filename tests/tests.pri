@@ -0,0 +1,12 @@
+QT += testlib network
+QT -= gui
+
+CONFIG += testcase console
+CONFIG -= app_bundle
+QMAKE_CXXFLAGS += -std=c++11
+
+include($$PWD/../qtredmine.pri)
+
+INCLUDEPATH += $$PWD/../include/qtredmine $$PWD/common
+
+DEFINES += SRCDIR=\\\"$$_PRO_FILE_PWD_/\\\"
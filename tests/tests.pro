@@ -0,0 +1,6 @@
+TEMPLATE = subdirs
+
+# The tests link against the library like any project including qtredmine.pri; build it first
+SUBDIRS += \
+    allocations \
+    benchmarks